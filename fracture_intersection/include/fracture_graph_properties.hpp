@@ -31,19 +31,24 @@
 #ifndef HH_FRACTURE_GRAPH_PROPERTIES_HH
 #define HH_FRACTURE_GRAPH_PROPERTIES_HH
 
-#include "base_properties.hpp"
+#include "compact_properties.hpp"
 #include "linear_geometry.hpp"
+#include "vertex_hash.hpp"
+#include "edge_grid.hpp"
+#include "cluster_tracker.hpp"
 
 namespace Fracture{
 /*
 	First of all, we define the data structures to be attached to vertices and edges
 	on the graph.
-	The Vertex_base_property fits the input data, so it is not needed to define a new one.
+	The Vertex_compact_property fits the input data, so it is not needed to define a new one.
 	This is not the case for the edge properties, where we have to insert four new numerical
-	parameters: K_t, K_n, df, source_term
+	parameters: K_t, K_n, df, source_term.
+	The compact versions of the base properties are used (see compact_properties.hpp),
+	since the graphs may have millions of edges, usually neither meshed nor labelled
 */
 //! The edge data structure
-struct Edge_prop : public BGLgeom::Edge_base_property<BGLgeom::linear_geometry<2>,2>{
+struct Edge_prop : public BGLgeom::Edge_compact_property<BGLgeom::linear_geometry<2>,2>{
 	//! Parameter K_t (Permeabilità tangenziale)
 	double K_t;
 	//! Parameter K_n (Permeabilità normale)
@@ -55,7 +60,7 @@ struct Edge_prop : public BGLgeom::Edge_base_property<BGLgeom::linear_geometry<2
 
 	
 	//! Default constructor
-	Edge_prop() :	BGLgeom::Edge_base_property<BGLgeom::linear_geometry<2>,2>(),
+	Edge_prop() :	BGLgeom::Edge_compact_property<BGLgeom::linear_geometry<2>,2>(),
 					K_t(0),
 					K_n(0),
 					df(0),
@@ -67,7 +72,7 @@ struct Edge_prop : public BGLgeom::Edge_base_property<BGLgeom::linear_geometry<2
 				 double const& _K_n,
 				 double const& _df,				 
 				 double const& _source_term) :
-							BGLgeom::Edge_base_property<BGLgeom::linear_geometry<2>,2>(),
+							BGLgeom::Edge_compact_property<BGLgeom::linear_geometry<2>,2>(),
 							K_t(_K_t),
 							K_n(_K_n),
 							df(_df),
@@ -76,7 +81,23 @@ struct Edge_prop : public BGLgeom::Edge_base_property<BGLgeom::linear_geometry<2
 };	//Edge_prop
 
 //! The vertex data structure
-using Vertex_prop = BGLgeom::Vertex_base_property<2>;
+using Vertex_prop = BGLgeom::Vertex_compact_property<2>;
+
+/*!
+	@brief The graph data structure
+	
+	It contains the spatial indices used while building the graph, and its
+	connected components, so that they are attached to the graph they
+	refer to
+*/
+struct Graph_prop{
+	//! Spatial hash of the vertices, used to find vertices with the same coordinates
+	BGLgeom::vertex_hash<2> vertex_index;
+	//! Spatial index of the edges, used to find the edges which may intersect a new fracture
+	BGLgeom::edge_grid<2> edge_index;
+	//! Connected components (clusters of fractures), with their length and bounding box
+	BGLgeom::cluster_tracker<2> clusters;
+};	//Graph_prop
 
 }	//Fracture
 
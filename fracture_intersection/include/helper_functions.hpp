@@ -35,6 +35,7 @@
 
 //#include "reader_ASCII.hpp"
 #include "intersections2D_utilities.hpp"
+#include "spatial_reorder.hpp"
 #include "types_definition.hpp"
 #include "fracture_graph_properties.hpp"
 
@@ -121,6 +122,18 @@ namespace Fracture{
 	
 	/*!
 		@brief	Creates the graph while reading the input file
+		
+		The vertices of the fractures are looked for among the ones already in 
+		the graph through the spatial hash stored in the graph property, which
+		is kept updated with the new vertices (and rebuilt at the beginning if 
+		it does not contain all the vertices of G). In the same way, each new 
+		fracture is intersected only with the edges near to it, found through
+		the spatial index of the edges stored in the graph property, so the cost
+		of each fracture does not grow with the size of the graph. The connected
+		components in the graph property (BGLgeom::cluster_tracker) are updated
+		with each new vertex and edge, so the clusters of fractures, their
+		length and bounding box, and the percolation of the network can be
+		asked at any time while the graph is built
 
 		@param G The graph to be built
 		@param R Concrete reader class to read the input file
@@ -134,12 +147,108 @@ namespace Fracture{
 					  std::function<void(Fracture::Edge_prop &, const Fracture::Edge_prop &)> update_edge_properties 
 							= [](Fracture::Edge_prop & current_prop, const Fracture::Edge_prop & new_prop){} );
 	
+	/*!
+		@brief	Creates the graph reading all the input file first
+		
+		It gives the same graph of create_graph (vertices, edges and their 
+		properties, update_edge_properties applied on the overlapping 
+		portions in the order of the fractures), but all the intersections 
+		are computed at once with a sweep line, and then each edge is added 
+		to the graph only once, instead of being cut by each new fracture 
+		(see BGLgeom::build_arrangement). The spatial index of the edges in the 
+		graph property is not built: create_graph builds it if needed. The 
+		connected components are built at the end
+		
+		@pre	The graph must not contain edges
+		@param G The graph to be built
+		@param R Concrete reader class to read the input file
+		@param update_edge_properties   (optional) As in create_graph
+	*/
+	void create_graph_arrangement(Graph & G, 
+								  Reader & R, 
+								  std::function<void(Fracture::Edge_prop &, const Fracture::Edge_prop &)> update_edge_properties 
+										= [](Fracture::Edge_prop & current_prop, const Fracture::Edge_prop & new_prop){} );
+	
+	/*!
+		@brief	Creates the graph reading all the input file first, computing 
+				the intersections with more threads
+		
+		It works in two phases: first all the intersections between the 
+		fractures are computed by n_threads threads, each one testing a 
+		block of fractures against the near ones (see 
+		BGLgeom::compute_all_intersections_parallel); then the graph is built 
+		sequentially, as in create_graph_arrangement. The graph is the same 
+		of create_graph_arrangement, for any number of threads
+		
+		@pre	The graph must not contain edges
+		@param G The graph to be built
+		@param R Concrete reader class to read the input file
+		@param n_threads Number of threads. If zero, the number of concurrent 
+						 threads supported by the machine
+		@param update_edge_properties   (optional) As in create_graph
+	*/
+	void create_graph_parallel(Graph & G, 
+							   Reader & R, 
+							   unsigned int n_threads,
+							   std::function<void(Fracture::Edge_prop &, const Fracture::Edge_prop &)> update_edge_properties 
+									= [](Fracture::Edge_prop & current_prop, const Fracture::Edge_prop & new_prop){} );
+	
+	/*!
+		@brief	Creates the graph splitting the domain in tiles
+
+		The bounding box of the fractures is split in nx x ny tiles, and
+		the fractures are cut along the lines between the tiles. The graph
+		of each tile is built independently (as in create_graph_arrangement),
+		by n_threads threads. Then the tiles are stitched: the vertices on
+		the cut lines are welded, and the pieces of the same edge split by
+		a cut line are joined again, so that the graph has the same vertices
+		and edges of create_graph_arrangement (up to TOL and to their
+		numbering)
+
+		@pre	The graph must not contain edges
+		@param G The graph to be built
+		@param R Concrete reader class to read the input file
+		@param nx Number of tiles along x
+		@param ny Number of tiles along y
+		@param n_threads Number of threads. If zero, the number of concurrent
+						 threads supported by the machine
+		@param update_edge_properties   (optional) As in create_graph
+	*/
+	void create_graph_tiled(Graph & G,
+							Reader & R,
+							unsigned int nx,
+							unsigned int ny,
+							unsigned int n_threads,
+							std::function<void(Fracture::Edge_prop &, const Fracture::Edge_prop &)> update_edge_properties
+								= [](Fracture::Edge_prop & current_prop, const Fracture::Edge_prop & new_prop){} );
+
+	/*!
+		@brief	Renumbers vertices and edges of the graph along a space-filling curve
+		
+		After create_graph the order of vertices and edges in memory follows the 
+		order of insertion and of the cuts of the edges, not their position. This 
+		rebuilds the graph with vertices and edges sorted along a Hilbert (or Morton) 
+		curve, so that visiting the neighbours of a vertex and exporting the graph 
+		access memory almost sequentially. The spatial indices in the graph property 
+		are rebuilt with the new numbering
+		
+		@warning	The geometry is the same, but the vertex and edge numbering 
+					changes: the records of the files written afterwards (e.g. 
+					.pts and .vtp) come in a different order, so consumers 
+					relying on the indices of the original numbering see different ones
+		
+		@param G The graph to be reordered
+		@param curve (optional) The space-filling curve. Default: Hilbert curve
+	*/
+	void spatial_reorder(Graph & G, BGLgeom::sfc_curve const& curve = BGLgeom::sfc_curve::hilbert);
+	
 	/*!
 		@brief	Refines the graph
 		
 		It takes into account all the intersections of the current edge we want to 
 		insert and, according to them, creates new vertices and edges and breaks 
-		already present edges
+		already present edges. The spatial indices and the connected components 
+		in the graph property are kept updated
 		
 		@param G        				The graph
 		@param src 						Vertex descriptor of the source of the current "piece" of edge we are inserting
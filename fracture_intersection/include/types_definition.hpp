@@ -52,7 +52,7 @@ using point2 = BGLgeom::point<2>;
 using line = BGLgeom::linear_geometry<2>;
 
 //! Alias for the type of the graph used
-using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Fracture::Vertex_prop , Fracture::Edge_prop>;
+using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Fracture::Vertex_prop , Fracture::Edge_prop, Fracture::Graph_prop>;
 
 //! Alias type for the concrete reader
 using Reader = BGLgeom::reader_ASCII<Fracture::Vertex_prop, Fracture::Edge_prop>;
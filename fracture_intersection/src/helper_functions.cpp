@@ -32,10 +32,19 @@
 #include <cstdlib>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <cstdint>
 
 #include "helper_functions.hpp"
 #include "graph_builder.hpp"
 #include "graph_access.hpp"
+#include "arrangement_builder.hpp"
+#include "parallel_intersections.hpp"
+#include "segment_filter.hpp"
 #include "types_definition.hpp"
 
 using namespace Fracture;
@@ -94,10 +103,10 @@ void cut_old_edge(Edge_d &e, const Vertex_d & v, Graph & G){
 	Vertex_d tgt = boost::target(e, G);	
 	Edge_d e_tmp;
 	
-	e_tmp = new_linear_edge(src, v, G[e], G);
-	e_tmp = new_linear_edge(v, tgt, G[e], G);	
+	e_tmp = new_linear_edge(src, v, G[e], G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
+	e_tmp = new_linear_edge(v, tgt, G[e], G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);	
 	
-	boost::remove_edge(e, G);
+	BGLgeom::remove_edge(e, G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 	#ifndef NDEBUG
 		std::cout << "Edge removed: " << G[e].geometry << std::endl; 
 	#endif
@@ -109,8 +118,6 @@ void create_graph(Graph & G,
 				  std::function<void(Fracture::Edge_prop &, const Fracture::Edge_prop &)> update_edge_properties){
 	// Utilities to create the graph:	
 	
-	// Edge iterators to iterate over the graph
-	Edge_it e_it, e_end;
 	// The descriptor of the new added edges (it will be overwritten by any new addition)
 	Edge_d e;
 	//object of class Intersection (BGLgeom)
@@ -131,6 +138,20 @@ void create_graph(Graph & G,
 
 	// Number of the fracture, used as index
 	unsigned int frac_num = 0;
+	
+	// The spatial hash of the vertices must contain all the vertices already in the graph
+	if(G[boost::graph_bundle].vertex_index.size() != boost::num_vertices(G))
+		G[boost::graph_bundle].vertex_index.build(G);
+	// The same for the spatial index of the edges
+	if(G[boost::graph_bundle].edge_index.size() != boost::num_edges(G))
+		G[boost::graph_bundle].edge_index.build(G);
+	// And for the connected components
+	if(G[boost::graph_bundle].clusters.num_vertices() != boost::num_vertices(G) ||
+	   G[boost::graph_bundle].clusters.num_edges() != boost::num_edges(G))
+		G[boost::graph_bundle].clusters.build(G);
+	// The edges which may intersect the new fracture, and their coordinates
+	std::vector<Edge_d> near_edges;
+	BGLgeom::segment_block near_block;
 
 	while(!R.is_eof()){
 		++frac_num;		//updating index for the frcture number
@@ -139,20 +160,7 @@ void create_graph(Graph & G,
 		
 		//#ifndef NDEBUG or #ifndef VERBOSE
 			std::cout << "Current situation: ";
-			Vertex_it vv,vv_end;
-			Edge_it ee, ee_end;
-			// restart counting from 0
-			int count_v = 0; 
-			int count_e = 0;
-			for(std::tie(vv,vv_end) = boost::vertices(G); vv!=vv_end; ++vv) 
-				++count_v;
-				
-			for(std::tie(ee,ee_end) = boost::edges(G); ee!=ee_end; ++ee) 
-				++count_e;				
-			
-			
-			std::cout << count_v << " vertices, "<< count_e <<" edges."<<std::endl;  
-			
+			std::cout << boost::num_vertices(G) << " vertices, "<< boost::num_edges(G) <<" edges."<<std::endl;  
 		//#endif
 		
 		//Getting data form input file
@@ -163,20 +171,30 @@ void create_graph(Graph & G,
 		e_prop.index = frac_num;
 		
 		// Insertion of new vertices. If the coordinates matches with an already existing one, they returns those vertex descriptors
-		Vertex_d src = new_vertex(src_prop, G, true);
-		Vertex_d tgt = new_vertex(tgt_prop, G, true);		
+		Vertex_d src = new_vertex(src_prop, G, G[boost::graph_bundle].vertex_index, G[boost::graph_bundle].clusters);
+		Vertex_d tgt = new_vertex(tgt_prop, G, G[boost::graph_bundle].vertex_index, G[boost::graph_bundle].clusters);		
 		
 		// Creation of the new current line we want to insert
 		const line L(G[src].coordinates, G[tgt].coordinates);		
 		
 		intvect.clear();
-		// Checking for intersection of L with all the edges already present in the graph
-		for (std::tie(e_it, e_end) = boost::edges(G); e_it != e_end; ++e_it){
-			intobj_tmp = BGLgeom::compute_intersection(G[*e_it].geometry, L);
-			if(intobj_tmp.intersect == true){
-				Fracture::Int_layer<Graph> intobj(intobj_tmp, *e_it);
-				intvect.push_back(intobj);
-			}	
+		// Checking for intersection of L with the edges near to it (in the order of boost::edges)
+		G[boost::graph_bundle].edge_index.candidates(G[src].coordinates, G[tgt].coordinates, near_edges);
+		// compute_intersection is called only on the edges not discarded by a first fast test
+		near_block.clear();
+		for(Edge_d const& near_e : near_edges)
+			near_block.push_back(G[near_e].geometry.get_source(), G[near_e].geometry.get_target());
+		for(std::size_t first = 0; first < near_edges.size(); first += BGLgeom::segment_block::width){
+			std::uint64_t mask = near_block.candidates(G[src].coordinates, G[tgt].coordinates, first);
+			for(std::size_t k = first; mask != 0; ++k, mask >>= 1){
+				if(!(mask & 1))
+					continue;
+				intobj_tmp = BGLgeom::compute_intersection(G[near_edges[k]].geometry, L);
+				if(intobj_tmp.intersect == true){
+					Fracture::Int_layer<Graph> intobj(intobj_tmp, near_edges[k]);
+					intvect.push_back(intobj);
+				}
+			}
 		} //for
 
 		
@@ -184,7 +202,7 @@ void create_graph(Graph & G,
 		// if intvect is empty it means that the new fracture does not intersect any of the edges in graph
 		if(intvect.empty()){
 			std::cout << "No intersections" << std::endl;
-			e = new_linear_edge(src,tgt,e_prop,G);
+			e = new_linear_edge(src,tgt,e_prop, G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 		} else { // there is at least one intersection	
 			
 			// Order intvect in increasing or decreasing order based on the relative position of src and tgt 
@@ -230,11 +248,360 @@ void create_graph(Graph & G,
 			// Finally we connect the last intersection point with the target, but only if their vertex_desciptors do not coincide
 			current_src = next_src;
 			if(!(current_src == tgt))
-				e = new_linear_edge(current_src, tgt, e_prop, G);										
+				e = new_linear_edge(current_src, tgt, e_prop, G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);										
 		}// else 
 	} //while
 }; //create_graph
 
+namespace{
+	
+//! Reads all the fractures, numbering them from 1 as in create_graph
+void read_all_fractures(Reader & R, 
+						std::vector<Vertex_prop> & src_props, 
+						std::vector<Vertex_prop> & tgt_props, 
+						std::vector<Edge_prop> & e_props){
+	while(!R.is_eof()){
+		R.get_data();
+		src_props.push_back(R.get_source_data());
+		tgt_props.push_back(R.get_target_data());
+		e_props.push_back(R.get_edge_data());
+		e_props.back().index = e_props.size();		// Number of the fracture
+	}
+	std::cout << "Read " << e_props.size() << " fractures" << std::endl;
+}
+
+}	//anonymous
+
+void create_graph_arrangement(Graph & G, 
+							  Reader & R,
+							  std::function<void(Fracture::Edge_prop &, const Fracture::Edge_prop &)> update_edge_properties){
+	// All the fractures are read first
+	std::vector<Vertex_prop> src_props, tgt_props;
+	std::vector<Edge_prop> e_props;
+	read_all_fractures(R, src_props, tgt_props, e_props);
+	
+	if(G[boost::graph_bundle].vertex_index.size() != boost::num_vertices(G))
+		G[boost::graph_bundle].vertex_index.build(G);
+	BGLgeom::build_arrangement(src_props, tgt_props, e_props, update_edge_properties, G, G[boost::graph_bundle].vertex_index);
+	G[boost::graph_bundle].clusters.build(G);
+	// The spatial index of the edges is left empty: create_graph builds it when needed
+	std::cout << boost::num_vertices(G) << " vertices, "<< boost::num_edges(G) <<" edges."<<std::endl;
+}; //create_graph_arrangement
+
+void create_graph_parallel(Graph & G, 
+						   Reader & R,
+						   unsigned int n_threads,
+						   std::function<void(Fracture::Edge_prop &, const Fracture::Edge_prop &)> update_edge_properties){
+	std::vector<Vertex_prop> src_props, tgt_props;
+	std::vector<Edge_prop> e_props;
+	read_all_fractures(R, src_props, tgt_props, e_props);
+	
+	if(G[boost::graph_bundle].vertex_index.size() != boost::num_vertices(G))
+		G[boost::graph_bundle].vertex_index.build(G);
+	// First phase (parallel): the intersections. Second phase (sequential): the graph
+	auto intersect = [n_threads](std::vector<BGLgeom::linear_geometry<2>> const& S){
+		return BGLgeom::compute_all_intersections_parallel(S, n_threads);
+	};
+	BGLgeom::build_arrangement(src_props, tgt_props, e_props, update_edge_properties, G, G[boost::graph_bundle].vertex_index, intersect);
+	G[boost::graph_bundle].clusters.build(G);
+	std::cout << boost::num_vertices(G) << " vertices, "<< boost::num_edges(G) <<" edges."<<std::endl;
+}; //create_graph_parallel
+
+namespace{
+
+//! The pieces of the fractures inside a tile
+struct tile_pieces{
+	//! Properties of the sources of the pieces
+	std::vector<Vertex_prop> src_props;
+	//! Properties of the targets of the pieces
+	std::vector<Vertex_prop> tgt_props;
+	//! Properties of the pieces (the ones of their fracture)
+	std::vector<Edge_prop> e_props;
+};	//tile_pieces
+
+/*!
+	@brief	Cuts the fractures along the lines between the tiles
+	
+	The positions of the cuts are computed once for each fracture, so that 
+	the two pieces on the sides of a line share exactly the same point. 
+	The cuts nearer than TOL to an extreme or to another cut are ignored. 
+	The new extremes have only the coordinates as properties. Each piece 
+	goes in the tile containing its mid point, in the order of the fractures
+*/
+void cut_in_tiles(std::vector<Vertex_prop> const& src_props,
+				  std::vector<Vertex_prop> const& tgt_props,
+				  std::vector<Edge_prop> const& e_props,
+				  point2 const& origin,
+				  point2 const& size,
+				  unsigned int const& nx,
+				  unsigned int const& ny,
+				  std::vector<tile_pieces> & tiles){
+	const unsigned int n[2] = {nx, ny};
+	std::vector<double> t;
+	for(std::size_t i = 0; i < e_props.size(); ++i){
+		point2 const& A = src_props[i].coordinates;
+		point2 const& B = tgt_props[i].coordinates;
+		const double length = (B - A).norm();
+		// Positions of the cuts along the fracture
+		t.assign(1, 0.0);
+		for(unsigned int d = 0; d < 2; ++d)
+			for(unsigned int k = 1; k < n[d]; ++k){
+				const double line = origin(d) + k*size(d);
+				if((line - A(d))*(line - B(d)) < 0)
+					t.push_back((line - A(d)) / (B(d) - A(d)));
+			}
+		std::sort(t.begin()+1, t.end());
+		std::size_t n_cuts = 1;
+		for(std::size_t k = 1; k < t.size(); ++k)
+			if((t[k] - t[n_cuts-1])*length >= TOL && (1 - t[k])*length >= TOL)
+				t[n_cuts++] = t[k];
+		t.resize(n_cuts);
+		t.push_back(1.0);
+		
+		// The pieces
+		for(std::size_t k = 0; k+1 < t.size(); ++k){
+			const point2 P = (k == 0 ? A : point2(A + t[k]*(B - A)));
+			const point2 Q = (k+2 == t.size() ? B : point2(A + t[k+1]*(B - A)));
+			const point2 M = 0.5*(P + Q);
+			unsigned int c[2];
+			for(unsigned int d = 0; d < 2; ++d){
+				const double x = std::floor((M(d) - origin(d)) / size(d));
+				c[d] = static_cast<unsigned int>(std::min(std::max(x, 0.0), n[d] - 1.0));
+			}
+			tile_pieces & T = tiles[c[1]*nx + c[0]];
+			T.src_props.push_back(k == 0 ? src_props[i] : Vertex_prop(P));
+			T.tgt_props.push_back(k+2 == t.size() ? tgt_props[i] : Vertex_prop(Q));
+			T.e_props.push_back(e_props[i]);
+		}
+	}
+}	//cut_in_tiles
+
+//! An edge of a tile, with its extremes among the welded vertices of all the tiles
+struct tile_edge{
+	//! The extremes
+	std::size_t a, b;
+	//! Tile and descriptor of the edge
+	std::size_t tile;
+	Edge_d e;
+};	//tile_edge
+
+/*!
+	@brief	Splits the edges lying on the lines between the tiles
+	
+	An edge lying on a line belongs to the tile on one side, so it is not 
+	cut by the fractures of the tile on the other side which end on the 
+	line: it is split here in the welded vertices lying on it
+	
+	@param coords The coordinates of the welded vertices
+	@param edges The edges of all the tiles. The pieces of the edges split
+				 are added at the end
+*/
+void split_on_lines(std::vector<point2> const& coords,
+					point2 const& origin,
+					point2 const& size,
+					unsigned int const& nx,
+					unsigned int const& ny,
+					std::vector<tile_edge> & edges){
+	const unsigned int n[2] = {nx, ny};
+	for(unsigned int d = 0; d < 2; ++d){
+		const unsigned int other = 1 - d;
+		// Number of the line where P lies, zero if none
+		auto line_of = [&](point2 const& P) -> unsigned int {
+			const double k = std::round((P(d) - origin(d)) / size(d));
+			if(k < 1 || k > n[d] - 1.0 || std::abs(P(d) - (origin(d) + k*size(d))) > TOL)
+				return 0;
+			return static_cast<unsigned int>(k);
+		};
+		// The vertices on each line, sorted along it
+		std::vector<std::vector<std::pair<double, std::size_t>>> on_line(n[d]);
+		for(std::size_t w = 0; w < coords.size(); ++w){
+			const unsigned int k = line_of(coords[w]);
+			if(k > 0)
+				on_line[k].push_back(std::make_pair(coords[w](other), w));
+		}
+		for(auto & L : on_line)
+			std::sort(L.begin(), L.end());
+		
+		const std::size_t n_edges = edges.size();
+		std::vector<std::size_t> inner;
+		for(std::size_t i = 0; i < n_edges; ++i){
+			const unsigned int k = line_of(coords[edges[i].a]);
+			if(k == 0 || line_of(coords[edges[i].b]) != k)
+				continue;
+			double from = coords[edges[i].a](other), to = coords[edges[i].b](other);
+			const bool reversed = (from > to);
+			if(reversed)
+				std::swap(from, to);
+			auto first = std::upper_bound(on_line[k].begin(), on_line[k].end(), 
+										  std::make_pair(from + TOL, std::numeric_limits<std::size_t>::max()));
+			auto last = std::lower_bound(on_line[k].begin(), on_line[k].end(), std::make_pair(to - TOL, std::size_t(0)));
+			if(first >= last)
+				continue;
+			inner.clear();
+			for(; first != last; ++first)
+				inner.push_back(first->second);
+			if(reversed)
+				std::reverse(inner.begin(), inner.end());
+			const tile_edge E = edges[i];
+			edges[i].b = inner.front();
+			for(std::size_t j = 0; j < inner.size(); ++j)
+				edges.push_back(tile_edge{inner[j], (j+1 < inner.size() ? inner[j+1] : E.b), E.tile, E.e});
+		}
+	}
+}	//split_on_lines
+
+}	//anonymous
+
+void create_graph_tiled(Graph & G, 
+						Reader & R,
+						unsigned int nx,
+						unsigned int ny,
+						unsigned int n_threads,
+						std::function<void(Fracture::Edge_prop &, const Fracture::Edge_prop &)> update_edge_properties){
+	std::vector<Vertex_prop> src_props, tgt_props;
+	std::vector<Edge_prop> e_props;
+	read_all_fractures(R, src_props, tgt_props, e_props);
+	if(n_threads == 0)
+		n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+	nx = std::max(nx, 1u);
+	ny = std::max(ny, 1u);
+	
+	// The tiles split the bounding box of the fractures
+	point2 lo(0,0), hi(0,0);
+	if(!e_props.empty())
+		lo = hi = src_props[0].coordinates;
+	for(std::size_t i = 0; i < e_props.size(); ++i){
+		lo = lo.cwiseMin(src_props[i].coordinates).cwiseMin(tgt_props[i].coordinates);
+		hi = hi.cwiseMax(src_props[i].coordinates).cwiseMax(tgt_props[i].coordinates);
+	}
+	point2 size((hi(0) - lo(0)) / nx, (hi(1) - lo(1)) / ny);
+	if(size(0) <= 0){
+		nx = 1;
+		size(0) = 1;
+	}
+	if(size(1) <= 0){
+		ny = 1;
+		size(1) = 1;
+	}
+	const std::size_t n_tiles = nx*ny;
+	std::vector<tile_pieces> pieces(n_tiles);
+	cut_in_tiles(src_props, tgt_props, e_props, lo, size, nx, ny, pieces);
+	
+	// The graphs of the tiles, each one built by a single thread
+	std::vector<Graph> tiles(n_tiles);
+	std::atomic<std::size_t> next_tile(0);
+	auto work = [&](){
+		for(std::size_t k = next_tile++; k < n_tiles; k = next_tile++){
+			BGLgeom::build_arrangement(pieces[k].src_props, pieces[k].tgt_props, pieces[k].e_props, update_edge_properties,
+									   tiles[k], tiles[k][boost::graph_bundle].vertex_index);
+			pieces[k] = tile_pieces();
+		}
+	};
+	if(n_threads == 1)
+		work();
+	else{
+		std::vector<std::thread> threads;
+		for(unsigned int k = 0; k < std::min<std::size_t>(n_threads, n_tiles); ++k)
+			threads.emplace_back(work);
+		for(std::thread & th : threads)
+			th.join();
+	}
+	
+	// Stitching: the vertices of the tiles are welded
+	BGLgeom::vertex_hash<2> W(G[boost::graph_bundle].vertex_index.get_cell_size());
+	std::vector<std::pair<std::size_t, Vertex_d>> first_copy;		// (tile, vertex) where a welded vertex was found first
+	std::vector<point2> coords;
+	std::vector<std::vector<std::size_t>> welded(n_tiles);
+	for(std::size_t k = 0; k < n_tiles; ++k)
+		for(Vertex_d v = 0; v < boost::num_vertices(tiles[k]); ++v){
+			std::size_t w;
+			if(!W.find(tiles[k][v].coordinates, w)){
+				w = first_copy.size();
+				first_copy.push_back(std::make_pair(k, v));
+				coords.push_back(tiles[k][v].coordinates);
+				W.insert(w, coords.back());
+			}
+			welded[k].push_back(w);
+		}
+	const std::size_t n_welded = first_copy.size();
+	std::vector<bool> is_extreme(n_welded, false);
+	for(std::size_t i = 0; i < e_props.size(); ++i){
+		std::size_t w;
+		if(W.find(src_props[i].coordinates, w))
+			is_extreme[w] = true;
+		if(W.find(tgt_props[i].coordinates, w))
+			is_extreme[w] = true;
+	}
+	std::vector<tile_edge> edges;
+	for(std::size_t k = 0; k < n_tiles; ++k){
+		Edge_it e_it, e_end;
+		for(std::tie(e_it, e_end) = boost::edges(tiles[k]); e_it != e_end; ++e_it)
+			edges.push_back(tile_edge{welded[k][boost::source(*e_it, tiles[k])], welded[k][boost::target(*e_it, tiles[k])], k, *e_it});
+	}
+	split_on_lines(coords, lo, size, nx, ny, edges);
+	std::vector<unsigned int> degree(n_welded, 0);
+	std::vector<std::array<std::size_t,2>> incident(n_welded);
+	for(std::size_t i = 0; i < edges.size(); ++i)
+		for(std::size_t w : {edges[i].a, edges[i].b}){
+			if(degree[w] < 2)
+				incident[w][degree[w]] = i;
+			++degree[w];
+		}
+	
+	// A vertex is only a cut if it is not an extreme of a fracture and it 
+	// joins two pieces of the same fracture: a real vertex is an extreme 
+	// or an intersection, with at least three edges
+	std::vector<bool> is_cut(n_welded, false);
+	for(std::size_t w = 0; w < n_welded; ++w)
+		if(!is_extreme[w] && degree[w] == 2){
+			tile_edge const& E1 = edges[incident[w][0]];
+			tile_edge const& E2 = edges[incident[w][1]];
+			is_cut[w] = (tiles[E1.tile][E1.e].index == tiles[E2.tile][E2.e].index);
+		}
+	
+	// The vertices of the graph
+	if(G[boost::graph_bundle].vertex_index.size() != boost::num_vertices(G))
+		G[boost::graph_bundle].vertex_index.build(G);
+	std::vector<Vertex_d> vertex_of(n_welded);
+	for(std::size_t w = 0; w < n_welded; ++w)
+		if(!is_cut[w])
+			vertex_of[w] = BGLgeom::arrangement_detail::weld_vertex(tiles[first_copy[w].first][first_copy[w].second], 
+																	G, G[boost::graph_bundle].vertex_index);
+	
+	// The edges: the pieces joined by cuts are followed up to a real vertex
+	std::vector<bool> used(edges.size(), false);
+	for(std::size_t i = 0; i < edges.size(); ++i){
+		if(used[i] || (is_cut[edges[i].a] && is_cut[edges[i].b]))
+			continue;
+		std::size_t start = (is_cut[edges[i].a] ? edges[i].b : edges[i].a);
+		std::size_t current = i, w = (start == edges[i].a ? edges[i].b : edges[i].a);
+		used[i] = true;
+		while(is_cut[w]){
+			current = (incident[w][0] == current ? incident[w][1] : incident[w][0]);
+			used[current] = true;
+			w = (edges[current].a == w ? edges[current].b : edges[current].a);
+		}
+		// Same orientation of the first piece
+		Edge_prop const& e_prop = tiles[edges[i].tile][edges[i].e];
+		Vertex_d src = vertex_of[start], tgt = vertex_of[w];
+		if((G[tgt].coordinates - G[src].coordinates).dot(e_prop.geometry.get_target() - e_prop.geometry.get_source()) < 0)
+			std::swap(src, tgt);
+		Edge_d e = boost::add_edge(src, tgt, e_prop, G).first;
+		G[e].geometry.set_source(G[src].coordinates);
+		G[e].geometry.set_target(G[tgt].coordinates);
+	}
+	G[boost::graph_bundle].clusters.build(G);
+	// The spatial index of the edges is left empty: create_graph builds it when needed
+	std::cout << boost::num_vertices(G) << " vertices, "<< boost::num_edges(G) <<" edges."<<std::endl;
+}; //create_graph_tiled
+
+void spatial_reorder(Graph & G, BGLgeom::sfc_curve const& curve){
+	BGLgeom::reorder_graph<Graph,2>(G, curve);
+	G[boost::graph_bundle].vertex_index.build(G);
+	G[boost::graph_bundle].edge_index.build(G);
+	G[boost::graph_bundle].clusters.build(G);
+}; //spatial_reorder
+
 void refine_graph	(Graph &G, 
 					 const Vertex_d & src, 
 					 Fracture::Int_layer<Graph> & I,
@@ -253,9 +620,10 @@ void refine_graph	(Graph &G,
 		case int_type::X : {
 			// New vertex_descriptor for the intersection point
 			Fracture::Vertex_prop v_prop(I.int_pts.front());
-			Vertex_d v = new_vertex(v_prop, G);			
+			// The intersection point is a new vertex, but it has to be added to the spatial hash
+			Vertex_d v = new_vertex(v_prop, G, G[boost::graph_bundle].vertex_index, G[boost::graph_bundle].clusters, false);			
 			
-			e = new_linear_edge(src, v, e_prop, G);
+			e = new_linear_edge(src, v, e_prop, G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 			cut_old_edge(I.int_edge, v, G);
 			
 			// Setting the source vertex descriptor for the following iteration
@@ -266,7 +634,7 @@ void refine_graph	(Graph &G,
 		case int_type::T_new : {
 			// if the intersection point corresponds to the target I add a new edge
 			if(I.intersected_extreme_new == 1){
-				e = new_linear_edge(src, tgt, e_prop,G);
+				e = new_linear_edge(src, tgt, e_prop, G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 				cut_old_edge(I.int_edge, tgt,G);
 				next_src = tgt;
 			}	
@@ -285,7 +653,7 @@ void refine_graph	(Graph &G,
 			else
 				v = boost::target(I.int_edge, G);
 				
-			e = new_linear_edge(src, v, e_prop, G);
+			e = new_linear_edge(src, v, e_prop, G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 			
 			// Setting the source vertex descriptor for the following iteration
 			next_src = v;
@@ -302,7 +670,7 @@ void refine_graph	(Graph &G,
 			
 			// If src has same coordinates as v there's nothing to do, so we consider only the opposite case
 			if(!(src == v))
-				e = new_linear_edge(src, v, e_prop, G);
+				e = new_linear_edge(src, v, e_prop, G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 			
 			next_src = v;			
 			break;
@@ -339,13 +707,13 @@ void refine_graph	(Graph &G,
 			}
 			
 			if(I.intersected_extreme_new == 1){	//it means that src is outside and tgt inside
-				e = new_linear_edge(src,v1, e_prop, G);
+				e = new_linear_edge(src,v1, e_prop, G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 				
-				e = new_linear_edge(v1,tgt, G[I.int_edge], G);	
+				e = new_linear_edge(v1,tgt, G[I.int_edge], G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);	
 				// Edge e is overlapped by the new edge, therefore I update its properties to take into account this fact			
 				update_edge_properties(G[e],e_prop);				
 				
-				e = new_linear_edge(tgt,v2,G[I.int_edge],G);
+				e = new_linear_edge(tgt,v2,G[I.int_edge], G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 				
 				/* Since next_src = tgt, no new line will be added in the last step 
 				(this is necessarily the last intersection of the vector, otherwise 
@@ -353,16 +721,16 @@ void refine_graph	(Graph &G,
 				next_src = tgt;
 			}		
 			else{	//it means that src is inside and tgt outside
-				e = new_linear_edge(v1,src,G[I.int_edge],G);
+				e = new_linear_edge(v1,src,G[I.int_edge], G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 				
-				e = new_linear_edge(src,v2,G[I.int_edge],G);
+				e = new_linear_edge(src,v2,G[I.int_edge], G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 				// Edge e is overlapped by the new edge, therefore I update its properties to take into account this fact			
 				update_edge_properties(G[e],e_prop);
 								
 				next_src = v2;
 			}	
 			
-			boost::remove_edge(I.int_edge, G);
+			BGLgeom::remove_edge(I.int_edge, G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 			#ifndef NDEBUG
 				std::cout<<"Edge removed"<< G[e].geometry <<std::endl;
 			#endif
@@ -382,16 +750,16 @@ void refine_graph	(Graph &G,
 				v2 = boost::source(I.int_edge, G);						
 			}
 
-			e = new_linear_edge(v1,src,G[I.int_edge],G);
+			e = new_linear_edge(v1,src,G[I.int_edge], G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 			
-			e = new_linear_edge(src,tgt,G[I.int_edge],G);
+			e = new_linear_edge(src,tgt,G[I.int_edge], G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 			// Updating properties of the overlapped edge
 			update_edge_properties(G[e], e_prop);			
 			
-			e = new_linear_edge(tgt,v2,G[I.int_edge],G);		
+			e = new_linear_edge(tgt,v2,G[I.int_edge], G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);		
 			
 			// Removal of preexisting edge
-			boost::remove_edge(I.int_edge,G);
+			BGLgeom::remove_edge(I.int_edge, G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 			#ifndef NDEBUG
 				std::cout<<"Edge removed"<< G[e].geometry<<std::endl;						
 			#endif
@@ -415,7 +783,7 @@ void refine_graph	(Graph &G,
 			}
 			
 			if(v1 != src) // otherwise the edge has already been added
-				e = new_linear_edge(src, v1, e_prop, G);
+				e = new_linear_edge(src, v1, e_prop, G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 		
 			// updating the properties of the overlapped edge
  			update_edge_properties(G[I.int_edge], e_prop);
@@ -438,19 +806,19 @@ void refine_graph	(Graph &G,
 			}			
 			
 			if(v1 == src){ //the common extreme is the source, because they have the same vertex descriptor
-				e = new_linear_edge(tgt,v2,G[I.int_edge],G);
-				e = new_linear_edge(src,tgt, G[I.int_edge],G);
+				e = new_linear_edge(tgt,v2,G[I.int_edge], G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
+				e = new_linear_edge(src,tgt, G[I.int_edge], G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 			}						
 			else{ //the common extreme is the target
-				e = new_linear_edge(v1,src,G[I.int_edge],G);
-				e = new_linear_edge(src,tgt,G[I.int_edge],G);
+				e = new_linear_edge(v1,src,G[I.int_edge], G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
+				e = new_linear_edge(src,tgt,G[I.int_edge], G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 			}
 			
 			// in both cases of the if-else clause e is the edge_descr of the edge connecting src and tgt: here we update its properties
 			update_edge_properties(G[e],e_prop); 
 			
 			// Removal of preexisitng edge
-			boost::remove_edge(I.int_edge,G);
+			BGLgeom::remove_edge(I.int_edge, G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 			#ifndef NDEBUG
 				std::cout<<"Edge removed"<< G[e].geometry<<std::endl;
 			#endif
@@ -473,7 +841,7 @@ void refine_graph	(Graph &G,
 			
 			// It means that the common extreme is the target. I have to connect src to v1	
 			if(!(src == v1))
-				e = new_linear_edge(src,v1, e_prop, G);
+				e = new_linear_edge(src,v1, e_prop, G, G[boost::graph_bundle].edge_index, G[boost::graph_bundle].clusters);
 				
 			// Then we have simply to update the properties of the other part of the edge
 			update_edge_properties(G[I.int_edge], e_prop);
@@ -26,6 +26,11 @@
 	@author Ilaria Speranza & Mattia Tantardini
 	@date Jan, 2017
 	@brief Source code for fractures application
+	
+	Usage: main_fractures [--reorder]. With --reorder the graphs are 
+	renumbered along a space-filling curve before being written (see 
+	spatial_reorder): the geometry is the same, but the vertices and edges 
+	in the output files come in a different order.
 */
 
 #include <iostream>
@@ -41,7 +46,27 @@
 using namespace BGLgeom;
 using namespace Fracture;
 
-int main(){
+//! Prints the clusters of fractures, and if the network percolates between the sides of its bounding box
+void print_clusters(Graph & G){
+	BGLgeom::cluster_tracker<2> & C = G[boost::graph_bundle].clusters;
+	if(C.num_vertices() == 0)
+		return;
+	std::cout << C.num_clusters() << " clusters of fractures" << std::endl;
+	// The bounding box of the network
+	point<2> lo = G[0].coordinates, hi = G[0].coordinates;
+	C.for_each_cluster([&](std::size_t const& root, BGLgeom::cluster_tracker<2>::cluster_summary const& S){
+		lo = lo.cwiseMin(S.lo);
+		hi = hi.cwiseMax(S.hi);
+	});
+	std::cout << "The largest cluster along x has length " << C.cluster(C.widest_cluster(0)).length << std::endl;
+	std::cout << "Percolating along x: " << (C.percolates(0, lo(0), hi(0)) ? "yes" : "no")
+			  << ", along y: " << (C.percolates(1, lo(1), hi(1)) ? "yes" : "no") << std::endl;
+}
+
+int main(int argc, char* argv[]){
+	
+	// Renumbering along a space-filling curve only if asked, since it changes the order of the output
+	const bool reorder = (argc > 1 && std::string(argv[1]) == "--reorder");
 	
 	// Utilities to create the graph:	
 	
@@ -69,6 +94,10 @@ int main(){
 	// This function handles the entire construction of the graph while reading the input file contained in the reader
 	create_graph(G1,R1);
 	
+	// Storing vertices and edges close in memory if they are close in space (it changes the numbering)
+	if(reorder)
+		spatial_reorder(G1);
+	
 	// Counting total number of vertices and edges	
 	for (std::tie(e_it, e_end) = edges(G1); e_it != e_end; ++e_it)
 		++count_e;		
@@ -78,6 +107,7 @@ int main(){
 	std::cout << std::endl;
 	std::cout << "________________ FINAL SETTING GRAPH 1 ________________" << std::endl;
 	std::cout << count_v << " vertices and " << count_e << " edges" << std::endl;
+	print_clusters(G1);
 	
 	//Producing output
 	std::string filename1_out("../data/graph_fractureEleven.vtp");	
@@ -104,6 +134,10 @@ int main(){
 	// This function handles the entire construction of the graph while reading the input file contained in the reader
 	create_graph(G2,R2);
 	
+	// Storing vertices and edges close in memory if they are close in space (it changes the numbering)
+	if(reorder)
+		spatial_reorder(G2);
+	
 	// Counting total number of vertices and edges
 	for (std::tie(e_it, e_end) = edges(G2); e_it != e_end; ++e_it)
 		++count_e;	
@@ -113,6 +147,7 @@ int main(){
 	std::cout << endl;
 	std::cout << "________________ FINAL SETTING GRAPH 2 ________________" << std::endl;
 	std::cout << count_v << " vertices and " << count_e << " edges" << std::endl;
+	print_clusters(G2);
 	
 	// Production of the output
 	std::string filename2_out("../data/graph_fracture.vtp");
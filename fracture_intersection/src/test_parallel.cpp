@@ -0,0 +1,122 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file test_parallel.cpp
+	@author Ilaria Speranza & Mattia Tantardini
+	@date Jan, 2017
+	@brief Throughput of create_graph_parallel with 1 to 64 threads
+
+	A set of N random fractures in the unit square (N given as argument,
+	default 100000) is written in the format read by reader_fractures. The
+	graph is built by create_graph_parallel with 1, 2, 4, ..., 64 threads:
+	for each number of threads we report the time and the number of
+	fractures per second, and we check that the graph is exactly the same
+	obtained with one thread.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <cmath>
+
+#include "types_definition.hpp"
+#include "reader_fractures.hpp"
+#include "helper_functions.hpp"
+
+using namespace Fracture;
+
+//! Writes N random fractures in the format of reader_fractures
+void
+write_fractures(std::string const& filename, std::size_t const& N){
+	std::mt19937 gen(N);
+	std::uniform_real_distribution<double> pos(0.0, 1.0), angle(0.0, 4*std::atan(1.0));
+	const double L = 2.0/std::sqrt(static_cast<double>(N));
+	std::ofstream out(filename);
+	out << "# Num fract" << std::endl << N << std::endl;
+	out << "# num imposed fracture" << std::endl << 0 << std::endl;
+	out << "# fracture num pvalue" << std::endl << "#" << std::endl;
+	out << "#x0 y0 x1 y1 K_t K_n df source" << std::endl;
+	out.precision(12);
+	for(std::size_t i = 0; i < N; ++i){
+		double x = pos(gen), y = pos(gen), a = angle(gen);
+		out << x << " " << y << " " << x + L*std::cos(a) << " " << y + L*std::sin(a) << " 1.0e3 1.0e3 1.e-2 0" << std::endl;
+	}
+}
+
+//! True if the two graphs have the same vertices and the same edges, in the same order
+bool
+same_graph(Graph const& G1, Graph const& G2){
+	if(boost::num_vertices(G1) != boost::num_vertices(G2) || boost::num_edges(G1) != boost::num_edges(G2))
+		return false;
+	for(std::size_t v = 0; v < boost::num_vertices(G1); ++v)
+		if((G1[v].coordinates - G2[v].coordinates).norm() != 0)
+			return false;
+	Edge_it e1, e1_end, e2, e2_end;
+	std::tie(e1, e1_end) = boost::edges(G1);
+	std::tie(e2, e2_end) = boost::edges(G2);
+	for(; e1 != e1_end; ++e1, ++e2)
+		if(boost::source(*e1, G1) != boost::source(*e2, G2) || boost::target(*e1, G1) != boost::target(*e2, G2) ||
+		   G1[*e1].index != G2[*e2].index)
+			return false;
+	return true;
+}
+
+int main(int argc, char* argv[]){
+
+	std::size_t N = (argc > 1 ? std::stoul(argv[1]) : 100000);
+	std::cout << "================ THROUGHPUT OF create_graph_parallel ================" << std::endl;
+	std::cout << N << " fractures, " << std::thread::hardware_concurrency() << " concurrent threads supported" << std::endl;
+	std::string filename("../data/out_test_scaling.txt");
+	write_fractures(filename, N);
+
+	Graph G_ref;
+	bool ok = true;
+	for(unsigned int n_threads = 1; n_threads <= 64; n_threads *= 2){
+		Graph G;
+		reader_fractures R(filename);
+		R.ignore_dummy_lines(7);
+
+		// The output is discarded (the threads may write on the streams at the same time)
+		std::streambuf* cout_buf = std::cout.rdbuf(nullptr);
+		std::streambuf* cerr_buf = std::cerr.rdbuf(nullptr);
+		auto t0 = std::chrono::high_resolution_clock::now();
+		create_graph_parallel(G, R, n_threads);
+		auto t1 = std::chrono::high_resolution_clock::now();
+		std::cout.rdbuf(cout_buf);
+		std::cerr.rdbuf(cerr_buf);
+
+		if(n_threads == 1)
+			G_ref = G;
+		const bool same = same_graph(G_ref, G);
+		ok = ok && same;
+		double time = std::chrono::duration<double>(t1 - t0).count();
+		std::cout << n_threads << " threads: " << boost::num_vertices(G) << " vertices, " << boost::num_edges(G) << " edges, "
+				  << time << " s (" << N/time << " fractures/s)" << (same ? "" : " ERROR: different graph") << std::endl;
+	}
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file test_scaling.cpp
+	@author Ilaria Speranza & Mattia Tantardini
+	@date Jan, 2017
+	@brief Scaling of create_graph and create_graph_arrangement on synthetic sets of fractures
+	
+	Sets of N random fractures in the unit square are written in the format
+	read by reader_fractures, with length proportional to 1/sqrt(N), so 
+	that the average number of intersections of each fracture does not 
+	depend on N. For each set we report the time spent by create_graph and
+	by create_graph_arrangement, and the size of the two graphs. Then we do
+	the same with lengths following a power law (as in natural fracture
+	networks), where a few fractures cross a large part of the domain.
+	
+	Finally, on the largest graph of each set we compare the time needed 
+	to visit the neighbours of all the vertices and to export the graph 
+	in a .pts file, with the numbering left by create_graph and after 
+	spatial_reorder. The timings are meaningful only when the test is 
+	compiled with RELEASE=yes.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+#include "types_definition.hpp"
+#include "writer_pts.hpp"
+#include "reader_fractures.hpp"
+#include "helper_functions.hpp"
+
+using namespace Fracture;
+
+/*!
+	Writes N random fractures in the format of reader_fractures. If
+	power_law is true, the lengths follow a power law with exponent 2.5,
+	from 1/sqrt(N) up to the size of the domain
+*/
+void
+write_fractures(std::string const& filename, std::size_t const& N, bool const& power_law = false){
+	std::mt19937 gen(N);
+	std::uniform_real_distribution<double> pos(0.0, 1.0), angle(0.0, 4*std::atan(1.0)), u(0.0, 1.0);
+	const double L_min = 1.0/std::sqrt(static_cast<double>(N));
+	std::ofstream out(filename);
+	out << "# Num fract" << std::endl << N << std::endl;
+	out << "# num imposed fracture" << std::endl << 0 << std::endl;
+	out << "# fracture num pvalue" << std::endl << "#" << std::endl;
+	out << "#x0 y0 x1 y1 K_t K_n df source" << std::endl;
+	out.precision(12);
+	for(std::size_t i = 0; i < N; ++i){
+		double x = pos(gen), y = pos(gen), a = angle(gen);
+		double L = (power_law ? std::min(L_min*std::pow(1.0 - u(gen), -1.0/1.5), 1.0) : 2*L_min);
+		out << x << " " << y << " " << x + L*std::cos(a) << " " << y + L*std::sin(a) << " 1.0e3 1.0e3 1.e-2 0" << std::endl;
+	}
+}
+
+//! Sum over the vertices of the distance from their neighbours, and of the length of the incident edges, times a factor
+double
+visit(Graph const& G, double const& factor){
+	double sum = 0.0;
+	for(std::size_t v = 0; v < boost::num_vertices(G); ++v){
+		for(auto e : boost::make_iterator_range(boost::out_edges(v, G))){
+			std::size_t u = boost::target(e, G);
+			sum += factor*((G[u].coordinates - G[v].coordinates).norm() + G[e].geometry.length());
+		}
+	}
+	return sum;
+}
+
+/*!
+	Times (in seconds) of some visits of the neighbours and of the export 
+	of the graph in a .pts file (its output is discarded)
+*/
+std::pair<double, double>
+traversal_and_export(Graph const& G, unsigned int const& n_visits = 100){
+	// The factor is read at each visit, so that the visits are not merged by the compiler
+	volatile double factor = 1.0;
+	auto t0 = std::chrono::high_resolution_clock::now();
+	double sum = 0.0;
+	for(unsigned int i = 0; i < n_visits; ++i)
+		sum += visit(G, static_cast<double>(factor));
+	auto t1 = std::chrono::high_resolution_clock::now();
+	std::stringstream discard;
+	std::streambuf* cout_buf = std::cout.rdbuf(discard.rdbuf());
+	BGLgeom::writer_pts<Graph,2> W("../data/out_test_scaling.pts");
+	W.export_pts(G);
+	std::cout.rdbuf(cout_buf);
+	auto t2 = std::chrono::high_resolution_clock::now();
+	// Using the sum, so that the visits are not optimized away
+	if(sum < 0)
+		std::cout << sum << std::endl;
+	return std::make_pair(std::chrono::duration<double>(t1 - t0).count(), std::chrono::duration<double>(t2 - t1).count());
+}
+
+int main(int argc, char* argv[]){
+	
+#ifdef NDEBUG
+	std::cout << "Build: release" << std::endl << std::endl;
+#else
+	std::cout << "WARNING! Debug build: the timings are not meaningful, compile with RELEASE=yes" << std::endl << std::endl;
+#endif
+	
+	std::size_t N_max = (argc > 1 ? std::stoul(argv[1]) : 8000);
+	for(bool power_law : {false, true}){
+		std::cout << "===================== SCALING OF create_graph (" << (power_law ? "power-law" : "uniform")
+				  << " lengths) ===================" << std::endl;
+		for(std::size_t N = 500; N <= N_max; N *= 2){
+			std::string filename("../data/out_test_scaling.txt");
+			write_fractures(filename, N, power_law);
+			
+			// The output of the builders is discarded
+			std::stringstream discard;
+			std::streambuf* cout_buf = std::cout.rdbuf(discard.rdbuf());
+			std::streambuf* cerr_buf = std::cerr.rdbuf(discard.rdbuf());
+			Graph G;
+			reader_fractures R(filename);
+			R.ignore_dummy_lines(7);
+			auto t0 = std::chrono::high_resolution_clock::now();
+			create_graph(G, R);
+			auto t1 = std::chrono::high_resolution_clock::now();
+			Graph G_arr;
+			reader_fractures R_arr(filename);
+			R_arr.ignore_dummy_lines(7);
+			auto t2 = std::chrono::high_resolution_clock::now();
+			create_graph_arrangement(G_arr, R_arr);
+			auto t3 = std::chrono::high_resolution_clock::now();
+			std::cout.rdbuf(cout_buf);
+			std::cerr.rdbuf(cerr_buf);
+			
+			double time = std::chrono::duration<double>(t1 - t0).count();
+			double time_arr = std::chrono::duration<double>(t3 - t2).count();
+			std::cout << N << " fractures: " << boost::num_vertices(G) << " vertices, " << boost::num_edges(G) << " edges, " 
+					  << time << " s (" << 1e6*time/N << " us per fracture), " 
+					  << G[boost::graph_bundle].edge_index.num_cells() << " cells in the index" << std::endl;
+			std::cout << "\tarrangement: " << boost::num_vertices(G_arr) << " vertices, " << boost::num_edges(G_arr) << " edges, " 
+					  << time_arr << " s (" << 1e6*time_arr/N << " us per fracture)" << std::endl;
+			
+			// Traversal and export of the largest graph, before and after spatial_reorder
+			if(2*N > N_max){
+				std::pair<double, double> t_insertion = traversal_and_export(G);
+				spatial_reorder(G);
+				std::pair<double, double> t_hilbert = traversal_and_export(G);
+				std::cout << "\t100 visits of the neighbours: " << t_insertion.first << " s with the insertion order, "
+						  << t_hilbert.first << " s after spatial_reorder (" << t_insertion.first/t_hilbert.first << "x)" << std::endl;
+				std::cout << "\texport in a .pts file:        " << t_insertion.second << " s with the insertion order, "
+						  << t_hilbert.second << " s after spatial_reorder (" << t_insertion.second/t_hilbert.second << "x)" << std::endl;
+			}
+		}
+		std::cout << std::endl;
+	}
+	
+	return 0;
+}
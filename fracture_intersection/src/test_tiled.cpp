@@ -0,0 +1,163 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file test_tiled.cpp
+	@author Ilaria Speranza & Mattia Tantardini
+	@date Jan, 2017
+	@brief Comparison of create_graph_tiled with create_graph_arrangement
+
+	Two sets of fractures are written in the format read by reader_fractures:
+	N random fractures in the unit square (N given as argument, default
+	20000), and fractures joining the points of a lattice, which lie on
+	the lines between the tiles, cross them in their intersections and
+	end on them. The graph built with 1x1 up to 8x8 tiles must have the
+	same vertices and edges of the one built by create_graph_arrangement.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+#include "types_definition.hpp"
+#include "reader_fractures.hpp"
+#include "helper_functions.hpp"
+
+using namespace Fracture;
+
+//! Writes the fractures in the format of reader_fractures
+void
+write_fractures(std::string const& filename, std::vector<point2> const& P){
+	std::ofstream out(filename);
+	out << "# Num fract" << std::endl << P.size()/2 << std::endl;
+	out << "# num imposed fracture" << std::endl << 0 << std::endl;
+	out << "# fracture num pvalue" << std::endl << "#" << std::endl;
+	out << "#x0 y0 x1 y1 K_t K_n df source" << std::endl;
+	out.precision(17);
+	for(std::size_t i = 0; i+1 < P.size(); i += 2)
+		out << P[i](0) << " " << P[i](1) << " " << P[i+1](0) << " " << P[i+1](1) << " 1.0e3 1.0e3 1.e-2 0" << std::endl;
+}
+
+//! An edge as its extremes (rounded and ordered) and the number of its fracture
+using edge_key = std::tuple<long long, long long, long long, long long, int>;
+
+//! The edges of the graph, sorted
+std::vector<edge_key>
+edge_list(Graph const& G){
+	auto round = [](double const& x){ return std::llround(x*1e8); };
+	std::vector<edge_key> E;
+	Edge_it e_it, e_end;
+	for(std::tie(e_it, e_end) = boost::edges(G); e_it != e_end; ++e_it){
+		point2 const& A = G[boost::source(*e_it, G)].coordinates;
+		point2 const& B = G[boost::target(*e_it, G)].coordinates;
+		auto a = std::make_pair(round(A(0)), round(A(1))), b = std::make_pair(round(B(0)), round(B(1)));
+		if(b < a)
+			std::swap(a, b);
+		E.push_back(std::make_tuple(a.first, a.second, b.first, b.second, G[*e_it].index));
+	}
+	std::sort(E.begin(), E.end());
+	return E;
+}
+
+//! Builds the graph of the file in the given way, without messages
+template <typename Build>
+Graph
+build(std::string const& filename, Build const& f){
+	Graph G;
+	reader_fractures R(filename);
+	R.ignore_dummy_lines(7);
+	std::streambuf* cout_buf = std::cout.rdbuf(nullptr);
+	std::streambuf* cerr_buf = std::cerr.rdbuf(nullptr);
+	f(G, R);
+	std::cout.rdbuf(cout_buf);
+	std::cerr.rdbuf(cerr_buf);
+	return G;
+}
+
+//! Compares the tiled graphs with the one of create_graph_arrangement
+bool
+compare(std::string const& name, std::string const& filename){
+	auto t0 = std::chrono::steady_clock::now();
+	Graph G_ref = build(filename, [](Graph & G, Reader & R){ create_graph_arrangement(G, R); });
+	auto t1 = std::chrono::steady_clock::now();
+	const std::vector<edge_key> E_ref = edge_list(G_ref);
+	std::cout << name << ": " << boost::num_vertices(G_ref) << " vertices, " << boost::num_edges(G_ref) << " edges" << std::endl;
+	std::cout << "\tcreate_graph_arrangement: " << std::chrono::duration<double>(t1-t0).count() << " s" << std::endl;
+
+	bool ok = true;
+	for(unsigned int n : {1u, 2u, 3u, 4u, 8u}){
+		t0 = std::chrono::steady_clock::now();
+		Graph G = build(filename, [n](Graph & G, Reader & R){ create_graph_tiled(G, R, n, n, 0); });
+		t1 = std::chrono::steady_clock::now();
+		const bool same = (boost::num_vertices(G) == boost::num_vertices(G_ref) && edge_list(G) == E_ref);
+		std::cout << "\t" << n << "x" << n << " tiles: " << boost::num_vertices(G) << " vertices, " << boost::num_edges(G)
+				  << " edges, " << std::chrono::duration<double>(t1-t0).count() << " s "
+				  << (same ? "Same graph" : "ERROR: different graph") << std::endl;
+		ok = ok && same;
+	}
+	return ok;
+}
+
+int main(int argc, char* argv[]){
+
+	std::cout << "================ GRAPH BUILT BY TILES ================" << std::endl;
+	bool ok = true;
+	std::string filename("../data/out_test_tiled.txt");
+	std::mt19937 gen(7);
+
+	// Random fractures
+	const std::size_t N = (argc > 1 ? std::stoul(argv[1]) : 20000);
+	std::uniform_real_distribution<double> pos(0.0, 1.0), angle(0.0, 4*std::atan(1.0));
+	const double L = 2.0/std::sqrt(static_cast<double>(N));
+	std::vector<point2> P;
+	for(std::size_t i = 0; i < N; ++i){
+		point2 A(pos(gen), pos(gen));
+		const double a = angle(gen);
+		P.push_back(A);
+		P.push_back(A + L*point2(std::cos(a), std::sin(a)));
+	}
+	write_fractures(filename, P);
+	ok = compare("Random", filename) && ok;
+
+	// Fractures on a lattice: horizontal, vertical and diagonal
+	std::uniform_int_distribution<int> lattice(0, 16);
+	P.clear();
+	while(P.size() < 1000){
+		point2 A(lattice(gen), lattice(gen)), B(lattice(gen), lattice(gen));
+		if(A != B && (A(0) == B(0) || A(1) == B(1) || std::abs(A(0)-B(0)) == std::abs(A(1)-B(1)))){
+			P.push_back(0.0625*A);
+			P.push_back(0.0625*B);
+		}
+	}
+	write_fractures(filename, P);
+	ok = compare("Lattice", filename) && ok;
+
+	std::cout << std::endl << (ok ? "Test passed" : "ERROR: test failed") << std::endl;
+	return ok ? 0 : 1;
+}
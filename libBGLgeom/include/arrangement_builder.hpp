@@ -0,0 +1,290 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	arrangement_builder.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Builds at once the planar graph of a set of intersecting segments
+
+	Inserting the segments one at a time, each new segment cuts the edges
+	it intersects: every cut removes an edge and adds two new ones. When
+	all the segments are known in advance, all their intersections are
+	computed first (see sweep_intersections.hpp and parallel_intersections.hpp);
+	then the points on each segment are sorted along it, and each piece
+	between two consecutive points is added to the graph only once, without
+	ever removing an edge.
+*/
+
+#ifndef HH_ARRANGEMENT_BUILDER_HH
+#define HH_ARRANGEMENT_BUILDER_HH
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <cstdlib>
+#include <boost/graph/adjacency_list.hpp>
+#include "point.hpp"
+#include "linear_geometry.hpp"
+#include "graph_access.hpp"
+#include "vertex_hash.hpp"
+#include "sweep_intersections.hpp"
+
+namespace BGLgeom{
+
+namespace arrangement_detail{
+
+//! A vertex on a segment, with its position along the segment
+struct vertex_on_segment{
+	//! Position along the segment (0 in the source, 1 in the target)
+	double t;
+	//! The vertex
+	std::size_t v;
+};	//vertex_on_segment
+
+//! Position of P along the segment from A to B
+inline double
+position(BGLgeom::point<2> const& A, BGLgeom::point<2> const& B, BGLgeom::point<2> const& P){
+	return (P - A).dot(B - A) / (B - A).squaredNorm();
+}
+
+/*!
+	@brief	Looks for the vertex at P, creating it if not found
+
+	Same as new_vertex() with the spatial hash, but without messages
+*/
+template <typename Graph, typename Vertex_prop>
+std::size_t
+weld_vertex(Vertex_prop const& v_prop, Graph & G, BGLgeom::vertex_hash<2> & H){
+	std::size_t v;
+	if(!H.find(v_prop.coordinates, v)){
+		v = boost::add_vertex(v_prop, G);
+		BGLgeom::vertex_added(G, v);
+		H.insert(v, G[v].coordinates);
+	}
+	return v;
+}
+
+}	//arrangement_detail
+
+/*!
+	@brief	Builds the graph of a set of segments, with a vertex in each
+			intersection point
+
+	The result is the same graph obtained inserting the segments one at a
+	time, in the given order, and cutting the edges at each intersection:
+	\li	the vertices are the extremes of the segments and the intersection
+		points. Coincident points (closer than TOL) are the same vertex, which
+		has the properties of the first one found in the order of insertion:
+		the extremes of the i-th segment come with their properties, the
+		intersection points have only the coordinates;
+	\li	each edge is a piece of one or more segments between two consecutive
+		vertices, oriented as the first segment containing it. It has the
+		properties of that segment, updated with the ones of each of the
+		following segments overlapping it, in order, through the functor
+		update_edge_properties(current_prop, new_prop).
+
+	Each vertex and each edge is added to the graph only once, and no edge
+	is removed. A spatial index of the edges (edge_grid) can be built at the
+	end, with edge_grid::build().
+
+	@pre	The graph must not contain edges, since the segments are not
+			intersected with them. It may contain vertices: the extremes and
+			the intersection points coinciding with them are welded to them
+	@pre	The vertex property must be constructible from the coordinates, the
+			edge property must have a linear_geometry<2> as geometry
+	@remark	The segments whose extremes coincide are ignored
+	@remark	It does not print anything for each vertex or edge, also in debug mode
+
+	@param src_prop The properties of the source of each segment
+	@param tgt_prop The properties of the target of each segment
+	@param e_prop The properties of each segment
+	@param update_edge_properties Functor called as update(current_prop, new_prop)
+			on the properties of a piece of edge overlapped by a following segment
+	@param G The graph
+	@param H The spatial hash of the vertices of G, updated with the new ones
+	@param compute_intersections Functor called as compute_intersections(S)
+			on the segments, returning all their intersections ordered by
+			(first, second), as compute_all_intersections() (which is used by
+			the overload without this argument) or
+			compute_all_intersections_parallel()
+*/
+template <typename Graph, typename Vertex_prop, typename Edge_prop, typename Update, typename Intersect>
+void
+build_arrangement(std::vector<Vertex_prop> const& src_prop,
+				  std::vector<Vertex_prop> const& tgt_prop,
+				  std::vector<Edge_prop> const& e_prop,
+				  Update const& update_edge_properties,
+				  Graph & G,
+				  BGLgeom::vertex_hash<2> & H,
+				  Intersect const& compute_intersections){
+
+	using arrangement_detail::vertex_on_segment;
+	const std::size_t n = e_prop.size();
+	if(src_prop.size() != n || tgt_prop.size() != n){
+		std::cerr << "ERROR! BGLgeom::build_arrangement(): " << n << " segments, but "
+				  << src_prop.size() << " sources and " << tgt_prop.size() << " targets" << std::endl;
+		std::cerr << "Aborting" << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	if(boost::num_edges(G) != 0){
+		std::cerr << "ERROR! BGLgeom::build_arrangement(): the graph already contains edges" << std::endl;
+		std::cerr << "Aborting" << std::endl;
+		exit(EXIT_FAILURE);
+	}
+
+	/*
+	The segments join their extremes as they are welded when inserted one at
+	a time: each extreme is moved on a vertex of the graph or on an extreme
+	of a previous segment, if it coincides with it
+	*/
+	std::vector<BGLgeom::linear_geometry<2>> S(n);
+	{
+		BGLgeom::vertex_hash<2> W(H);
+		std::vector<BGLgeom::point<2>> extremes;
+		extremes.reserve(2*n);
+		const std::size_t n_old = boost::num_vertices(G);
+		auto weld = [&](BGLgeom::point<2> const& P) -> BGLgeom::point<2> {
+			std::size_t v;
+			if(W.find(P, v))
+				return v < n_old ? BGLgeom::point<2>(G[v].coordinates) : extremes[v - n_old];
+			W.insert(n_old + extremes.size(), P);
+			extremes.push_back(P);
+			return P;
+		};
+		for(std::size_t i = 0; i < n; ++i){
+			BGLgeom::point<2> A = weld(src_prop[i].coordinates);
+			BGLgeom::point<2> B = weld(tgt_prop[i].coordinates);
+			S[i] = BGLgeom::linear_geometry<2>(A, B);
+		}
+	}
+
+	// The intersection points on each segment, with the other segment
+	std::vector<std::vector<std::pair<std::size_t, BGLgeom::point<2>>>> int_pts(n);
+	for(BGLgeom::segment_intersection const& SI : compute_intersections(S))
+		for(unsigned int k = 0; k < SI.I.numberOfIntersections; ++k){
+			int_pts[SI.first].push_back(std::make_pair(SI.second, SI.I.intersectionPoint[k]));
+			int_pts[SI.second].push_back(std::make_pair(SI.first, SI.I.intersectionPoint[k]));
+		}
+
+	/*
+	Vertices, in the order in which they would be created inserting the
+	segments one at a time: the extremes of a segment, then its intersections
+	with the previous ones along it
+	*/
+	std::vector<std::vector<vertex_on_segment>> on(n);
+	for(std::size_t i = 0; i < n; ++i){
+		BGLgeom::point<2> const& A = S[i].get_source();
+		BGLgeom::point<2> const& B = S[i].get_target();
+		if((B - A).norm() == 0)
+			continue;
+		std::size_t src = arrangement_detail::weld_vertex(src_prop[i], G, H);
+		std::size_t tgt = arrangement_detail::weld_vertex(tgt_prop[i], G, H);
+		on[i].push_back(vertex_on_segment{0.0, src});
+		on[i].push_back(vertex_on_segment{1.0, tgt});
+		std::stable_sort(int_pts[i].begin(), int_pts[i].end(),
+			[&A, &B](std::pair<std::size_t, BGLgeom::point<2>> const& P, std::pair<std::size_t, BGLgeom::point<2>> const& Q){
+				return arrangement_detail::position(A, B, P.second) < arrangement_detail::position(A, B, Q.second);
+			});
+		for(auto const& P : int_pts[i])
+			if(P.first < i){
+				std::size_t v = arrangement_detail::weld_vertex(Vertex_prop(P.second), G, H);
+				on[i].push_back(vertex_on_segment{0.0, v});
+				on[P.first].push_back(vertex_on_segment{0.0, v});
+			}
+	}
+
+	/*
+	Pieces of edge between consecutive vertices along each segment. A piece
+	shared by more segments is taken once, with the segments containing it
+	in order of insertion
+	*/
+	struct piece{
+		std::size_t src, tgt;
+		std::vector<std::size_t> segments;
+	};
+	std::vector<piece> pieces;
+	std::map<std::pair<std::size_t, std::size_t>, std::size_t> piece_of;
+	for(std::size_t i = 0; i < n; ++i){
+		if(on[i].empty())
+			continue;
+		BGLgeom::point<2> const& A = S[i].get_source();
+		BGLgeom::point<2> const& B = S[i].get_target();
+		// The intersection points are sorted with the coordinates of the vertex they have been welded to
+		for(std::size_t k = 2; k < on[i].size(); ++k)
+			on[i][k].t = arrangement_detail::position(A, B, G[on[i][k].v].coordinates);
+		std::stable_sort(on[i].begin(), on[i].end(), [](vertex_on_segment const& a, vertex_on_segment const& b){ return a.t < b.t; });
+		auto last = std::unique(on[i].begin(), on[i].end(), [](vertex_on_segment const& a, vertex_on_segment const& b){ return a.v == b.v; });
+		on[i].erase(last, on[i].end());
+		for(std::size_t k = 1; k < on[i].size(); ++k){
+			const std::size_t u = on[i][k-1].v, v = on[i][k].v;
+			auto key = std::make_pair(std::min(u,v), std::max(u,v));
+			auto it = piece_of.find(key);
+			if(it == piece_of.end()){
+				piece_of.emplace(key, pieces.size());
+				pieces.push_back(piece{u, v, std::vector<std::size_t>(1, i)});
+			} else
+				pieces[it->second].segments.push_back(i);
+		}
+	}
+
+	// Edges
+	for(piece const& p : pieces){
+		Edge_prop prop = e_prop[p.segments.front()];
+		for(std::size_t k = 1; k < p.segments.size(); ++k)
+			update_edge_properties(prop, e_prop[p.segments[k]]);
+		BGLgeom::Edge_desc<Graph> e = boost::add_edge(p.src, p.tgt, prop, G).first;
+		G[e].geometry.set_source(G[p.src].coordinates);
+		G[e].geometry.set_target(G[p.tgt].coordinates);
+	}
+
+	#ifndef NDEBUG
+		std::cout << "Arrangement of " << n << " segments: " << boost::num_vertices(G) << " vertices, "
+				  << boost::num_edges(G) << " edges" << std::endl;
+	#endif
+}	//build_arrangement
+
+/*!
+	@brief	Builds the graph of a set of segments, with a vertex in each
+			intersection point
+
+	The intersections are computed with the sweep line (see the previous
+	function)
+*/
+template <typename Graph, typename Vertex_prop, typename Edge_prop, typename Update>
+void
+build_arrangement(std::vector<Vertex_prop> const& src_prop,
+				  std::vector<Vertex_prop> const& tgt_prop,
+				  std::vector<Edge_prop> const& e_prop,
+				  Update const& update_edge_properties,
+				  Graph & G,
+				  BGLgeom::vertex_hash<2> & H){
+	build_arrangement(src_prop, tgt_prop, e_prop, update_edge_properties, G, H,
+					  [](std::vector<BGLgeom::linear_geometry<2>> const& S){ return BGLgeom::compute_all_intersections(S); });
+}	//build_arrangement
+
+}	//BGLgeom
+
+#endif	//HH_ARRANGEMENT_BUILDER_HH
@@ -72,6 +72,7 @@
 #include <array>
 #include <string>
 #include <initializer_list>
+#include <functional>
 
 #include "point.hpp"
 #include "boundary_conditions.hpp"
@@ -236,12 +237,16 @@ struct Vertex_base_property{
 	
 	@param Geom Type of the geometry for the edge
 	@param dim The dimension of the space
+	@param Mesh Type of the container of the mesh: by default the mesh is
+				kept in memory; with BGLgeom::arena_mesh<dim> (see mesh_arena.hpp)
+				it is stored in a file mapped in memory; with 
+				BGLgeom::padded_mesh<dim> (see mesh.hpp) its points are padded
 */
-template <typename Geom, unsigned int dim>
+template <typename Geom, unsigned int dim, typename Mesh = BGLgeom::mesh<dim>>
 struct Edge_base_property{
 	//! Definition of some types which may be useful to see outside the struct
 	using geom_t = Geom;
-	using mesh_t = typename BGLgeom::mesh<dim>;
+	using mesh_t = Mesh;
 
 	//! The class handling the parameterization of the edge
 	geom_t geometry;
@@ -306,12 +311,12 @@ struct Edge_base_property{
 	
 	//! Helper method to create a mesh using the uniform_mesh() method of struct mesh
 	void make_uniform_mesh(unsigned int const& n){
-		mesh.uniform_mesh(n, geometry);
+		mesh.uniform_mesh(n, BGLgeom::mesh_evaluator<mesh_t>(geometry));
 	}
 	
 	//! Helper method to create a mesh using the variable_mesh() method of struct mesh
 	void make_variable_mesh(unsigned int const& n, std::function<double(double)> const& spacing_function){
-		mesh.variable_mesh(n, spacing_function, geometry);
+		mesh.variable_mesh(n, spacing_function, BGLgeom::mesh_evaluator<mesh_t>(geometry));
 	}
 	
 	/*!
@@ -37,13 +37,14 @@
 #include <vector>
 #include <cassert>
 #include <cmath>
+#include <limits>
+#include <algorithm>
 #include <functional>
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 #include "edge_geometry.hpp"
 #include "adaptive_quadrature.hpp"
 
-#define tol_dist 1e-8
-
 namespace BGLgeom{
 
 using vect = std::vector<double>;
@@ -61,12 +62,14 @@ using vect = std::vector<double>;
 	@param t Parametric point
 	@param U Knot sequence
 	@return	Knot span
-	
-	@todo	This implementation has linear, rather than log complexity
 */
 int 
 findspan (int n, int p, double u, const vect &U);
 
+//! Find the knot span of the parametric point u, in single precision (see above)
+int 
+findspan (int n, int p, float u, std::vector<float> const& U);
+
 /*!
 	@brief	Compute the functions of the basis
 	
@@ -81,6 +84,10 @@ findspan (int n, int p, double u, const vect &U);
 void
 basisfun (int i, double t, int p, const vect &U, vect &N);
 
+//! Compute the functions of the basis, in single precision (see above)
+void
+basisfun (int i, float t, int p, std::vector<float> const& U, std::vector<float> & N);
+
 /*!
 	@brief	enum class to distinguish how to use and create the bspline
 	
@@ -103,15 +110,21 @@ enum class BSP_type {Approx, Interp};
 			which returns an error message and exits.
 	@param dim Dimension of the space
 	@param deg Degree of the spline
+	@param T Scalar type of the control points, of the knots and of the parameter
+	@param Point Type of the stored control points (for instance padded_point,
+				 see point.hpp, to vectorize the evaluation)
+	@param Alloc Allocator of the stored control points
 */
-template <int dim = 3, int deg = 3>
+template <int dim = 3, int deg = 3, typename T = double, typename Point = BGLgeom::point<dim,T>, typename Alloc = std::allocator<Point>>
 class
-bspline_geometry : public BGLgeom::edge_geometry<dim> {
+bspline_geometry : public BGLgeom::edge_geometry<dim,T> {
 
 	public:
 		
-		using point = BGLgeom::point<dim>;
+		using point = BGLgeom::point<dim,T>;
 		using vect_pts = std::vector<point>;
+		using vect = std::vector<T>;
+		using ctrl_pts = std::vector<Point,Alloc>;
 		
 		//! Default constructor
 		bspline_geometry() : nc(0), k(), C(), dk(), d2k(), dC(), d2C() {};
@@ -157,16 +170,16 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 			if(_type == BSP_type::Approx){
 				nc = _P.size();
 				k = make_knots(nc);
-				C = _P;
+				C = to_ctrl(_P);
 				
 				// construction of spline for the vector of first derivative
-				dC.resize (nc-1);
+				dC.assign (nc-1, Point::Zero());
 				dk.resize (k.size () - 2, 0.0);
 				bspderiv (deg, C, nc, k, k.size (), dC, dk);
 
 				// construction of spline for the vector of second derivative
 				d2k.resize (dk.size () - 2, 0.0);    
-				d2C.resize (nc-2);
+				d2C.assign (nc-2, Point::Zero());
 				bspderiv (deg-1, dC, (nc-1), dk, dk.size (), d2C, d2k);				
 			} else {	// _type == BSP_type::Interp
 				if(deg != 3){
@@ -183,8 +196,8 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 					
 					int span;
 					// Building vandermonde matrix to recover the control points
-					Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> V = 
-						Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>::Zero(nc,nc);
+					Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> V = 
+						Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>::Zero(nc,nc);
 					for(std::size_t i = 0; i < grev.size(); ++i){
 						vect N(deg+1);
 						span = findspan(nc-1, deg, grev[i], k);
@@ -196,28 +209,28 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 					}
 
 					// Building an Eigen matrix where to put the known term of the linear system
-					Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> PP(nc,dim);
+					Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> PP(nc,dim);
 					for(std::size_t i = 0; i < nc; ++i)
 						for(std::size_t j = 0; j < dim; ++j)
 							PP(i,j) = _P[i](j);
 					
 					// Solving the linear system V*CC = PP, where CC are the control points we have to find
-					Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> CC = V.lu().solve(PP);
+					Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> CC = V.lu().solve(PP);
 
 					// Copying the founded control points into the private attribute
-					C.resize(nc);
+					C.assign(nc, Point::Zero());
 					for(std::size_t i = 0; i < nc; ++i)
 						for(std::size_t j = 0; j < dim; ++j)
 							C[i](j) = CC(i,j);
 							
 					// construction of spline for the vector of first derivative
-					dC.resize (nc-1);
+					dC.assign (nc-1, Point::Zero());
 					dk.resize (k.size () - 2, 0.0);
 					bspderiv (deg, C, nc, k, k.size (), dC, dk);
 
 					// construction of spline for the vector of second derivative
 					d2k.resize (dk.size () - 2, 0.0);    
-					d2C.resize (nc-2);
+					d2C.assign (nc-2, Point::Zero());
 					bspderiv (deg-1, dC, (nc-1), dk, dk.size (), d2C, d2k);
 				}
 			}		
@@ -237,17 +250,17 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 			if(_type == BSP_type::Approx){
 				nc = C_.size();
 				k = k_;
-				C = C_;
+				C = to_ctrl(C_);
 
 				// construction of spline for the vector of first derivative
-				dC.resize (nc-1);				
+				dC.assign (nc-1, Point::Zero());				
 				dk.resize (k.size () - 2, 0.0);
-				bspderiv (deg, C, dim, nc, k, k.size (), dC, dk);
+				bspderiv (deg, C, nc, k, k.size (), dC, dk);
 
 				// construction of spline for the vector of second derivative
 				d2k.resize (dk.size () - 2, 0.0);    
-				d2C.resize (nc-2);
-				bspderiv (deg-1, dC, dim, (nc-1), dk, dk.size (), d2C, d2k);
+				d2C.assign (nc-2, Point::Zero());
+				bspderiv (deg-1, dC, (nc-1), dk, dk.size (), d2C, d2k);
 			} else {	// _type == BSP_type::Approx
 				std::cerr << "ERROR! BGLgeom::bspline_geometry(): " << std::endl;
 				std::cerr << "\tinterpolating constructor with given knot vector not available!" << std::endl; 
@@ -257,7 +270,42 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 				exit(EXIT_FAILURE);
 			}
 		}
-		
+
+		/*!
+			@brief	Fitting constructor
+
+			It builds the bspline with the minimal number of control points
+			which approximates the polyline through the points in _P within
+			the given tolerance. This is thought for dense polylines (for
+			instance centerlines of vessels with thousands of points), where
+			using all the points as control or interpolating points would
+			be too expensive. \n
+			The points are parametrized with the chord length. For a given
+			number of control points the knot vector is placed according to
+			the distribution of the parameters (so that each knot span contains
+			at least one point) and the control points are found solving a
+			least squares problem, constraining the first and the last control
+			point to be the first and the last point of the polyline. The
+			number of control points is then searched doubling it until the
+			tolerance is satisfied, and then bisecting the last interval.
+
+			@note	The error is an estimate of the Hausdorff distance between
+					the curve and the polyline: it is the maximum among the
+					distances of the points from the curve evaluated in their
+					parameter and the distances of the curve evaluated in the
+					middle of each piece of the polyline from that piece.
+			@note	If the tolerance is not reached even using as many control
+					points as given points, a warning is displayed and the
+					last fitted curve is kept.
+			@pre	At least deg+1 points are required.
+
+			@param _P The points of the polyline to be fitted
+			@param _tol The tolerance on the distance between the curve and the polyline
+		*/
+		bspline_geometry (vect_pts const& _P, T const& _tol){
+			this->fit_points(_P, _tol);
+		}
+
 		//! Copy constructor
 		bspline_geometry(bspline_geometry const&) = default;
 		
@@ -287,16 +335,16 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 			if(_type == BSP_type::Approx){
 				nc = _P.size();
 				k = make_knots(nc);
-				C = _P;
+				C = to_ctrl(_P);
 				
 				// construction of spline for the vector of first derivative
-				dC.resize (nc-1);
+				dC.assign (nc-1, Point::Zero());
 				dk.resize (k.size () - 2, 0.0);
 				bspderiv (deg, C, nc, k, k.size (), dC, dk);
 
 				// construction of spline for the vector of second derivative
 				d2k.resize (dk.size () - 2, 0.0);    
-				d2C.resize (nc-2);
+				d2C.assign (nc-2, Point::Zero());
 				bspderiv (deg-1, dC, (nc-1), dk, dk.size (), d2C, d2k);				
 			} else {	// _type == BSP_type::Interp
 				if(deg != 3){
@@ -313,8 +361,8 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 					
 					int span;
 					// Building vandermonde matrix to recover the control points
-					Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> V = 
-						Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>::Zero(nc,nc);
+					Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> V = 
+						Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>::Zero(nc,nc);
 					for(std::size_t i = 0; i < grev.size(); ++i){
 						vect N(deg+1);
 						span = findspan(nc-1, deg, grev[i], k);
@@ -326,28 +374,28 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 					}
 
 					// Building an Eigen matrix where to put the known term of the linear system
-					Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> PP(nc,dim);
+					Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> PP(nc,dim);
 					for(std::size_t i = 0; i < nc; ++i)
 						for(std::size_t j = 0; j < dim; ++j)
 							PP(i,j) = _P[i](j);
 					
 					// Solving the linear system V*CC = PP, where CC are the control points we have to find
-					Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> CC = V.lu().solve(PP);
+					Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> CC = V.lu().solve(PP);
 
 					// Copying the founded control points into the private attribute
-					C.resize(nc);
+					C.assign(nc, Point::Zero());
 					for(std::size_t i = 0; i < nc; ++i)
 						for(std::size_t j = 0; j < dim; ++j)
 							C[i](j) = CC(i,j);
 							
 					// construction of spline for the vector of first derivative
-					dC.resize (nc-1);
+					dC.assign (nc-1, Point::Zero());
 					dk.resize (k.size () - 2, 0.0);
 					bspderiv (deg, C, nc, k, k.size (), dC, dk);
 
 					// construction of spline for the vector of second derivative
 					d2k.resize (dk.size () - 2, 0.0);    
-					d2C.resize (nc-2);
+					d2C.assign (nc-2, Point::Zero());
 					bspderiv (deg-1, dC, (nc-1), dk, dk.size (), d2C, d2k);
 				}
 			}
@@ -363,17 +411,17 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 			if(_type == BSP_type::Approx){
 				nc = _C.size();
 				k = _k;
-				C = _C;
+				C = to_ctrl(_C);
 
 				// construction of spline for the vector of first derivative
-				dC.resize (nc-1);				
+				dC.assign (nc-1, Point::Zero());				
 				dk.resize (k.size () - 2, 0.0);
-				bspderiv (deg, C, dim, nc, k, k.size (), dC, dk);
+				bspderiv (deg, C, nc, k, k.size (), dC, dk);
 
 				// construction of spline for the vector of second derivative
 				d2k.resize (dk.size () - 2, 0.0);    
-				d2C.resize (nc-2);
-				bspderiv (deg-1, dC, dim, (nc-1), dk, dk.size (), d2C, d2k);
+				d2C.assign (nc-2, Point::Zero());
+				bspderiv (deg-1, dC, (nc-1), dk, dk.size (), d2C, d2k);
 			} else {	// _type == BSP_type::Approx
 				std::cerr << "ERROR! BGLgeom::bspline_geometry(): " << std::endl;
 				std::cerr << "\tinterpolating constructor with given knot vector not available!" << std::endl; 
@@ -383,8 +431,51 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 				exit(EXIT_FAILURE);
 			}
 		}
+
+		/*!
+			@brief	Setting bspline fitting the given polyline within a tolerance
+
+			Works exactly as explained in the fitting constructor documentation.
+		*/
+		void
+		set_bspline(vect_pts const& _P, T const& _tol){
+			this->fit_points(_P, _tol);
+		}
+
+		//! Setting bspline from points of another scalar type (converting them to T)
+		template <typename U>
+		void
+		set_bspline(std::vector<BGLgeom::point<dim,U>> const& _P, BSP_type const& _type){
+			this->set_bspline(convert_pts(_P), _type);
+		}
+
+		//! Setting bspline from control points and knots of another scalar type (converting them to T)
+		template <typename U>
+		void
+		set_bspline(std::vector<BGLgeom::point<dim,U>> const& _C, std::vector<U> const& _k, BSP_type const& _type = BSP_type::Approx){
+			this->set_bspline(convert_pts(_C), vect(_k.begin(), _k.end()), _type);
+		}
+
+		//! Fitting a polyline of points of another scalar type (converting them to T)
+		template <typename U>
+		void
+		set_bspline(std::vector<BGLgeom::point<dim,U>> const& _P, U const& _tol){
+			this->set_bspline(convert_pts(_P), static_cast<T>(_tol));
+		}
 		/*! @} */
-		
+
+		//! Number of control points of the bspline
+		unsigned int
+		get_num_control_points() const { return nc; }
+
+		//! Control points of the bspline
+		ctrl_pts const&
+		get_control_points() const { return C; }
+
+		//! Knot vector of the bspline
+		vect const&
+		get_knots() const { return k; }
+
 		/*! 
 			@brief Greville abscissae
 			
@@ -419,12 +510,12 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 		}
 		
 		//! Length of the curve
-		double length() { return this->curv_abs(1); }
-		double length() const { return this->curv_abs(1); }
+		T length() { return this->curv_abs(1); }
+		T length() const { return this->curv_abs(1); }
 		
 		//! Evaluation of the curve at a given value of the parameter
 		point 
-		operator() (double const& t) const {
+		operator() (T const& t) const {
 			point P = point::Zero();
 			bspeval (deg, C, nc, k, t, P);
 			return P;
@@ -433,14 +524,28 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 		//! Evaluation in a vector of parameters
 		vect_pts
 		operator() (vect const& t) const {
-			vect_pts PP(dim*t.size());
+			vect_pts PP;
 			bspeval (deg, C, nc, k, t, PP);
 			return PP;
 		};
 		
+		/*!
+			@brief	Evaluation in a vector of parameters into another type of points
+			
+			Same as operator(), but the points are of type Q stored with allocator
+			QAlloc: with padded_point (see point.hpp), and control points stored 
+			as padded_point, the evaluation is vectorized. It is used to build the
+			meshes with other types of points (see padded_mesh in mesh.hpp)
+		*/
+		template <typename Q, typename QAlloc>
+		void
+		evaluate (vect const& t, std::vector<Q,QAlloc> & P_vect) const {
+			bspeval (deg, C, nc, k, t, P_vect);
+		};
+		
 		//! Evaluation of the first derivative at a given value of the parameter
 		point 
-		first_der (double const& t) const {
+		first_der (T const& t) const {
 			point P = point::Zero();
 			bspeval (deg-1, dC, nc-1, dk, t, P);
 			return P;
@@ -456,7 +561,7 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 		
 		//! Evaluation of the second derivative at a given value of the parameter
 		point 
-		second_der (double const& t) const {
+		second_der (T const& t) const {
 			point P = point::Zero();
 			bspeval (deg-2, d2C, nc-2, d2k, t, P);
 			return P;
@@ -470,11 +575,11 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 			return PP;
 		};
 		
-		//! Evaluation of the curvilinear abscissa at a given value of the parameter
-		double
-		curv_abs (double const& t) const {
-			double retval =
-			    BGLgeom::integrate ([&] (double u) {return velocity (u);}, 0, t);
+		//! Evaluation of the curvilinear abscissa at a given value of the parameter (the quadrature is in double)
+		T
+		curv_abs (T const& t) const {
+			T retval = static_cast<T>(
+			    BGLgeom::integrate ([&] (double u) {return static_cast<double>(velocity (static_cast<T>(u)));}, 0, t));
 			return retval;
 		};
 		
@@ -483,20 +588,20 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 		curv_abs (vect const& t) const {
 			vect retval (t.size (), .0);
 			for (std::size_t ii = 1; ii < t.size (); ++ii)
-			    retval[ii] = retval[ii-1] +
-			    BGLgeom::integrate ([&] (double u) {return velocity (u);}, t[ii-1], t[ii]);
+			    retval[ii] = retval[ii-1] + static_cast<T>(
+			    BGLgeom::integrate ([&] (double u) {return static_cast<double>(velocity (static_cast<T>(u)));}, t[ii-1], t[ii]));
 			return retval;
 		};
 		
 		//! Evaluation of the curvature at a given value of the parameter
-		double
-		curvature(double const& t) const {
-			if( (this->first_der(t)).norm() < tol_dist )
+		T
+		curvature(T const& t) const {
+			if( (this->first_der(t)).norm() < BGLgeom::tolerance<T>::dist() )
 				return 0; // otherwise at the denominator I will have zero or very close to it
-			double numerator;
+			T numerator;
 			if(dim == 3){
 				// explicit computation of the determinant
-				Eigen::Matrix<double,1,3> tmp( (this->first_der(t)(0,0) * this->second_der(t)(0,1) -
+				Eigen::Matrix<T,1,3> tmp( (this->first_der(t)(0,0) * this->second_der(t)(0,1) -
 							 					this->first_der(t)(0,1) * this->second_der(t)(0,0)),
 							 				   (this->first_der(t)(0,2) * this->second_der(t)(0,0) -
 							 					this->first_der(t)(0,0) * this->second_der(t)(0,2)),
@@ -507,7 +612,7 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 				numerator = std::abs(this->first_der(t)(0,0) * this->second_der(t)(0,1) - 
 							 		 this->first_der(t)(0,1) * this->second_der(t)(0,0));
 			}
-			double denominator( ((this->first_der(t)).norm()) *
+			T denominator( ((this->first_der(t)).norm()) *
 								((this->first_der(t)).norm()) *
 								((this->first_der(t)).norm()) );
 			return numerator/denominator;
@@ -527,7 +632,7 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 			
 			It only tells the coordinates of its extremes. May be useful for debugging
 		*/
-		friend std::ostream & operator<<(std::ostream & out, bspline_geometry<dim,deg> const& edge) {
+		friend std::ostream & operator<<(std::ostream & out, bspline_geometry const& edge) {
 			out << "(bspline)\tSource: " << edge(0) << ", Target: " << edge(1);
 			return out;
 		}
@@ -538,15 +643,34 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 		//! Knot vector
 		vect k;
 		//! Vector of the control points
-		vect_pts C;
+		ctrl_pts C;
 		//! Knot vectors of the first and second derivatives
 		vect dk, d2k;
 		//! Vectors of the control points of the first and second derivatives
-		vect_pts dC, d2C;
+		ctrl_pts dC, d2C;
 		
+		//! Converts points to the stored control points
+		static ctrl_pts
+		to_ctrl (vect_pts const& P) {
+			ctrl_pts retval(P.size());
+			for(std::size_t i = 0; i < P.size(); ++i)
+				retval[i] = BGLgeom::convert_point<Point,dim>(P[i]);
+			return retval;
+		}
+
+		//! Converts points of another scalar type to T
+		template <typename U>
+		static vect_pts
+		convert_pts (std::vector<BGLgeom::point<dim,U>> const& P) {
+			vect_pts retval(P.size());
+			for(std::size_t i = 0; i < P.size(); ++i)
+				retval[i] = P[i].template cast<T>();
+			return retval;
+		}
+
 		//! Norm of the first derivative (to compute curvilinear abscissa)
-		double
-		velocity (double x) const {
+		T
+		velocity (T x) const {
 			point tmp = point::Zero();
 			bspeval (deg-1, dC, (nc-1), dk, x, tmp);
 			return tmp.norm();
@@ -564,7 +688,7 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 			assert (nint >= 0);
 
 			if (nint > 0){
-			    double Dk = 1. / (nint + 1);
+			    T Dk = T(1) / (nint + 1);
 			    for (int ii = 0; ii < nint; ++ii)
 			        retval.push_back (retval.back () + Dk);
 			}
@@ -574,7 +698,183 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 
 			return retval;
 		};
-		
+
+		/*!
+			@brief	Fits the given polyline with the minimal number of control points
+
+			See the documentation of the fitting constructor. At the end the
+			bspline for the first and the second derivatives are built, as in
+			the other constructors.
+
+			@param _P The points of the polyline
+			@param tol The tolerance on the distance between curve and polyline
+		*/
+		void
+		fit_points (vect_pts const& _P, T const& tol) {
+			// Discarding coincident consecutive points, they would give coincident parameters
+			vect_pts P;
+			P.reserve(_P.size());
+			for(std::size_t i = 0; i < _P.size(); ++i)
+				if(P.empty() || (_P[i]-P.back()).norm() > BGLgeom::tolerance<T>::dist())
+					P.push_back(_P[i]);
+			const int np = P.size();
+			if(np < deg+1){
+				std::cerr << "ERROR! BGLgeom::bspline_geometry(): " << std::endl;
+				std::cerr << "\tat least " << deg+1 << " distinct points are needed to fit "
+						  << "a bspline of degree " << deg << std::endl;
+				std::cerr << "Aborting" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+
+			// Chord length parametrization of the points
+			vect ubar(np, 0.0);
+			for(int i = 1; i < np; ++i)
+				ubar[i] = ubar[i-1] + (P[i]-P[i-1]).norm();
+			for(int i = 1; i < np-1; ++i)
+				ubar[i] /= ubar.back();
+			ubar.back() = 1.0;
+
+			// Doubling the number of control points until the tolerance is satisfied
+			int n_lo = deg;		// less than deg+1 control points are never admissible
+			int n_hi = deg+1;
+			vect_pts C_fit;
+			T err = lsq_fit(P, ubar, n_hi, C_fit, k);
+			while(err > tol && n_hi < np){
+				n_lo = n_hi;
+				n_hi = std::min(2*n_hi, np);
+				err = lsq_fit(P, ubar, n_hi, C_fit, k);
+			}
+			if(err > tol){
+				std::cerr << "WARNING! BGLgeom::bspline_geometry(): tolerance " << tol
+						  << " not reached fitting the points. Error: " << err << std::endl;
+			} else {
+				// Bisecting to find the minimal number of control points
+				vect_pts C_tmp;
+				vect k_tmp;
+				while(n_hi - n_lo > 1){
+					int n_mid = (n_lo + n_hi) / 2;
+					if(lsq_fit(P, ubar, n_mid, C_tmp, k_tmp) <= tol){
+						n_hi = n_mid;
+						std::swap(C_fit, C_tmp);
+						std::swap(k, k_tmp);
+					} else
+						n_lo = n_mid;
+				}
+			}
+			nc = n_hi;
+			C = to_ctrl(C_fit);
+
+			// construction of spline for the vector of first derivative
+			dC.assign (nc-1, Point::Zero());
+			dk.resize (k.size () - 2, 0.0);
+			bspderiv (deg, C, nc, k, k.size (), dC, dk);
+
+			// construction of spline for the vector of second derivative
+			d2k.resize (dk.size () - 2, 0.0);
+			d2C.assign (nc-2, Point::Zero());
+			bspderiv (deg-1, dC, (nc-1), dk, dk.size (), d2C, d2k);
+		}	//fit_points
+
+		/*!
+			@brief	Least squares fitting with a given number of control points
+
+			The knot vector is placed following 'The NURBS Book', eq. 9.69
+			(eq. 9.8 if there are as many control points as points), and the
+			least squares problem, with first and last control points fixed,
+			is solved as in Algorithm A9.7. The normal matrix is banded, so
+			it is assembled and factorized as a sparse matrix.
+
+			@param P (Input) The points to be fitted
+			@param ubar (Input) The parameters associated to the points
+			@param n (Input) Number of control points
+			@param C_fit (Output) The control points
+			@param k_fit (Output) The knot vector
+			@return The estimate of the Hausdorff distance between curve and polyline
+		*/
+		T
+		lsq_fit (vect_pts const& P, vect const& ubar, int const& n,
+				 vect_pts & C_fit, vect & k_fit) const {
+			const int np = P.size();
+
+			// Knot vector
+			k_fit.assign(deg+1, 0.0);
+			if(n == np){
+				for(int j = 1; j < n-deg; ++j){
+					T sum = 0;
+					for(int i = j; i < j+deg; ++i)
+						sum += ubar[i];
+					k_fit.push_back(sum / deg);
+				}
+			} else {
+				const double d = static_cast<double>(np) / (n-deg);
+				for(int j = 1; j < n-deg; ++j){
+					const int i = static_cast<int>(j*d);
+					const double alpha = j*d - i;
+					k_fit.push_back((1.0-alpha)*ubar[i-1] + alpha*ubar[i]);
+				}
+			}
+			k_fit.insert(k_fit.end(), deg+1, 1.0);
+
+			// Control points: the first and the last ones are fixed
+			C_fit.assign(n, point::Zero());
+			C_fit.front() = P.front();
+			C_fit.back() = P.back();
+			if(n > 2){
+				std::vector<Eigen::Triplet<T>> triplets;
+				triplets.reserve((np-2)*(deg+1));
+				Eigen::Matrix<T, Eigen::Dynamic, dim> R(np-2, dim);
+				vect N(deg+1);
+				for(int r = 1; r < np-1; ++r){
+					int span = findspan(n-1, deg, ubar[r], k_fit);
+					basisfun(span, ubar[r], deg, k_fit, N);
+					point Rk = P[r];
+					for(int ii = 0; ii <= deg; ++ii){
+						const int col = span-deg+ii;
+						if(col == 0)
+							Rk -= N[ii] * P.front();
+						else if(col == n-1)
+							Rk -= N[ii] * P.back();
+						else
+							triplets.push_back(Eigen::Triplet<T>(r-1, col-1, N[ii]));
+					}
+					R.row(r-1) = Rk;
+				}
+				Eigen::SparseMatrix<T> A(np-2, n-2);
+				A.setFromTriplets(triplets.begin(), triplets.end());
+				Eigen::SparseMatrix<T> AtA = A.transpose() * A;
+				Eigen::SimplicialLDLT<Eigen::SparseMatrix<T>> solver(AtA);
+				if(solver.info() != Eigen::Success)
+					return std::numeric_limits<T>::infinity();
+				Eigen::Matrix<T, Eigen::Dynamic, dim> CC = solver.solve(A.transpose() * R);
+				for(int i = 0; i < n-2; ++i)
+					C_fit[i+1] = CC.row(i);
+			}
+
+			// Estimate of the Hausdorff distance
+			T err = 0;
+			point Pt;
+			for(int r = 0; r < np; ++r){
+				Pt = point::Zero();
+				bspeval (deg, C_fit, n, k_fit, ubar[r], Pt);
+				err = std::max(err, (Pt-P[r]).norm());
+				if(r < np-1){
+					Pt = point::Zero();
+					bspeval (deg, C_fit, n, k_fit, (ubar[r]+ubar[r+1])/2, Pt);
+					err = std::max(err, dist_from_segment(Pt, P[r], P[r+1]));
+				}
+			}
+			return err;
+		}	//lsq_fit
+
+		//! Distance of point Pt from the segment from A to B
+		static T
+		dist_from_segment (point const& Pt, point const& A, point const& B) {
+			const point AB = B-A;
+			T t = (Pt-A).dot(AB) / AB.squaredNorm();
+			t = std::max(T(0), std::min(T(1), t));
+			return (Pt - (A + t*AB)).norm();
+		}
+
 		/*!
 			@brief Compute the first derivative of the curve as a bspline
 			
@@ -586,14 +886,13 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 			@param dk (Output) Knot sequence of the derivative ((nk-1) x 1 vector) (output)
 		*/
 		void
-		bspderiv (int d, const vect_pts &C, int nc,
-		          const vect &k, int nk, vect_pts &dC, vect &dk) const {
-			int i, j;
-			double tmp;
+		bspderiv (int d, const ctrl_pts &C, int nc,
+		          const vect &k, int nk, ctrl_pts &dC, vect &dk) const {
+			int i;
+			T tmp;
 			for (i = 0; i < nc-1; i++){
 			    tmp = d / (k[i+d+1] - k[i+1]);
-			    for (j = 0; j < dim; j++)
-			    	dC[i](j) = tmp * (C[i+1](j) - C[i](j));
+			    dC[i] = tmp * (C[i+1] - C[i]);
 			}
 			for (i = 1; i < nk-1; i++)
 				dk[i-1] = k[i];
@@ -609,9 +908,10 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 			@param t (Input) Parametric evaluation point
 			@param P (Output) Evaluated point (output)
 		*/
+		template <typename Pts>
 		void
-		bspeval (const int d, const vect_pts &C, const int nc,
-		         const vect &k, double t, point &P) const {
+		bspeval (const int d, const Pts &C, const int nc,
+		         const vect &k, T t, point &P) const {
 			int s, tmp1, ii, i;
 			vect N (d+1, 0.0);
 			s = findspan (nc-1, d, t, k);
@@ -630,23 +930,26 @@ bspline_geometry : public BGLgeom::edge_geometry<dim> {
 			@param nc (Input) Number of control points
 			@param k (Input) Knot sequence (nk x 1 vector)
 			@param t (Input) Vector of parametric evaluation point
-			@param P (Output) Vector of evaluated point (output)
+			@param P (Output) Vector of evaluated point (output), of any type of points:
+					 the sum is done on the stored control points and then converted
 		*/
+		template <typename Q, typename QAlloc>
 		void
-		bspeval (const int d, const vect_pts &C, const int nc,
-		         const vect &k, const vect &t, vect_pts & P_vect) const {
-			int s, tmp1, ii, i_pt;
+		bspeval (const int d, const ctrl_pts &C, const int nc,
+		         const vect &k, const vect &t, std::vector<Q,QAlloc> & P_vect) const {
+			int s, tmp1, ii;
 			vect N (d+1, 0.0);
 			auto nt = t.size ();
-			P_vect.resize(nt); //reserve nu places in the output vector
+			Point P;
+			P_vect.resize(nt);
 			for (std::size_t i_vect = 0; i_vect < nt; ++i_vect){
 			    s = findspan (nc-1, d, t[i_vect], k);
 			    basisfun (s, t[i_vect], d, k, N);
-			    tmp1 = s - d;			    			    			
-			    for (i_pt = 0; i_pt < dim; ++i_pt){
-			    	for (ii = 0; ii <= d; ++ii)
-			        	P_vect[i_vect](i_pt) += N[ii] * C[tmp1 + ii](i_pt);
-			    }
+			    tmp1 = s - d;
+			    P = Point::Zero();
+			    for (ii = 0; ii <= d; ++ii)
+			        P += N[ii] * C[tmp1 + ii];
+			    P_vect[i_vect] = BGLgeom::convert_point<Q,dim>(P);
 			}	//for
 		}	//bspeval
 
@@ -0,0 +1,268 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	bulk_builder.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Functions to build a graph at once from lists of vertices and edges
+
+	The functions in graph_builder.hpp add one vertex or one edge at a time.
+	When a whole network is already available as a list of coordinates
+	and a list of pairs of vertex indices, these functions build the graph
+	in one pass: storage for vertices and adjacency lists is reserved in
+	advance, coincident vertices are optionally welded through a spatial
+	hash, and the geometry of each edge is set up right after its insertion.
+*/
+
+#ifndef HH_BULK_BUILDER_HH
+#define HH_BULK_BUILDER_HH
+
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <cmath>
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include "point.hpp"
+#include "graph_access.hpp"
+#include "vertex_hash.hpp"
+
+namespace BGLgeom{
+
+namespace bulk_detail{
+
+/*!
+	@brief	Cell size for the spatial hash used to weld the vertices
+
+	It is chosen so that there are about as many cells as points in the
+	bounding box of the points
+*/
+template <unsigned int dim>
+double
+weld_cell_size(std::vector<BGLgeom::point<dim>> const& coords){
+	if(coords.empty())
+		return 1.0;
+	BGLgeom::point<dim> lo = coords.front(), hi = coords.front();
+	for(BGLgeom::point<dim> const& P : coords){
+		lo = lo.cwiseMin(P);
+		hi = hi.cwiseMax(P);
+	}
+	double extent = (hi - lo).maxCoeff();
+	return extent / std::pow(static_cast<double>(coords.size()), 1.0/dim);
+}
+
+}	//bulk_detail
+
+//! Type for the list of edges: each edge is the pair of the indices of its extremes
+using edge_list_t = std::vector<std::pair<std::size_t, std::size_t>>;
+
+/*!
+	@brief	Builds the graph from a list of points and a list of edges
+
+	The vertices are created with the given coordinates (their other
+	properties are defaulted), then the edges are added, and for each of
+	them the functor setup is called to set up its properties (in
+	particular its geometry). If weld is true, points with the same
+	coordinates (closer than TOL), also with the vertices already in
+	the graph, are merged into the same vertex, and the edges whose
+	extremes are merged (that would become loops) are not inserted.
+	Without weld all the edges are inserted, including the loops given
+	in the list.
+
+	@pre	The graph must use boost::vecS as container for the vertices, and
+			its vertex property must be constructible from the coordinates
+			(as BGLgeom::Vertex_base_property)
+	@remark	As for the functions in graph_builder.hpp, the dimension cannot be
+			deduced from the type of the points, so the template parameters 
+			have to be given explicitly, e.g. bulk_build_linear<Graph,2>(...)
+	@remark	It does not print anything for each vertex or edge, also in debug mode
+
+	@param coords The coordinates of the vertices
+	@param edges The edges, as pairs of indices in coords
+	@param setup Functor called as setup(G, e, i) after the insertion of
+				 the i-th edge of the list, with edge descriptor e
+	@param G The graph where to insert vertices and edges
+	@param weld If true, coincident points are merged into one vertex
+	@return The vertex descriptor corresponding to each point of coords
+*/
+template <typename Graph, unsigned int dim, typename Edge_setup>
+std::vector<BGLgeom::Vertex_desc<Graph>>
+bulk_build(std::vector<BGLgeom::point<dim>> const& coords,
+		   BGLgeom::edge_list_t const& edges,
+		   Edge_setup const& setup,
+		   Graph & G,
+		   bool const& weld = false){
+
+	using Vertex_prop = typename boost::vertex_bundle_type<Graph>::type;
+	const std::size_t n_old = boost::num_vertices(G);
+	std::vector<BGLgeom::Vertex_desc<Graph>> vmap(coords.size());
+
+	// Vertices: the new ones are numbered after the ones already in the graph
+	std::vector<std::size_t> new_pts;
+	new_pts.reserve(coords.size());
+	if(weld){
+		BGLgeom::vertex_hash<dim> H(bulk_detail::weld_cell_size<dim>(coords));
+		if(n_old > 0)
+			H.build(G);
+		std::size_t v;
+		for(std::size_t i = 0; i < coords.size(); ++i){
+			if(H.find(coords[i], v)){
+				vmap[i] = v;
+			} else {
+				vmap[i] = n_old + new_pts.size();
+				H.insert(vmap[i], coords[i]);
+				new_pts.push_back(i);
+			}
+		}
+	} else {
+		for(std::size_t i = 0; i < coords.size(); ++i){
+			vmap[i] = n_old + i;
+			new_pts.push_back(i);
+		}
+	}
+	BGLgeom::reserve_vertices(G, n_old + new_pts.size());
+	for(std::size_t i : new_pts)
+		BGLgeom::vertex_added(G, boost::add_vertex(Vertex_prop(coords[i]), G));
+
+	// Reserving the adjacency lists
+	std::vector<std::size_t> degree(boost::num_vertices(G), 0);
+	for(auto const& E : edges){
+		++degree[vmap[E.first]];
+		++degree[vmap[E.second]];
+	}
+	BGLgeom::reserve_out_edges(G, degree);
+
+	// Edges
+	std::size_t n_loops = 0;
+	for(std::size_t i = 0; i < edges.size(); ++i){
+		BGLgeom::Vertex_desc<Graph> src = vmap[edges[i].first];
+		BGLgeom::Vertex_desc<Graph> tgt = vmap[edges[i].second];
+		if(weld && src == tgt){
+			++n_loops;
+			continue;
+		}
+		BGLgeom::Edge_desc<Graph> e = boost::add_edge(src, tgt, G).first;
+		setup(G, e, i);
+	}
+
+	#ifndef NDEBUG
+		std::cout << "Bulk build: " << new_pts.size() << " new vertices ("
+				  << coords.size() - new_pts.size() << " welded), "
+				  << edges.size() - n_loops << " new edges";
+		if(n_loops > 0)
+			std::cout << " (" << n_loops << " loops discarded)";
+		std::cout << std::endl;
+	#endif
+	return vmap;
+}	//bulk_build
+
+/*!
+	@brief	Builds a graph with linear edges from a list of points and a list of edges
+
+	@remark	Use this only when you set "linear_geometry<dim>" as template parameter of the
+			Edge_base_property
+
+	The geometry of each edge is set up with the coordinates of its
+	extremes, the other edge properties are defaulted.
+
+	@param coords The coordinates of the vertices
+	@param edges The edges, as pairs of indices in coords
+	@param G The graph where to insert vertices and edges
+	@param weld If true, coincident points are merged into one vertex
+	@return The vertex descriptor corresponding to each point of coords
+*/
+template <typename Graph, unsigned int dim>
+std::vector<BGLgeom::Vertex_desc<Graph>>
+bulk_build_linear(std::vector<BGLgeom::point<dim>> const& coords,
+				  BGLgeom::edge_list_t const& edges,
+				  Graph & G,
+				  bool const& weld = false){
+	auto setup = [](Graph & G, BGLgeom::Edge_desc<Graph> const& e, std::size_t const&){
+		G[e].geometry.set_source(G[boost::source(e,G)].coordinates);
+		G[e].geometry.set_target(G[boost::target(e,G)].coordinates);
+	};
+	return bulk_build<Graph,dim>(coords, edges, setup, G, weld);
+}	//bulk_build_linear
+
+/*!
+	@brief	Builds a graph with linear edges, assigning the edge properties
+
+	@remark	Use this only when you set "linear_geometry<dim>" as template parameter of the
+			Edge_base_property
+
+	Each edge gets the corresponding properties in E_props, and then its
+	geometry is set up with the coordinates of its extremes.
+
+	@param coords The coordinates of the vertices
+	@param edges The edges, as pairs of indices in coords
+	@param E_props The properties of the edges (same size of edges)
+	@param G The graph where to insert vertices and edges
+	@param weld If true, coincident points are merged into one vertex
+	@return The vertex descriptor corresponding to each point of coords
+*/
+template <typename Graph, typename Edge_prop, unsigned int dim>
+std::vector<BGLgeom::Vertex_desc<Graph>>
+bulk_build_linear(std::vector<BGLgeom::point<dim>> const& coords,
+				  BGLgeom::edge_list_t const& edges,
+				  std::vector<Edge_prop> const& E_props,
+				  Graph & G,
+				  bool const& weld = false){
+	auto setup = [&E_props](Graph & G, BGLgeom::Edge_desc<Graph> const& e, std::size_t const& i){
+		G[e] = E_props[i];
+		G[e].geometry.set_source(G[boost::source(e,G)].coordinates);
+		G[e].geometry.set_target(G[boost::target(e,G)].coordinates);
+	};
+	return bulk_build<Graph,dim>(coords, edges, setup, G, weld);
+}	//bulk_build_linear (with properties)
+
+/*!
+	@brief	Builds a graph with polyline edges from a list of points and a list of edges
+
+	@remark	Use this only when you set "polyline_geometry<dim>" as template parameter of the
+			Edge_base_property
+
+	@param coords The coordinates of the vertices
+	@param edges The edges, as pairs of indices in coords
+	@param polylines The points of the polyline of each edge (same size of edges),
+					 from the source to the target
+	@param G The graph where to insert vertices and edges
+	@param weld If true, coincident points are merged into one vertex
+	@return The vertex descriptor corresponding to each point of coords
+*/
+template <typename Graph, unsigned int dim>
+std::vector<BGLgeom::Vertex_desc<Graph>>
+bulk_build_polyline(std::vector<BGLgeom::point<dim>> const& coords,
+					BGLgeom::edge_list_t const& edges,
+					std::vector<std::vector<BGLgeom::point<dim>>> const& polylines,
+					Graph & G,
+					bool const& weld = false){
+	auto setup = [&polylines](Graph & G, BGLgeom::Edge_desc<Graph> const& e, std::size_t const& i){
+		G[e].geometry.set_points(polylines[i]);
+	};
+	return bulk_build<Graph,dim>(coords, edges, setup, G, weld);
+}	//bulk_build_polyline
+
+}	//BGLgeom
+
+#endif	//HH_BULK_BUILDER_HH
@@ -0,0 +1,256 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	cluster_tracker.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Connected components of a graph, kept updated while it is built
+*/
+
+#ifndef HH_CLUSTER_TRACKER_HH
+#define HH_CLUSTER_TRACKER_HH
+
+#include <vector>
+#include <array>
+#include <utility>
+#include <boost/graph/adjacency_list.hpp>
+#include "point.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	Connected components (clusters) of a graph, with union-find
+
+	Each vertex points to a parent vertex of the same cluster, up to the
+	root, which represents the cluster: adding an edge joins the clusters
+	of its extremes, hanging the smaller tree to the root of the larger
+	one, and the paths are halved each time they are followed. So any
+	query costs O(alpha(n)) (practically constant) while the graph grows,
+	without visiting it. The root of each cluster also stores its number
+	of vertices and edges, the total length of its edges and its bounding
+	box, and the tracker keeps the cluster with the largest extent along
+	each direction: a network percolates between two opposite sides of
+	the domain if this cluster reaches both of them.
+
+	@note	The tracker has to be kept updated when the graph changes: the
+			functions new_vertex(), new_linear_edge() and remove_edge() in
+			graph_builder.hpp taking a cluster_tracker as argument do this.
+			Union-find cannot split a cluster: an edge can be removed only
+			if its extremes stay connected (as when an edge is cut in two
+			pieces, or replaced by the pieces of an overlapping one). The
+			vertices cannot be removed; after a renumbering the tracker has
+			to be rebuilt with build()
+	@pre	The vertex descriptors have to be indices, i.e. the graph must use
+			boost::vecS as container for the vertices
+
+	@param dim Dimension of the space
+*/
+template <unsigned int dim>
+class cluster_tracker {
+
+	public:
+		using point = BGLgeom::point<dim>;
+
+		//! Summary of a cluster
+		struct cluster_summary {
+			//! Number of vertices
+			std::size_t n_vertices;
+			//! Number of edges
+			std::size_t n_edges;
+			//! Total length of the edges
+			double length;
+			//! Bounding box of the vertices
+			point lo, hi;
+		};	//cluster_summary
+
+		//! Constructor: no vertices
+		cluster_tracker() : parent(), summary(), n_clusters(0), n_edges(0), widest() {};
+
+		//! Number of vertices
+		std::size_t num_vertices() const { return parent.size(); }
+
+		//! Number of edges
+		std::size_t num_edges() const { return n_edges; }
+
+		//! Number of clusters (an isolated vertex is a cluster)
+		std::size_t num_clusters() const { return n_clusters; }
+
+		//! Removes all the vertices
+		void
+		clear(){
+			parent.clear();
+			summary.clear();
+			n_clusters = 0;
+			n_edges = 0;
+		}
+
+		/*!
+			@brief	(Re)builds the tracker from all the vertices and edges of a graph
+
+			@param G The graph: the vertex property contains the coordinates,
+					 the edge property a linear geometry
+		*/
+		template <typename Graph>
+		void
+		build(Graph const& G){
+			this->clear();
+			parent.reserve(boost::num_vertices(G));
+			summary.reserve(boost::num_vertices(G));
+			for(std::size_t v = 0; v < boost::num_vertices(G); ++v)
+				this->add_vertex(v, G[v].coordinates);
+			typename boost::graph_traits<Graph>::edge_iterator e_it, e_end;
+			for(std::tie(e_it, e_end) = boost::edges(G); e_it != e_end; ++e_it)
+				this->add_edge(boost::source(*e_it, G), boost::target(*e_it, G),
+							   G[*e_it].geometry.get_source(), G[*e_it].geometry.get_target());
+		}
+
+		/*!
+			@brief	Adds the vertex v, with coordinates P, as a new cluster
+
+			@pre	v == num_vertices(), as for a new vertex in a graph with
+					boost::vecS as container for the vertices
+		*/
+		void
+		add_vertex(std::size_t const& v, point const& P){
+			parent.push_back(v);
+			summary.push_back(cluster_summary{1, 0, 0.0, P, P});
+			++n_clusters;
+			if(v == 0)
+				widest.fill(0);
+		}
+
+		//! Adds the edge from u to v, with extremes P1 and P2, joining their clusters
+		void
+		add_edge(std::size_t const& u, std::size_t const& v, point const& P1, point const& P2){
+			std::size_t r = this->join(u, v);
+			++summary[r].n_edges;
+			summary[r].length += (P2 - P1).norm();
+			++n_edges;
+		}
+
+		/*!
+			@brief	Removes the edge from u to v, with extremes P1 and P2
+
+			@pre	u and v have to stay connected by the other edges of the graph
+		*/
+		void
+		remove_edge(std::size_t const& u, std::size_t const& v, point const& P1, point const& P2){
+			std::size_t r = this->find(u);
+			--summary[r].n_edges;
+			summary[r].length -= (P2 - P1).norm();
+			--n_edges;
+		}
+
+		//! The root of the cluster of v (the same for all the vertices of the cluster)
+		std::size_t
+		find(std::size_t v){
+			while(parent[v] != v){
+				parent[v] = parent[parent[v]];
+				v = parent[v];
+			}
+			return v;
+		}
+
+		//! True if u and v are in the same cluster
+		bool connected(std::size_t const& u, std::size_t const& v) { return this->find(u) == this->find(v); }
+
+		//! Summary of the cluster of v
+		cluster_summary const& cluster(std::size_t const& v) { return summary[this->find(v)]; }
+
+		//! Root of the cluster with the largest extent along the direction j
+		std::size_t widest_cluster(std::size_t const& j) const { return widest[j]; }
+
+		/*!
+			@brief	True if a cluster connects the sides x_j = a and x_j = b
+					of the domain
+
+			The cluster with the largest extent along the direction j is
+			checked, so the cost is constant
+
+			@pre	All the vertices have to be in the domain, i.e. a <= x_j <= b
+			@param j The direction
+			@param a,b The coordinates of the two sides
+			@param tol The distance from a side under which a vertex is on it
+		*/
+		bool
+		percolates(std::size_t const& j, double const& a, double const& b, double const& tol = TOL) const {
+			if(parent.empty())
+				return false;
+			cluster_summary const& S = summary[widest[j]];
+			return S.lo(j) <= a + tol && S.hi(j) >= b - tol;
+		}
+
+		//! Calls f(root, summary) on each cluster
+		template <typename F>
+		void
+		for_each_cluster(F const& f) const {
+			for(std::size_t v = 0; v < parent.size(); ++v)
+				if(parent[v] == v)
+					f(v, summary[v]);
+		}
+
+	private:
+		//! Parent of each vertex (itself for the roots)
+		std::vector<std::size_t> parent;
+		//! Summary of the clusters (meaningful only for the roots)
+		std::vector<cluster_summary> summary;
+		//! Number of clusters
+		std::size_t n_clusters;
+		//! Number of edges
+		std::size_t n_edges;
+		//! Root of the cluster with the largest extent along each direction
+		std::array<std::size_t,dim> widest;
+
+		//! Joins the clusters of u and v, returning the root of the result
+		std::size_t
+		join(std::size_t const& u, std::size_t const& v){
+			std::size_t ru = this->find(u), rv = this->find(v);
+			if(ru == rv)
+				return ru;
+			if(summary[ru].n_vertices < summary[rv].n_vertices)
+				std::swap(ru, rv);
+			parent[rv] = ru;
+			cluster_summary & S = summary[ru];
+			cluster_summary const& T = summary[rv];
+			S.n_vertices += T.n_vertices;
+			S.n_edges += T.n_edges;
+			S.length += T.length;
+			S.lo = S.lo.cwiseMin(T.lo);
+			S.hi = S.hi.cwiseMax(T.hi);
+			--n_clusters;
+			// The extents only grow: the joined cluster is the widest if it
+			// is not narrower than the widest one (which may be ru or rv)
+			for(std::size_t j = 0; j < dim; ++j){
+				cluster_summary const& W = summary[widest[j]];
+				if(widest[j] == rv || S.hi(j) - S.lo(j) >= W.hi(j) - W.lo(j))
+					widest[j] = ru;
+			}
+			return ru;
+		}
+
+};	//cluster_tracker
+
+}	//BGLgeom
+
+#endif	//HH_CLUSTER_TRACKER_HH
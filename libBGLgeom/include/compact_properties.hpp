@@ -0,0 +1,591 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	compact_properties.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Memory saving versions of the base properties
+
+	The base properties in base_properties.hpp store in each vertex a
+	std::string for the label and the array of the boundary conditions,
+	and in each edge a std::string and a mesh, even if in large networks
+	almost all the vertices and edges have none of them.
+	The properties defined here have the same members, used in the same
+	way, but the labels are interned (see interned_label.hpp) and the
+	boundary conditions and the meshes are allocated only for the vertices
+	and the edges that have them.
+*/
+
+#ifndef HH_COMPACT_PROPERTIES_HH
+#define HH_COMPACT_PROPERTIES_HH
+
+#include <iostream>
+#include <array>
+#include <memory>
+#include <string>
+#include <initializer_list>
+#include <vector>
+#include <functional>
+#include "point.hpp"
+#include "mesh.hpp"
+#include "boundary_conditions.hpp"
+#include "interned_label.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	Boundary conditions of a vertex, stored only if present
+
+	It behaves as the std::array of boundary conditions of
+	Vertex_base_property: BC[i] gives the i-th boundary condition, and
+	size() is always num_bc. As long as no boundary condition is set, it
+	only contains a null pointer; the array is allocated at the first
+	access to a boundary condition through a non-const reference.
+
+	@note	Reading a boundary condition through a non-const reference (as
+			G[v].BC[i] with G non-const) allocates the array: to read the
+			conditions without allocating them use get() or a const reference
+			(as the writers do)
+
+	@param num_bc Number of boundary conditions
+*/
+template <unsigned int num_bc>
+class sparse_bc{
+	public:
+		using bc_t = BGLgeom::boundary_condition;
+		using array_t = std::array<bc_t, num_bc>;
+
+		//! Default constructor: no boundary conditions
+		sparse_bc() : BC() {};
+
+		//! Constructor from an array of boundary conditions
+		sparse_bc(array_t const& _BC) : BC(new array_t(_BC)) {};
+
+		//! Copy constructor
+		sparse_bc(sparse_bc const& other) : BC(other.BC ? new array_t(*other.BC) : nullptr) {};
+
+		//! Move constructor
+		sparse_bc(sparse_bc &&) = default;
+
+		//! Assignment operator
+		sparse_bc &
+		operator=(sparse_bc const& other){
+			if(this != &other)
+				BC.reset(other.BC ? new array_t(*other.BC) : nullptr);
+			return *this;
+		}
+
+		//! Move assignment
+		sparse_bc & operator=(sparse_bc &&) = default;
+
+		//! Assignment from an array of boundary conditions
+		sparse_bc &
+		operator=(array_t const& _BC){
+			BC.reset(new array_t(_BC));
+			return *this;
+		}
+
+		//! Number of boundary conditions
+		constexpr std::size_t size() const { return num_bc; }
+
+		//! True if no boundary condition has been set
+		bool empty() const { return !BC; }
+
+		//! The i-th boundary condition (BC_type::NONE if not set)
+		bc_t const&
+		get(std::size_t const& i) const { return BC ? (*BC)[i] : none(); }
+
+		//! The i-th boundary condition (read only)
+		bc_t const& operator[](std::size_t const& i) const { return this->get(i); }
+
+		//! The i-th boundary condition: it allocates the array if it is not present
+		bc_t &
+		operator[](std::size_t const& i){
+			if(!BC)
+				BC.reset(new array_t());
+			return (*BC)[i];
+		}
+
+		//! Sets the i-th boundary condition, without allocating if it is a default one
+		void
+		set(std::size_t const& i, bc_t const& bc){
+			if(BC || bc.type != BGLgeom::BC_type::NONE || bc.value != 0.0)
+				(*this)[i] = bc;
+		}
+
+		//! Removes all the boundary conditions
+		void
+		clear() { BC.reset(); }
+
+		//! Memory allocated for the boundary conditions
+		std::size_t bytes() const { return BC ? sizeof(array_t) : 0; }
+
+	private:
+		//! The boundary conditions, if present
+		std::unique_ptr<array_t> BC;
+
+		//! The default boundary condition
+		static bc_t const&
+		none(){
+			static const bc_t bc;
+			return bc;
+		}
+};	//sparse_bc
+
+/*!
+	@brief	Compact data structure for the vertex properties
+
+	It has the same members and constructors of Vertex_base_property, and
+	it can be used in its place, but:
+	- the label is an interned_label (4 bytes instead of a std::string); \n
+	- the boundary conditions are a sparse_bc (a pointer, allocated only for
+	  the vertices having boundary conditions); \n
+	- it has no virtual destructor, so no pointer to the virtual table.
+
+	@param N Space dimension
+	@param num_bc Number of boundary conditions
+*/
+template <unsigned int N, unsigned int num_bc = 1>
+struct Vertex_compact_property{
+	//!Definition of some types which may be useful to see outside the struct
+	using point_t = typename BGLgeom::point<N>;
+	using bc_t = BGLgeom::boundary_condition;
+
+	//! Coordinates of the vertex
+	point_t coordinates;
+	//! Boundary conditions on the vertex (allocated only if present)
+	sparse_bc<num_bc> BC;
+	//! A label for the vertex (if needed)
+	interned_label label;
+	//! An index for the vertex (if the user wants to keep track of the vertices)
+	int index;
+
+	//! Default constructor
+	Vertex_compact_property() : coordinates(), BC(), label(), index(-1) {};
+
+	//! Constructor with only the coordinates
+	Vertex_compact_property(point_t const& _coordinates) : coordinates(_coordinates), BC(), label(), index(-1) {};
+
+	//! Constructor with coordinates and index
+	Vertex_compact_property(point_t const& _coordinates,
+							unsigned int const& _index) : coordinates(_coordinates), BC(), label(), index(_index) {};
+
+	//! Constructor with coordinates and label
+	Vertex_compact_property(point_t const& _coordinates,
+							std::string const& _label) : coordinates(_coordinates), BC(), label(_label), index(-1) {};
+
+	//! Constructor with coordinates and BC (std::array)
+	Vertex_compact_property(point_t const& _coordinates,
+							std::array<bc_t, num_bc> const& _BC) : coordinates(_coordinates), BC(_BC), label(), index(-1) {};
+
+	//! Constructor with coordinates and BC (std::initializer_list)
+	Vertex_compact_property(point_t const& _coordinates,
+							std::initializer_list<bc_t> const& _BC) : coordinates(_coordinates), BC(), label(), index(-1) {
+		std::size_t i = 0;
+		for(bc_t const& bc : _BC)
+			BC[i++] = bc;
+	}
+
+	//! Full constructor (with std::array for BCs)
+	Vertex_compact_property(point_t const& _coordinates,
+							std::array<bc_t,num_bc> const& _BC,
+							std::string const& _label,
+							unsigned int const& _index) : coordinates(_coordinates), BC(_BC), label(_label), index(_index) {};
+
+	//! Full constructor (with std::initializer_list for BCs)
+	Vertex_compact_property(point_t const& _coordinates,
+							std::initializer_list<bc_t> const& _BC,
+							std::string const& _label,
+							unsigned int const& _index) : coordinates(_coordinates), BC(), label(_label), index(_index) {
+		std::size_t i = 0;
+		for(bc_t const& bc : _BC)
+			BC[i++] = bc;
+	}
+
+	//! Copy constructor
+	Vertex_compact_property(Vertex_compact_property const&) = default;
+
+	//! Move constructor
+	Vertex_compact_property(Vertex_compact_property &&) = default;
+
+	//! Assignment operator
+	Vertex_compact_property & operator=(Vertex_compact_property const&) = default;
+
+	//! Move assignment
+	Vertex_compact_property & operator=(Vertex_compact_property &&) = default;
+
+	//! Memory used by the vertex, including the boundary conditions
+	std::size_t bytes() const { return sizeof(Vertex_compact_property) + BC.bytes(); }
+
+	/*!
+		@brief Overload of output operator
+
+		It prints out what is in the vertex property. Shows "NOT DEFINED" if
+		the corresponding value was left defaulted
+	*/
+	friend std::ostream & operator<<(std::ostream & out, Vertex_compact_property const& v_prop) {
+		out << "Coordinates: " << v_prop.coordinates << std::endl;
+		if(v_prop.index != -1)
+			out << "Index: " << v_prop.index << std::endl;
+		else
+			out << "Index: NOT DEFINED" << std::endl;
+		if(v_prop.label.empty())
+			out << "Label: NOT DEFINED" << std::endl;
+		else
+			out << "Label: "<< v_prop.label << std::endl;
+		if(v_prop.BC.empty())
+			out << "Boundary condition(s): NOT DEFINED" << std::endl;
+		else{
+			out << "Boundary condition(s): " << std::endl;
+			for(std::size_t i = 0; i < v_prop.BC.size(); ++i)
+				 out << "\t" << i+1 << ") " << v_prop.BC[i] << std::endl;
+		}
+		return out;
+	}
+};	//Vertex_compact_property
+
+/*!
+	@brief	A std::vector allocated only when it is not empty
+
+	It contains only a pointer, null as long as no value is stored. It has
+	the part of the interface of std::vector used on the meshes: reading
+	it through a const reference never allocates it.
+
+	@param T Type of the values
+*/
+template <typename T>
+class optional_vector{
+	public:
+		using vector_t = std::vector<T>;
+		using value_type = T;
+		using const_iterator = typename vector_t::const_iterator;
+		using iterator = typename vector_t::iterator;
+
+		//! Default constructor: empty vector
+		optional_vector() : V() {};
+
+		//! Constructor from a std::vector
+		optional_vector(vector_t const& _V) : V(_V.empty() ? nullptr : new vector_t(_V)) {};
+
+		//! Copy constructor
+		optional_vector(optional_vector const& other) : V(other.V ? new vector_t(*other.V) : nullptr) {};
+
+		//! Move constructor
+		optional_vector(optional_vector &&) = default;
+
+		//! Assignment operator
+		optional_vector &
+		operator=(optional_vector const& other){
+			if(this != &other)
+				V.reset(other.V ? new vector_t(*other.V) : nullptr);
+			return *this;
+		}
+
+		//! Move assignment
+		optional_vector & operator=(optional_vector &&) = default;
+
+		//! Assignment from a std::vector
+		optional_vector &
+		operator=(vector_t const& _V){
+			V.reset(_V.empty() ? nullptr : new vector_t(_V));
+			return *this;
+		}
+
+		//! Conversion to std::vector
+		vector_t const& get() const { return V ? *V : none(); }
+
+		//! Number of values
+		std::size_t size() const { return V ? V->size() : 0; }
+
+		//! True if there are no values
+		bool empty() const { return !V || V->empty(); }
+
+		//! The i-th value
+		T const& operator[](std::size_t const& i) const { return (*V)[i]; }
+
+		//! The i-th value
+		T & operator[](std::size_t const& i) { return (*V)[i]; }
+
+		//! First value
+		T const& front() const { return V->front(); }
+
+		//! Last value
+		T const& back() const { return V->back(); }
+
+		//! Beginning of the values
+		const_iterator begin() const { return this->get().begin(); }
+
+		//! End of the values
+		const_iterator end() const { return this->get().end(); }
+
+		//! Beginning of the values
+		iterator begin() { return V ? V->begin() : iterator(); }
+
+		//! End of the values
+		iterator end() { return V ? V->end() : iterator(); }
+
+		//! Changes the number of values
+		void
+		resize(std::size_t const& n){
+			if(n == 0)
+				V.reset();
+			else{
+				if(!V)
+					V.reset(new vector_t());
+				V->resize(n);
+			}
+		}
+
+		//! Replaces the values with those in [first, last)
+		template <typename It>
+		void
+		assign(It first, It last){
+			if(first == last)
+				V.reset();
+			else{
+				if(!V)
+					V.reset(new vector_t());
+				V->assign(first, last);
+			}
+		}
+
+		//! Adds a value at the end
+		void
+		push_back(T const& value){
+			if(!V)
+				V.reset(new vector_t());
+			V->push_back(value);
+		}
+
+		//! Removes all the values, releasing the memory
+		void
+		clear() { V.reset(); }
+
+		//! Memory allocated for the values
+		std::size_t bytes() const { return V ? sizeof(vector_t) + V->capacity()*sizeof(T) : 0; }
+
+	private:
+		//! The values, if present
+		std::unique_ptr<vector_t> V;
+
+		//! The empty vector
+		static vector_t const&
+		none(){
+			static const vector_t v;
+			return v;
+		}
+};	//optional_vector
+
+/*!
+	@brief	A mesh allocated only when it is computed
+
+	It has the same members and methods of BGLgeom::mesh (see mesh.hpp),
+	but real and parametric are optional_vector, so an edge without a mesh
+	uses only two pointers. It has no virtual destructor.
+
+	@param dim The dimension of the space
+*/
+template <unsigned int dim>
+struct optional_mesh{
+	// Aliases
+	using vect_pts = std::vector<BGLgeom::point<dim>>;
+	using vect = std::vector<double>;
+
+	//! The real mesh, the coordinates of the points in the space
+	optional_vector<BGLgeom::point<dim>> real;
+	//! The parametric mesh, used to compute the real one
+	optional_vector<double> parametric;
+
+	//! Default constructor
+	optional_mesh() : real(), parametric() {};
+
+	//! Constructor
+	optional_mesh(vect_pts const& _real, vect const& _parametric) : real(_real), parametric(_parametric) {};
+
+	//! Copy constructor
+	optional_mesh(optional_mesh const&) = default;
+
+	//! Move constructor
+	optional_mesh(optional_mesh &&) = default;
+
+	//! Assignment operator
+	optional_mesh & operator=(optional_mesh const&) = default;
+
+	//! Move assignment
+	optional_mesh & operator=(optional_mesh &&) = default;
+
+	//! Clear both the real and the parametric mesh, releasing the memory
+	void
+	clear(){
+		real.clear();
+		parametric.clear();
+	}
+
+	//! True if both the real and the parametric mesh are empty (see mesh::empty())
+	bool
+	empty() const {
+		if(real.empty() && parametric.empty())
+			return true;
+		else{
+			if( real.empty() && !parametric.empty() )
+				std::cerr << "BGLgeom::optional_mesh::empty(): warning, mesh.real is empty, while mesh.parametric is not" << std::endl;
+			if( !real.empty() && parametric.empty() )
+				std::cerr << "BGLgeom::optional_mesh::empty(): warning, mesh.parametric is empty, while mesh.real is not" << std::endl;
+			return false;
+		}
+	}
+
+	//! Copy of the mesh as a BGLgeom::mesh
+	BGLgeom::mesh<dim>
+	to_mesh() const { return BGLgeom::mesh<dim>(real.get(), parametric.get()); }
+
+	//! Memory allocated for the mesh
+	std::size_t bytes() const { return real.bytes() + parametric.bytes(); }
+
+	//! Creates a uniform parametric mesh, and then evaluates it (see mesh::uniform_mesh())
+	void
+	uniform_mesh(unsigned int const& n, std::function<vect_pts(vect const&)> const& eval){
+		BGLgeom::Mesh1D temp_mesh(BGLgeom::Domain1D(0,1), n);
+		vect temp_param = temp_mesh.getMesh();
+		real = eval(temp_param);
+		parametric = temp_param;
+	}
+
+	//! Creates a non-uniform parametric mesh and then evaluates it (see mesh::variable_mesh())
+	void
+	variable_mesh(unsigned int const& n,
+				  std::function<double(double)> const& spacing_function,
+				  std::function<vect_pts(vect const&)> const& eval){
+		BGLgeom::Mesh1D temp_mesh(BGLgeom::Domain1D(0,1), n, spacing_function);
+		vect temp_param = temp_mesh.getMesh();
+		real = eval(temp_param);
+		parametric = temp_param;
+	}
+};	//optional_mesh
+
+//! A mesh in memory has nothing to prepare (see prefetch_mesh() in mesh.hpp)
+template <unsigned int dim>
+inline void
+prefetch_mesh(optional_mesh<dim> const&) {}
+
+/*!
+	@brief	Compact data structure for the edge properties
+
+	It has the same members, constructors and methods of Edge_base_property,
+	and it can be used in its place, but:
+	- the mesh is an optional_mesh (two pointers, allocated only when
+	  make_uniform_mesh() or make_variable_mesh() are called); \n
+	- the label is an interned_label (4 bytes instead of a std::string); \n
+	- it has no virtual destructor, so no pointer to the virtual table.
+
+	@param Geom Type of the geometry for the edge
+	@param dim The dimension of the space
+*/
+template <typename Geom, unsigned int dim>
+struct Edge_compact_property{
+	//! Definition of some types which may be useful to see outside the struct
+	using geom_t = Geom;
+	using mesh_t = BGLgeom::optional_mesh<dim>;
+
+	//! The class handling the parameterization of the edge
+	geom_t geometry;
+	//! The mesh (allocated only if computed)
+	mesh_t mesh;
+	//! A label for the edge (if needed)
+	interned_label label;
+	//! An index for the edge (if the user wants to keep track of the edge)
+	int index;
+
+	//! Default constructor
+	Edge_compact_property() : geometry(), mesh(), label(), index(-1) {};
+
+	//! Constructor with the geometry
+	Edge_compact_property(geom_t const& _geometry) : geometry(_geometry), mesh(), label(), index(-1) {};
+
+	//! Constructor with label
+	Edge_compact_property(std::string const& _label) : geometry(), mesh(), label(_label), index(-1) {};
+
+	//! Constructor with index
+	Edge_compact_property(int const& _index) : geometry(), mesh(), label(), index(_index) {};
+
+	//! Constructor with label and index
+	Edge_compact_property(std::string const& _label,
+						  int const& _index) : geometry(), mesh(), label(_label), index(_index) {};
+
+	//! Full constructor
+	Edge_compact_property(geom_t _geometry,
+						  std::string const& _label,
+						  int const& _index) : geometry(_geometry), mesh(), label(_label), index(_index) {};
+
+	//! Copy constructor
+	Edge_compact_property(Edge_compact_property const&) = default;
+
+	//! Move constructor
+	Edge_compact_property(Edge_compact_property &&) = default;
+
+	//! Assignment operator
+	Edge_compact_property & operator=(Edge_compact_property const&) = default;
+
+	//! Move assignment
+	Edge_compact_property & operator=(Edge_compact_property &&) = default;
+
+	//! Helper method to create a mesh using the uniform_mesh() method of the mesh
+	void make_uniform_mesh(unsigned int const& n){
+		mesh.uniform_mesh(n, BGLgeom::mesh_evaluator<mesh_t>(geometry));
+	}
+
+	//! Helper method to create a mesh using the variable_mesh() method of the mesh
+	void make_variable_mesh(unsigned int const& n, std::function<double(double)> const& spacing_function){
+		mesh.variable_mesh(n, spacing_function, BGLgeom::mesh_evaluator<mesh_t>(geometry));
+	}
+
+	//! Memory used by the edge property, including the mesh
+	std::size_t bytes() const { return sizeof(Edge_compact_property) + mesh.bytes(); }
+
+	/*!
+		@brief	Overload of operator<<
+
+		It prints out what is in the edge property (see Edge_base_property)
+	*/
+	friend std::ostream & operator<<(std::ostream & out, Edge_compact_property const& e_prop) {
+		out << e_prop.geometry << std::endl;
+		if(e_prop.index != -1)
+			out << "Index: " << e_prop.index << std::endl;
+		else
+			out << "Index: NOT DEFINED" << std::endl;
+		if(e_prop.label.empty())
+			out << "Label: NOT DEFINED" << std::endl;
+		else
+			out << "Label: " << e_prop.label << std::endl;
+		if(e_prop.mesh.empty())
+			out << "Mesh: empty" << std::endl;
+		else
+			out << "Mesh: already computed" <<std::endl;
+		return out;
+	}
+};	//Edge_compact_property
+
+}	//BGLgeom
+
+#endif	//HH_COMPACT_PROPERTIES_HH
@@ -0,0 +1,399 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	coordinate_store.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Coordinates of all the vertices in a single contiguous array
+
+	With the base properties the coordinates of each vertex are inside its
+	property, so any operation on all the coordinates (bounding box,
+	transformations, input for a solver) has to gather them first. With
+	Vertex_store_property the coordinates are stored in a coordinate_store,
+	an N x dim row-major array, and each vertex property refers to its row.
+	Create the store, with the maximum number of vertices, and make it the
+	current one before building the graph:
+	\code
+	using Vertex_prop = BGLgeom::Vertex_store_property<3>;
+	BGLgeom::coordinate_store<3> store(n_vertices);
+	store.make_current();
+	// ... build the graph as usual ...
+	store.all().colwise().minCoeff();	// no copies
+	\endcode
+	A property object takes a row of the store only when it becomes a
+	vertex (the builders in graph_builder.hpp, bulk_builder.hpp and
+	arrangement_builder.hpp call vertex_added(), see graph_access.hpp),
+	so the row of each vertex is its vertex descriptor; spatial_reorder()
+	permutes the rows with the vertices.
+*/
+
+#ifndef HH_COORDINATE_STORE_HH
+#define HH_COORDINATE_STORE_HH
+
+#include <iostream>
+#include <array>
+#include <vector>
+#include <string>
+#include <initializer_list>
+#include <cstdlib>
+#include <Eigen/Dense>
+#include <new>
+#include "point.hpp"
+#include "compact_properties.hpp"
+#include "graph_access.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	Contiguous array with the coordinates of the vertices
+
+	The coordinates of the i-th point are the i-th row of an N x dim
+	row-major matrix. The capacity is fixed at construction: the array is
+	never reallocated, so that the vertex properties can refer to their
+	coordinates directly.
+
+	@param dim Dimension of the space
+*/
+template <unsigned int dim>
+class coordinate_store{
+	public:
+		using point_t = BGLgeom::point<dim>;
+		using map_t = Eigen::Map<point_t>;
+		using const_map_t = Eigen::Map<const point_t>;
+		using matrix_t = Eigen::Matrix<double, Eigen::Dynamic, dim, Eigen::RowMajor>;
+		using matrix_map_t = Eigen::Map<matrix_t>;
+		using const_matrix_map_t = Eigen::Map<const matrix_t>;
+
+		//! Constructor, with the maximum number of points
+		coordinate_store(std::size_t const& _capacity) : X(), capacity(_capacity) {
+			X.reserve(capacity*dim);
+		}
+
+		//! Copy constructor deleted: the vertex properties refer to this array
+		coordinate_store(coordinate_store const&) = delete;
+
+		//! Assignment operator deleted
+		coordinate_store & operator=(coordinate_store const&) = delete;
+
+		//! Destructor
+		virtual ~coordinate_store(){
+			if(current() == this)
+				current() = nullptr;
+		}
+
+		//! Adds a point, returning the pointer to its coordinates
+		double*
+		add(point_t const& P){
+			if(this->size() == capacity){
+				std::cerr << "ERROR! BGLgeom::coordinate_store::add(): the store is full (" << capacity << " points)" << std::endl;
+				std::cerr << "Aborting" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			for(std::size_t i = 0; i < dim; ++i)
+				X.push_back(P(i));
+			return X.data() + X.size() - dim;
+		}
+
+		//! Number of points
+		std::size_t size() const { return X.size()/dim; }
+
+		//! Maximum number of points
+		std::size_t get_capacity() const { return capacity; }
+
+		//! Row of the point whose coordinates are in P
+		std::size_t index(double const* P) const { return (P - X.data())/dim; }
+
+		//! True if P points to the coordinates of a point in the store
+		bool contains(double const* P) const { return P >= X.data() && P < X.data() + X.size(); }
+
+		//! Coordinates of the i-th point
+		map_t operator[](std::size_t const& i) { return map_t(X.data() + i*dim); }
+
+		//! Coordinates of the i-th point
+		const_map_t operator[](std::size_t const& i) const { return const_map_t(X.data() + i*dim); }
+
+		//! All the coordinates, as a size() x dim matrix, without copying them
+		matrix_map_t all() { return matrix_map_t(X.data(), this->size(), dim); }
+
+		//! All the coordinates, as a size() x dim matrix, without copying them
+		const_matrix_map_t all() const { return const_matrix_map_t(X.data(), this->size(), dim); }
+
+		//! Pointer to the coordinates, for the solvers taking plain arrays
+		double* data() { return X.data(); }
+
+		//! Pointer to the coordinates, for the solvers taking plain arrays
+		double const* data() const { return X.data(); }
+
+		//! Makes this the store where the coordinates of the new vertices are added
+		void
+		make_current() { current() = this; }
+
+		//! The store where the coordinates of the new vertices are added
+		static coordinate_store* &
+		current(){
+			static coordinate_store* store = nullptr;
+			return store;
+		}
+
+	private:
+		//! The coordinates
+		std::vector<double> X;
+		//! Maximum number of points
+		std::size_t capacity;
+};	//coordinate_store
+
+/*!
+	@brief	Coordinates of a vertex stored in a coordinate_store
+
+	It is an Eigen::Map, so it is used as a point<dim> (it has the same
+	methods, and it converts to a point<dim>). Until it is attached to a
+	row of the store it maps its own copy of the coordinates; once
+	attached, it reads and writes the coordinates in the store.
+
+	@note	The copies of an attached point refer to the same coordinates,
+			so that the vertices keep their row when the vector of the
+			vertices of the graph is reallocated. The copy constructor and
+			the assignment of boost::adjacency_list assign the properties
+			instead, so the copy of a graph has its own (detached)
+			coordinates
+*/
+template <unsigned int dim>
+class stored_point : public Eigen::Map<BGLgeom::point<dim>>{
+	public:
+		using base_t = Eigen::Map<BGLgeom::point<dim>>;
+
+		//! Constructor: the coordinates are kept in the point until it is attached
+		explicit stored_point(BGLgeom::point<dim> const& P) : base_t(own) {
+			base_t::operator=(P);
+		};
+
+		//! Copy constructor: it refers to the same coordinates, if attached
+		stored_point(stored_point const& other) : base_t(other.attached() ? const_cast<double*>(other.data()) : own) {
+			if(!other.attached())
+				base_t::operator=(other);
+		};
+
+		//! Assignment of the coordinates
+		stored_point &
+		operator=(stored_point const& other){
+			base_t::operator=(other);
+			return *this;
+		}
+
+		//! Assignment of the coordinates
+		template <typename Derived>
+		stored_point &
+		operator=(Eigen::DenseBase<Derived> const& other){
+			base_t::operator=(other);
+			return *this;
+		}
+
+		//! Copy of the coordinates
+		BGLgeom::point<dim> get() const { return *this; }
+
+		//! True if the coordinates are in a store
+		bool attached() const { return this->data() != own; }
+
+		//! Copies the coordinates in the row P of a store, and refers to it from now on
+		void
+		attach(double* P){
+			const BGLgeom::point<dim> X = *this;
+			this->rebind(P);
+			base_t::operator=(X);
+		}
+
+		//! Refers to the coordinates in the row P of a store, without copying them
+		void
+		rebind(double* P){ new (static_cast<base_t*>(this)) base_t(P); }
+
+	private:
+		//! The coordinates, before the point is attached to a store
+		double own[dim];
+};	//stored_point
+
+/*!
+	@brief	Vertex property with the coordinates in a coordinate_store
+
+	It has the same members and constructors of Vertex_compact_property,
+	but the coordinates are a stored_point: when the property becomes the
+	vertex v of a graph, its coordinates are moved to the row v of the
+	current store (coordinate_store::make_current()). The temporary
+	properties, e.g. the ones of the vertices found already in the graph
+	by new_vertex(), take no row.
+
+	@param N Space dimension
+	@param num_bc Number of boundary conditions
+*/
+template <unsigned int N, unsigned int num_bc = 1>
+struct Vertex_store_property{
+	//!Definition of some types which may be useful to see outside the struct
+	using point_t = typename BGLgeom::point<N>;
+	using bc_t = BGLgeom::boundary_condition;
+
+	//! Coordinates of the vertex, in the current store
+	stored_point<N> coordinates;
+	//! Boundary conditions on the vertex (allocated only if present)
+	sparse_bc<num_bc> BC;
+	//! A label for the vertex (if needed)
+	interned_label label;
+	//! An index for the vertex (if the user wants to keep track of the vertices)
+	int index;
+
+	//! Default constructor
+	Vertex_store_property() : coordinates(point_t::Zero()), BC(), label(), index(-1) {};
+
+	//! Constructor with only the coordinates
+	Vertex_store_property(point_t const& _coordinates) : coordinates(_coordinates), BC(), label(), index(-1) {};
+
+	//! Constructor with coordinates and index
+	Vertex_store_property(point_t const& _coordinates,
+						  unsigned int const& _index) : coordinates(_coordinates), BC(), label(), index(_index) {};
+
+	//! Constructor with coordinates and label
+	Vertex_store_property(point_t const& _coordinates,
+						  std::string const& _label) : coordinates(_coordinates), BC(), label(_label), index(-1) {};
+
+	//! Constructor with coordinates and BC (std::array)
+	Vertex_store_property(point_t const& _coordinates,
+						  std::array<bc_t, num_bc> const& _BC) : coordinates(_coordinates), BC(_BC), label(), index(-1) {};
+
+	//! Full constructor (with std::array for BCs)
+	Vertex_store_property(point_t const& _coordinates,
+						  std::array<bc_t,num_bc> const& _BC,
+						  std::string const& _label,
+						  unsigned int const& _index) : coordinates(_coordinates), BC(_BC), label(_label), index(_index) {};
+
+	//! Copy constructor: the copy refers to the same coordinates (if attached to a store)
+	Vertex_store_property(Vertex_store_property const&) = default;
+
+	//! Move constructor
+	Vertex_store_property(Vertex_store_property &&) = default;
+
+	//! Assignment operator: it copies the coordinates in the store
+	Vertex_store_property & operator=(Vertex_store_property const&) = default;
+
+	//! Move assignment
+	Vertex_store_property & operator=(Vertex_store_property &&) = default;
+
+	//! Overload of output operator (see Vertex_compact_property)
+	friend std::ostream & operator<<(std::ostream & out, Vertex_store_property const& v_prop) {
+		out << "Coordinates: " << v_prop.coordinates << std::endl;
+		if(v_prop.index != -1)
+			out << "Index: " << v_prop.index << std::endl;
+		else
+			out << "Index: NOT DEFINED" << std::endl;
+		if(v_prop.label.empty())
+			out << "Label: NOT DEFINED" << std::endl;
+		else
+			out << "Label: "<< v_prop.label << std::endl;
+		if(v_prop.BC.empty())
+			out << "Boundary condition(s): NOT DEFINED" << std::endl;
+		else{
+			out << "Boundary condition(s): " << std::endl;
+			for(std::size_t i = 0; i < v_prop.BC.size(); ++i)
+				 out << "\t" << i+1 << ") " << v_prop.BC[i] << std::endl;
+		}
+		return out;
+	}
+};	//Vertex_store_property
+
+namespace store_detail{
+
+//! The current store, aborting if there is none
+template <unsigned int N>
+coordinate_store<N> &
+current_store(){
+	coordinate_store<N>* store = coordinate_store<N>::current();
+	if(!store){
+		std::cerr << "ERROR! BGLgeom::Vertex_store_property: no current coordinate_store, call make_current() first" << std::endl;
+		std::cerr << "Aborting" << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	return *store;
+}	//current_store
+
+}	//store_detail
+
+/*!
+	@brief	The property of the new vertex v takes the row v of the current store
+
+	@pre	The rows of the store are the vertices of the graph, so the store
+			must have exactly v rows
+*/
+template <typename Graph, typename Vertex, unsigned int N, unsigned int num_bc>
+void
+attach_vertex_storage(Graph & G, Vertex const& v, Vertex_store_property<N,num_bc> const*){
+	coordinate_store<N> & store = store_detail::current_store<N>();
+	if(store.size() != static_cast<std::size_t>(v)){
+		std::cerr << "ERROR! BGLgeom::Vertex_store_property: vertex " << v << " added to a store with " << store.size()
+				  << " rows, the rows have to follow the vertex descriptors" << std::endl;
+		std::cerr << "Aborting" << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	G[v].coordinates.attach(store.add(G[v].coordinates.get()));
+}	//attach_vertex_storage
+
+/*!
+	@brief	Permutes the rows of the current store after the vertices have
+			been renumbered, so that the row of each vertex is again its
+			vertex descriptor
+
+	The vertices not attached to a store (as the ones of a graph copied
+	with the copy constructor or assignment of boost::adjacency_list) are
+	attached to their row.
+
+	@pre	The store must have a row for each vertex, and the attached
+			vertices must refer to these rows (any order)
+*/
+template <typename Graph, unsigned int N, unsigned int num_bc>
+void
+sort_vertex_storage(Graph & G, Vertex_store_property<N,num_bc> const*){
+	const std::size_t n = boost::num_vertices(G);
+	if(n == 0)
+		return;
+	coordinate_store<N> & store = store_detail::current_store<N>();
+	if(store.size() != n){
+		std::cerr << "ERROR! BGLgeom::Vertex_store_property: " << n << " vertices renumbered in a store with "
+				  << store.size() << " rows, the rows have to follow the vertex descriptors" << std::endl;
+		std::cerr << "Aborting" << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	std::vector<BGLgeom::point<N>> P(n);
+	for(std::size_t v = 0; v < n; ++v){
+		if(G[v].coordinates.attached() && !store.contains(G[v].coordinates.data())){
+			std::cerr << "ERROR! BGLgeom::Vertex_store_property: vertex " << v << " is attached to another store" << std::endl;
+			std::cerr << "Aborting" << std::endl;
+			exit(EXIT_FAILURE);
+		}
+		P[v] = G[v].coordinates.get();
+	}
+	for(std::size_t v = 0; v < n; ++v){
+		store[v] = P[v];
+		G[v].coordinates.rebind(store.data() + v*N);
+	}
+}	//sort_vertex_storage
+
+}	//BGLgeom
+
+#endif	//HH_COORDINATE_STORE_HH
@@ -0,0 +1,123 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	csr_graph.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Immutable compressed sparse row copy of a graph
+*/
+
+#ifndef HH_CSR_GRAPH_HH
+#define HH_CSR_GRAPH_HH
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <boost/graph/compressed_sparse_row_graph.hpp>
+#include <boost/graph/adjacency_list.hpp>
+#include "graph_access.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	Graph in compressed sparse row format
+
+	It is a boost::compressed_sparse_row_graph, with the same vertex and
+	edge properties of the graph it is built from. The vertex properties
+	(so the coordinates) and the edge properties (so the geometries and
+	the meshes) are stored in two contiguous arrays, ordered as the
+	vertices and as the edges sorted by source, and the adjacency of all
+	the vertices in a single array: visiting the graph is then much more
+	cache friendly than with an adjacency_list. The graph cannot be
+	modified after its construction, apart from the values of the properties.
+
+	It is a model of the same concepts used by the functions in
+	graph_access.hpp and by the writers, so they can be used also on it.
+
+	@note	Since compressed_sparse_row_graph only supports directed graphs,
+			each edge of an undirected graph is stored once, from the source
+			to the target it had in the original graph. The edges incident to
+			a vertex are then its out edges and its in edges
+
+	@param Vertex_prop The vertex property
+	@param Edge_prop The edge property
+*/
+template <typename Vertex_prop, typename Edge_prop>
+using csr_graph = boost::compressed_sparse_row_graph<boost::bidirectionalS, Vertex_prop, Edge_prop>;
+
+/*!
+	@brief	Builds a compressed sparse row copy of the given graph
+
+	The vertices keep their indices, while the edges are sorted by source
+	(keeping their relative order for the same source)
+
+	@pre	The graph must have an internal vertex_index property (as the
+			adjacency_list with boost::vecS as vertex container)
+	@param G The graph to be copied
+	@return The immutable copy of G
+*/
+template <typename Graph>
+BGLgeom::csr_graph<typename boost::vertex_bundle_type<Graph>::type,
+				   typename boost::edge_bundle_type<Graph>::type>
+make_csr_snapshot(Graph const& G){
+	using Vertex_prop = typename boost::vertex_bundle_type<Graph>::type;
+	using Edge_prop = typename boost::edge_bundle_type<Graph>::type;
+	using size_type = typename BGLgeom::csr_graph<Vertex_prop,Edge_prop>::vertices_size_type;
+
+	auto index = boost::get(boost::vertex_index, G);
+	const std::size_t n_edges = boost::num_edges(G);
+
+	// Edges sorted by source, stable to keep the order of the original graph
+	std::vector<BGLgeom::Edge_desc<Graph>> E;
+	E.reserve(n_edges);
+	BGLgeom::Edge_iter<Graph> e_it, e_end;
+	for(std::tie(e_it, e_end) = boost::edges(G); e_it != e_end; ++e_it)
+		E.push_back(*e_it);
+	std::stable_sort(E.begin(), E.end(),
+					 [&](BGLgeom::Edge_desc<Graph> const& e1, BGLgeom::Edge_desc<Graph> const& e2){
+						return index[boost::source(e1,G)] < index[boost::source(e2,G)];
+					 });
+
+	std::vector<std::pair<size_type,size_type>> edge_list;
+	std::vector<Edge_prop> edge_props;
+	edge_list.reserve(n_edges);
+	edge_props.reserve(n_edges);
+	for(BGLgeom::Edge_desc<Graph> const& e : E){
+		edge_list.push_back(std::make_pair(index[boost::source(e,G)], index[boost::target(e,G)]));
+		edge_props.push_back(G[e]);
+	}
+
+	BGLgeom::csr_graph<Vertex_prop,Edge_prop> S(boost::edges_are_unsorted_multi_pass,
+												edge_list.begin(), edge_list.end(),
+												edge_props.begin(),
+												boost::num_vertices(G));
+	BGLgeom::Vertex_iter<Graph> v_it, v_end;
+	for(std::tie(v_it, v_end) = boost::vertices(G); v_it != v_end; ++v_it)
+		S[index[*v_it]] = G[*v_it];
+	return S;
+}	//make_csr_snapshot
+
+}	//BGLgeom
+
+#endif	//HH_CSR_GRAPH_HH
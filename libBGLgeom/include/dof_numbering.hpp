@@ -0,0 +1,265 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	dof_numbering.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Global numbering of the mesh nodes of a graph, with Reverse Cuthill-McKee ordering
+*/
+
+#ifndef HH_DOF_NUMBERING_HH
+#define HH_DOF_NUMBERING_HH
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <cstdlib>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/cuthill_mckee_ordering.hpp>
+#include "point.hpp"
+#include "graph_access.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	Global numbering of the nodes of the meshes on the edges of a graph
+
+	The nodes (degrees of freedom) of the whole network are the vertices of
+	the graph, shared by all the edges meeting there, and the inner points
+	of the mesh on each edge (mesh.real without its first and last point,
+	which are source and target). Two nodes are connected if they are
+	consecutive along the mesh of an edge; an edge without mesh connects
+	directly its source and its target.
+
+	The natural numbering follows the storage order of the graph: first the
+	vertices, then the inner points of the edges, edge by edge. This is the
+	order of insertion of the edges, so the matrix of a problem assembled on
+	the network has a large bandwidth. By default the nodes are renumbered
+	with the Reverse Cuthill-McKee algorithm (boost::cuthill_mckee_ordering,
+	applied to each connected component), which keeps the non-zero entries
+	close to the diagonal: this reduces the fill-in of direct solvers.
+
+	Writers and solvers get the index of each node through the dof()
+	methods, and can go from one numbering to the other with permutation()
+	and inverse_permutation().
+
+	@pre	The graph must use boost::vecS as container for the vertices
+	@note	The numbering refers to the meshes present on the edges at the
+			moment of its construction: if the graph or the meshes change,
+			it has to be computed again
+
+	@param Graph The type of the graph
+	@param dim Dimension of the space
+*/
+template <typename Graph, unsigned int dim>
+class dof_numbering {
+
+	public:
+		using point = BGLgeom::point<dim>;
+		using Edge_d = BGLgeom::Edge_desc<Graph>;
+		using Vertex_d = BGLgeom::Vertex_desc<Graph>;
+
+		/*!
+			@brief	Constructor
+
+			@param G The graph, with the meshes already created on the edges
+			@param rcm If true the nodes are renumbered with Reverse Cuthill-McKee,
+					   otherwise the natural numbering is kept
+		*/
+		dof_numbering(Graph const& G, bool const& rcm = true) :
+			n_vertices(boost::num_vertices(G)), first_inner(), coords(), links(), perm(), inv_perm() {
+			this->build_natural(G);
+			if(rcm)
+				this->build_rcm();
+			else {
+				perm.resize(coords.size());
+				for(std::size_t i = 0; i < perm.size(); ++i)
+					perm[i] = i;
+				inv_perm = perm;
+			}
+			// Coordinates and connections in the new numbering
+			std::vector<point> natural_coords(coords);
+			for(std::size_t i = 0; i < coords.size(); ++i)
+				coords[perm[i]] = natural_coords[i];
+			for(auto & l : links)
+				l = std::make_pair(perm[l.first], perm[l.second]);
+		};
+
+		//! Copy constructor
+		dof_numbering(dof_numbering const&) = default;
+
+		//! Move constructor
+		dof_numbering(dof_numbering &&) = default;
+
+		//! Assignment operator
+		dof_numbering & operator=(dof_numbering const&) = default;
+
+		//! Move assignment
+		dof_numbering & operator=(dof_numbering &&) = default;
+
+		//! Destructor
+		virtual ~dof_numbering() = default;
+
+		//! Total number of nodes
+		std::size_t size() const { return coords.size(); }
+
+		//! Index of the node on vertex v
+		std::size_t
+		dof(Vertex_d const& v) const { return perm[v]; }
+
+		/*!
+			@brief	Index of the i-th point of the mesh on edge e
+
+			The point 0 is the source of the edge, the last one is the target
+			(if there is no mesh on the edge, i = 1 is the target). Source and
+			target are the ones of the edge when the numbering was computed,
+			i.e. the ones of mesh.real, so the result does not depend on the
+			descriptor used for e (in an undirected graph, out_edges(v) gives
+			descriptors with source v).
+			@pre	e must be an edge of the graph when the numbering was computed
+		*/
+		std::size_t
+		dof(Edge_d const& e, std::size_t const& i) const {
+			auto item = first_inner.find(e);
+			if(item == first_inner.end()){
+				std::cerr << "ERROR! BGLgeom::dof_numbering::dof(): the edge " << e << " is not numbered" << std::endl;
+				std::cerr << "Aborting" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			edge_nodes const& nodes = item->second;
+			if(i > nodes.n_inner + 1){
+				std::cerr << "ERROR! BGLgeom::dof_numbering::dof(): point " << i << " requested on the edge " << e
+						  << ", which has " << nodes.n_inner + 2 << " points" << std::endl;
+				std::cerr << "Aborting" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			if(i == 0)
+				return perm[nodes.src];
+			if(i == nodes.n_inner + 1)
+				return perm[nodes.tgt];
+			return perm[nodes.first + i - 1];
+		}
+
+		//! New index of each node, given its index in the natural numbering
+		std::vector<std::size_t> const& permutation() const { return perm; }
+
+		//! Index in the natural numbering of each node, given its new index
+		std::vector<std::size_t> const& inverse_permutation() const { return inv_perm; }
+
+		//! Coordinates of the nodes, in the new numbering
+		std::vector<point> const& coordinates() const { return coords; }
+
+		//! Pairs of connected nodes (one for each mesh element), in the new numbering
+		std::vector<std::pair<std::size_t, std::size_t>> const& connections() const { return links; }
+
+		//! Bandwidth of the matrix with the sparsity pattern of the connections
+		std::size_t
+		bandwidth() const {
+			std::size_t b = 0;
+			for(auto const& l : links)
+				b = std::max(b, l.first > l.second ? l.first - l.second : l.second - l.first);
+			return b;
+		}
+
+		//! Bandwidth with the natural numbering of the nodes
+		std::size_t
+		natural_bandwidth() const {
+			std::size_t b = 0;
+			for(auto const& l : links){
+				std::size_t i = inv_perm[l.first], j = inv_perm[l.second];
+				b = std::max(b, i > j ? i - j : j - i);
+			}
+			return b;
+		}
+
+	private:
+		//! The nodes of an edge, in the natural numbering
+		struct edge_nodes{
+			//! Source of the edge (first point of the mesh)
+			std::size_t src;
+			//! Target of the edge (last point of the mesh)
+			std::size_t tgt;
+			//! First inner node
+			std::size_t first;
+			//! Number of inner nodes
+			std::size_t n_inner;
+		};
+
+		//! Number of vertices of the graph (the first nodes in the natural numbering)
+		std::size_t n_vertices;
+		//! For each edge, its extremes, its first inner node and the number of inner nodes
+		std::map<Edge_d, edge_nodes> first_inner;
+		//! Coordinates of the nodes
+		std::vector<point> coords;
+		//! Connections between the nodes
+		std::vector<std::pair<std::size_t, std::size_t>> links;
+		//! New index of each node
+		std::vector<std::size_t> perm;
+		//! Natural index of each node
+		std::vector<std::size_t> inv_perm;
+
+		//! Numbers the nodes in the storage order of the graph
+		void
+		build_natural(Graph const& G){
+			coords.reserve(n_vertices);
+			for(std::size_t v = 0; v < n_vertices; ++v)
+				coords.push_back(G[v].coordinates);
+			BGLgeom::Edge_iter<Graph> e_it, e_end;
+			for(std::tie(e_it, e_end) = boost::edges(G); e_it != e_end; ++e_it){
+				std::size_t src = boost::source(*e_it, G);
+				std::size_t tgt = boost::target(*e_it, G);
+				auto const& real = G[*e_it].mesh.real;
+				std::size_t n_inner = (real.size() > 2 ? real.size() - 2 : 0);
+				first_inner[*e_it] = edge_nodes{src, tgt, coords.size(), n_inner};
+				std::size_t prev = src;
+				for(std::size_t i = 1; i <= n_inner; ++i){
+					links.push_back(std::make_pair(prev, coords.size()));
+					prev = coords.size();
+					coords.push_back(real[i].template head<dim>().template cast<double>());
+				}
+				links.push_back(std::make_pair(prev, tgt));
+			}
+		}
+
+		//! Computes the Reverse Cuthill-McKee permutation of the nodes
+		void
+		build_rcm(){
+			using Dof_graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
+			Dof_graph D(coords.size());
+			for(auto const& l : links)
+				boost::add_edge(l.first, l.second, D);
+			inv_perm.resize(coords.size());
+			boost::cuthill_mckee_ordering(D, inv_perm.rbegin());
+			perm.resize(coords.size());
+			for(std::size_t i = 0; i < inv_perm.size(); ++i)
+				perm[inv_perm[i]] = i;
+		}
+
+};	//dof_numbering
+
+}	//BGLgeom
+
+#endif	//HH_DOF_NUMBERING_HH
@@ -52,12 +52,13 @@ namespace BGLgeom{
 	It provides also evaluation of this characteristics for a single value
 	or for a vector of values of the parameter
 	@param dim The dimension of the space
+	@param T The scalar type of the coordinates and of the parameter
 */
-template <unsigned int dim>
+template <unsigned int dim, typename T = double>
 class edge_geometry {
-	using point = BGLgeom::point<dim>;
+	using point = BGLgeom::point<dim,T>;
 	using vect_pts = std::vector<point>;
-	using vect_double = std::vector<double>;
+	using vect_double = std::vector<T>;
 
 	public:
 		/*!
@@ -67,12 +68,12 @@ class edge_geometry {
 			the parameter
 			@return A point in the dim-dimensional space.
 		*/
-		virtual BGLgeom::point<dim>
-		operator() (double const&) const = 0;
+		virtual BGLgeom::point<dim,T>
+		operator() (T const&) const = 0;
 		
 		//! The same as before, but with evaluation on a vector of parameters
-		virtual std::vector<BGLgeom::point<dim>>
-		operator() (std::vector<double> const&) const = 0;
+		virtual std::vector<BGLgeom::point<dim,T>>
+		operator() (std::vector<T> const&) const = 0;
 		
 		/*!
 			@brief First derivative of the curve
@@ -80,15 +81,15 @@ class edge_geometry {
 			It evaluates each component of the first derivative of the curve
 			at a given value of the parameter
 			@return An Eigen matrix containing the three components of the evaluation.
-					We use again as return value a BGLgeom:point<dim>, since the 
+					We use again as return value a BGLgeom:point<dim,T>, since the 
 					underlying container is the same
 		*/
-		virtual BGLgeom::point<dim>
-		first_der (double const&) const = 0;
+		virtual BGLgeom::point<dim,T>
+		first_der (T const&) const = 0;
 		
 		//! The same as before, but with evaluation on a vector of parameters
-		virtual std::vector<BGLgeom::point<dim>>
-		first_der (std::vector<double> const&) const = 0;
+		virtual std::vector<BGLgeom::point<dim,T>>
+		first_der (std::vector<T> const&) const = 0;
 		
 		/*!
 			@brief Second derivative of the curve
@@ -96,15 +97,15 @@ class edge_geometry {
 			It evaluates each component of the second derivative of the curve
 			at a given value of the parameter
 			@return An Eigen matrix containing the three components of the evaluation.
-					We use again as return value a BGLgeom:point<dim>, since the 
+					We use again as return value a BGLgeom:point<dim,T>, since the 
 					underlying container is the same
 		*/
-		virtual BGLgeom::point<dim>
-		second_der (double const&) const = 0;
+		virtual BGLgeom::point<dim,T>
+		second_der (T const&) const = 0;
 		
 		//! The same as before, but with evaluation on a vector of parameters
-		virtual std::vector<BGLgeom::point<dim>>
-		second_der (std::vector<double> const&) const = 0;
+		virtual std::vector<BGLgeom::point<dim,T>>
+		second_der (std::vector<T> const&) const = 0;
 		
 		/*!
 			@brief Curvilinear abscissa of the curve
@@ -112,24 +113,41 @@ class edge_geometry {
 			It evaluates the curvilinear abscissa of the curve at a given
 			value of the parameter
 		*/
-		virtual double
-		curv_abs (double const&) const = 0;
+		virtual T
+		curv_abs (T const&) const = 0;
 		
 		//! The same as before, but with evaluation on a vector of parameters
-		virtual std::vector<double>
-		curv_abs (std::vector<double> const&) const = 0;
+		virtual std::vector<T>
+		curv_abs (std::vector<T> const&) const = 0;
 		
 		/*!
 			@brief Curvature of the curve
 			
 			It evaluates the curvature at a given value of the parameter
 		*/
-		virtual double
-		curvature (double const&) const = 0;
+		virtual T
+		curvature (T const&) const = 0;
 		
 		//! The same as before, but with evaluation on a vector of parameters
-		virtual std::vector<double>
-		curvature (std::vector<double> const&) const = 0;
+		virtual std::vector<T>
+		curvature (std::vector<T> const&) const = 0;
+
+		/*!
+			@brief Evaluation on a vector of parameters into another type of points
+
+			The points are stored in a std::vector of Point with allocator Alloc,
+			for instance the padded points of padded_mesh (see point.hpp and
+			mesh.hpp). Here the curve is evaluated with operator() and the points
+			are converted; the geometries may provide a faster version
+		*/
+		template <typename Point, typename Alloc>
+		void
+		evaluate (std::vector<T> const& t, std::vector<Point,Alloc> & P) const {
+			const std::vector<BGLgeom::point<dim,T>> Q = this->operator()(t);
+			P.resize(Q.size());
+			for(std::size_t i = 0; i < Q.size(); ++i)
+				P[i] = BGLgeom::convert_point<Point,dim>(Q[i]);
+		}
 }; //edge_geometry
 
 } //namespace
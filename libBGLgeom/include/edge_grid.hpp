@@ -0,0 +1,434 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	edge_grid.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Spatial index of the edges of a graph, to find the edges near a
+			segment without scanning all of them
+*/
+
+#ifndef HH_EDGE_GRID_HH
+#define HH_EDGE_GRID_HH
+
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+#include <boost/functional/hash.hpp>
+#include <boost/graph/adjacency_list.hpp>
+#include "point.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	Uniform grid over the bounding boxes of the edges of a graph
+
+	The space is divided in a uniform grid of cubic cells, and each edge is
+	stored in all the cells crossed by the segment (enlarged by the
+	tolerance used by the intersection of segments). Only the non-empty
+	cells are stored, in a hash table. The edges which may intersect a
+	segment are found visiting only the cells crossed by the segment, so
+	the cost does not depend on the number of edges of the graph. Visiting
+	only the crossed cells, and not all the ones of the bounding box, a
+	long edge takes a number of cells proportional to its length (and not
+	to its square, or cube in 3D): this matters for the few long fractures
+	of a set with a power-law distribution of the lengths.
+
+	If the size of the cells is not given, it is chosen as the average
+	size of the bounding boxes of the edges, and the grid is rebuilt each
+	time the number of edges doubles.
+
+	@note	The index has to be kept updated when the graph changes: the
+			functions new_linear_edge() and remove_edge() in graph_builder.hpp
+			taking an edge_grid as argument do this
+	@pre	The edge descriptors must stay valid when other edges are added or
+			removed, as in a boost::adjacency_list with boost::listS (the
+			default) as edge list
+
+	@param dim Dimension of the space
+	@param Edge Type of the edge descriptors. The default is the one of the
+				undirected boost::adjacency_list with boost::vecS containers,
+				so that the index can be put in the graph property
+*/
+template <unsigned int dim,
+		  typename Edge = typename boost::adjacency_list_traits<boost::vecS, boost::vecS, boost::undirectedS>::edge_descriptor>
+class edge_grid {
+
+	public:
+		using point = BGLgeom::point<dim>;
+
+		/*!
+			@brief	Constructor
+
+			@param _cell_size The size of the cells of the grid. If zero (the
+					default) it is chosen automatically from the edges
+		*/
+		edge_grid(double const& _cell_size = 0) :
+			cell_size(_cell_size), automatic(_cell_size <= 0), cells(), n_edges(0), next_seq(0), sum_size(0), n_rebuild(64) {};
+
+		/*!
+			@brief	Copy constructor: the copy is empty
+
+			The edge descriptors refer to the edges of the original graph, so
+			they are not copied: the index of the copy of a graph has to be
+			built again with build()
+		*/
+		edge_grid(edge_grid const& other) : edge_grid(other.automatic ? 0 : other.cell_size) {};
+
+		//! Move constructor
+		edge_grid(edge_grid &&) = default;
+
+		//! Assignment operator: as the copy constructor, the index is left empty
+		edge_grid &
+		operator=(edge_grid const& other){
+			if(this != &other){
+				automatic = other.automatic;
+				cell_size = other.cell_size;
+				this->clear();
+			}
+			return *this;
+		}
+
+		//! Move assignment
+		edge_grid & operator=(edge_grid &&) = default;
+
+		//! Destructor
+		virtual ~edge_grid() = default;
+
+		//! Size of the cells (zero if not chosen yet)
+		double get_cell_size() const { return cell_size; }
+
+		//! Number of edges in the index
+		std::size_t size() const { return n_edges; }
+
+		//! Number of non-empty cells
+		std::size_t num_cells() const { return cells.size(); }
+
+		//! Removes all the edges from the index
+		void
+		clear(){
+			cells.clear();
+			n_edges = 0;
+			next_seq = 0;
+			sum_size = 0;
+			n_rebuild = 64;
+			if(automatic)
+				cell_size = 0;
+		}
+
+		/*!
+			@brief	(Re)builds the index from all the edges of a graph
+
+			The edges are inserted in the order of boost::edges(G). Since all
+			the edges are known, the size of the cells (if automatic) is chosen
+			once from all of them, and the grid is filled without rebuilding it
+
+			@param G The graph, whose edge property contains a linear geometry
+		*/
+		template <typename Graph>
+		void
+		build(Graph const& G){
+			this->clear();
+			typename boost::graph_traits<Graph>::edge_iterator e_it, e_end;
+			std::vector<item> items;
+			items.reserve(boost::num_edges(G));
+			for(std::tie(e_it, e_end) = boost::edges(G); e_it != e_end; ++e_it)
+				items.push_back(this->make_item(*e_it, G[*e_it].geometry.get_source(), G[*e_it].geometry.get_target()));
+			this->fill(items);
+		}
+
+		/*!
+			@brief	(Re)builds the index from a list of segments
+
+			The "edge" of the i-th segment is its position i in the list, so
+			that Edge has to be an integer type (e.g. edge_grid<2,std::size_t>).
+			The size of the cells is chosen as in build(G)
+
+			@param S The segments, as linear_geometry<dim>
+		*/
+		template <typename Segment>
+		void
+		build_from_segments(std::vector<Segment> const& S){
+			this->clear();
+			std::vector<item> items;
+			items.reserve(S.size());
+			for(std::size_t i = 0; i < S.size(); ++i)
+				items.push_back(this->make_item(static_cast<Edge>(i), S[i].get_source(), S[i].get_target()));
+			this->fill(items);
+		}
+
+		//! Adds the edge e, with extremes P1 and P2, to the index
+		void
+		insert(Edge const& e, point const& P1, point const& P2){
+			item it = this->make_item(e, P1, P2);
+			++n_edges;
+			if(automatic && (cell_size <= 0 || n_edges >= n_rebuild))
+				this->rebuild();
+			this->insert_item(it);
+		}
+
+		/*!
+			@brief	Removes the edge e, with extremes P1 and P2, from the index
+
+			@return False if the edge was not in the index
+		*/
+		bool
+		erase(Edge const& e, point const& P1, point const& P2){
+			point lo = P1.cwiseMin(P2), hi = P1.cwiseMax(P2);
+			bool found = false;
+			this->for_each_cell(P1, P2, this->margin(lo, hi), [&](cell_key const& key){
+				auto c = cells.find(key);
+				if(c == cells.end())
+					return;
+				auto & bucket = c->second;
+				for(std::size_t i = 0; i < bucket.size(); ++i)
+					if(bucket[i].e == e){
+						bucket[i] = bucket.back();
+						bucket.pop_back();
+						found = true;
+						break;
+					}
+				if(bucket.empty())
+					cells.erase(c);
+			});
+			if(found){
+				--n_edges;
+				sum_size -= (hi - lo).maxCoeff();
+			}
+			return found;
+		}
+
+		/*!
+			@brief	Edges whose bounding box intersects the one of a segment
+
+			The bounding boxes are enlarged by the tolerance used by
+			compute_intersection(), so all the edges that may intersect the
+			segment are found. The edges are returned in the order in which
+			they have been inserted in the index, i.e. the order of
+			boost::edges(G) if all the edges have been added through the index.
+
+			@param P1 First extreme of the segment
+			@param P2 Second extreme of the segment
+			@param E (Output) The edges found
+		*/
+		void
+		candidates(point const& P1, point const& P2, std::vector<Edge> & E) const {
+			E.clear();
+			if(n_edges == 0)
+				return;
+			point lo = P1.cwiseMin(P2), hi = P1.cwiseMax(P2);
+			const double len = (P2 - P1).norm();
+			std::vector<item const*> found;
+			this->for_each_cell(P1, P2, this->margin(lo, hi), [&](cell_key const& key){
+				auto c = cells.find(key);
+				if(c == cells.end())
+					return;
+				for(item const& it : c->second){
+					// Same tolerance of compute_intersection()
+					point it_lo = it.P1.cwiseMin(it.P2), it_hi = it.P1.cwiseMax(it.P2);
+					const double m = TOL*std::max(len, (it_hi - it_lo).norm()) + TOL;
+					if(((it_lo.array() - m) <= hi.array()).all() && ((it_hi.array() + m) >= lo.array()).all())
+						found.push_back(&it);
+				}
+			});
+			std::sort(found.begin(), found.end(), [](item const* a, item const* b){ return a->seq < b->seq; });
+			found.erase(std::unique(found.begin(), found.end(), [](item const* a, item const* b){ return a->seq == b->seq; }), found.end());
+			E.reserve(found.size());
+			for(item const* it : found)
+				E.push_back(it->e);
+		}
+
+	private:
+		//! Integer coordinates of a cell
+		using cell_key = std::array<long long, dim>;
+
+		//! Hash function for the cells
+		struct cell_key_hash {
+			std::size_t
+			operator() (cell_key const& k) const { return boost::hash_range(k.begin(), k.end()); }
+		};
+
+		//! An edge in the index, with its extremes
+		struct item {
+			//! Order of insertion
+			std::size_t seq;
+			//! The edge
+			Edge e;
+			//! Extremes of the edge
+			point P1, P2;
+		};
+
+		//! Size of the cells
+		double cell_size;
+		//! True if the size of the cells is chosen automatically
+		bool automatic;
+		//! The non-empty cells, with the edges they contain
+		std::unordered_map<cell_key, std::vector<item>, cell_key_hash> cells;
+		//! Number of edges
+		std::size_t n_edges;
+		//! Order of insertion of the next edge
+		std::size_t next_seq;
+		//! Sum of the sizes of the bounding boxes of the edges
+		double sum_size;
+		//! Number of edges at which the grid is rebuilt (if automatic)
+		std::size_t n_rebuild;
+
+		//! Enlargement of a bounding box, larger than the tolerance of compute_intersection()
+		double
+		margin(point const& lo, point const& hi) const { return 2*TOL*((hi - lo).norm() + 1); }
+
+		//! Integer coordinate of the cell containing x
+		long long
+		coord_of(double const& x) const { return static_cast<long long>(std::floor(x / cell_size)); }
+
+		/*!
+			@brief	Calls f on all the cells intersecting the box [lo-m, hi+m],
+					except along the axis j0, where only the cell k0 is taken
+		*/
+		template <typename F>
+		void
+		for_each_cell_in_box(point const& lo, point const& hi, double const& m,
+							 std::size_t const& j0, long long const& k0, F const& f) const {
+			cell_key first, last, key;
+			for(std::size_t j = 0; j < dim; ++j){
+				first[j] = (j == j0 ? k0 : this->coord_of(lo(j) - m));
+				last[j] = (j == j0 ? k0 : this->coord_of(hi(j) + m));
+			}
+			key = first;
+			while(true){
+				f(key);
+				std::size_t j = 0;
+				while(j < dim && key[j] == last[j]){
+					key[j] = first[j];
+					++j;
+				}
+				if(j == dim)
+					break;
+				++key[j];
+			}
+		}
+
+		/*!
+			@brief	Calls f, once, on all the cells at distance less than m (along
+					each axis) from the segment P1-P2
+
+			The cells are visited in slices orthogonal to the axis along which
+			the segment is longest: in each slice only the cells near the
+			piece of the segment inside it are taken, so the number of cells
+			visited grows linearly with the length of the segment.
+		*/
+		template <typename F>
+		void
+		for_each_cell(point const& P1, point const& P2, double const& m, F const& f) const {
+			const point D = P2 - P1;
+			std::size_t j0;
+			D.cwiseAbs().maxCoeff(&j0);
+			const double lo0 = std::min(P1(j0), P2(j0)) - m, hi0 = std::max(P1(j0), P2(j0)) + m;
+			const long long first = this->coord_of(lo0), last = this->coord_of(hi0);
+			for(long long k = first; k <= last; ++k){
+				// Piece of the segment inside the slice k (enlarged by m), as range of the parameter
+				double a = std::max(k*cell_size - m, lo0), b = std::min((k+1)*cell_size + m, hi0);
+				double t_a = 0, t_b = 1;
+				if(D(j0) != 0){
+					t_a = std::min(std::max((a - P1(j0))/D(j0), 0.0), 1.0);
+					t_b = std::min(std::max((b - P1(j0))/D(j0), 0.0), 1.0);
+				}
+				const point Q1 = P1 + t_a*D, Q2 = P1 + t_b*D;
+				this->for_each_cell_in_box(Q1.cwiseMin(Q2), Q1.cwiseMax(Q2), m, j0, k, f);
+			}
+		}
+
+		//! Same as before, but f may modify the cells
+		template <typename F>
+		void
+		for_each_cell(point const& P1, point const& P2, double const& m, F const& f){
+			static_cast<edge_grid const*>(this)->for_each_cell(P1, P2, m, f);
+		}
+
+		//! Item for the edge e, with extremes P1 and P2 (it updates the sum of the sizes)
+		item
+		make_item(Edge const& e, point const& P1, point const& P2){
+			item it;
+			it.seq = next_seq++;
+			it.e = e;
+			it.P1 = P1;
+			it.P2 = P2;
+			sum_size += (P2 - P1).cwiseAbs().maxCoeff();
+			return it;
+		}
+
+		/*!
+			@brief	Fills the empty index with all the items at once
+
+			The size of the cells (if automatic) is chosen once from all of them,
+			and the grid is filled without rebuilding it
+		*/
+		void
+		fill(std::vector<item> const& items){
+			n_edges = items.size();
+			if(n_edges == 0)
+				return;
+			if(automatic){
+				cell_size = std::max(sum_size/n_edges, static_cast<double>(TOL)*1e3);
+				n_rebuild = std::max(2*n_edges, n_rebuild);
+			}
+			cells.reserve(n_edges);
+			for(item const& it : items)
+				this->insert_item(it);
+		}
+
+		//! Stores an item in all the cells crossed by its segment
+		void
+		insert_item(item const& it){
+			this->for_each_cell(it.P1, it.P2, this->margin(it.P1.cwiseMin(it.P2), it.P1.cwiseMax(it.P2)), [&](cell_key const& key){
+				cells[key].push_back(it);
+			});
+		}
+
+		//! Chooses the size of the cells from the edges, and redistributes them
+		void
+		rebuild(){
+			cell_size = std::max(sum_size/n_edges, static_cast<double>(TOL)*1e3);
+			n_rebuild = 2*n_edges;
+			// Each edge is stored in more cells: it is taken only once
+			std::vector<item> items;
+			items.reserve(n_edges);
+			for(auto const& c : cells)
+				for(item const& it : c.second)
+					items.push_back(it);
+			std::sort(items.begin(), items.end(), [](item const& a, item const& b){ return a.seq < b.seq; });
+			items.erase(std::unique(items.begin(), items.end(), [](item const& a, item const& b){ return a.seq == b.seq; }), items.end());
+			cells.clear();
+			for(item const& it : items)
+				this->insert_item(it);
+		}
+
+};	//edge_grid
+
+}	//BGLgeom
+
+#endif	//HH_EDGE_GRID_HH
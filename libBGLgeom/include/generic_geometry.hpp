@@ -40,9 +40,6 @@
 #include "edge_geometry.hpp"
 #include <Eigen/Dense>
 
-//! The tolerance on being zero
-#define tol_dist 1e-8
-
 namespace BGLgeom{
 
 /*!
@@ -55,21 +52,22 @@ namespace BGLgeom{
 	otherwise the program abort
 	
 	@param dim Dimension of the space	
+	@param T Scalar type of the coordinates and of the parameter
 */
-template<unsigned int dim>
-class generic_geometry : public BGLgeom::edge_geometry<dim> {
+template<unsigned int dim, typename T = double>
+class generic_geometry : public BGLgeom::edge_geometry<dim,T> {
 
-	using point = BGLgeom::point<dim>;
+	using point = BGLgeom::point<dim,T>;
 	using vect_pts = std::vector<point>;
-	using vect_double = std::vector<double>;
+	using vect_double = std::vector<T>;
 
 	private:
 		//! The analytic expression of the parameterization of the curve
-		std::function<point(double)> value_fun;
+		std::function<point(T)> value_fun;
 		//! The analytic expression of the first derivative of the curve
-		std::function<point(double)> first_der_fun;
+		std::function<point(T)> first_der_fun;
 		//! The analytic expression of the second derivative of the curve
-		std::function<point(double)> second_der_fun;
+		std::function<point(T)> second_der_fun;
 		
 	public:
 	
@@ -77,9 +75,9 @@ class generic_geometry : public BGLgeom::edge_geometry<dim> {
 		generic_geometry() : value_fun(), first_der_fun(), second_der_fun() {};
 	
 		//! Full constructor
-		generic_geometry(std::function<point(double)> const& value_,
-						 std::function<point(double)> const& first_der_,
-						 std::function<point(double)> const& second_der_) :
+		generic_geometry(std::function<point(T)> const& value_,
+						 std::function<point(T)> const& first_der_,
+						 std::function<point(T)> const& second_der_) :
 					 			 value_fun(value_),
 					 			 first_der_fun(first_der_),
 					 			 second_der_fun(second_der_) {};
@@ -104,37 +102,58 @@ class generic_geometry : public BGLgeom::edge_geometry<dim> {
 			@{		
 		*/
 		void
-		set_function(std::function<point(double)> const& _value_fun){
+		set_function(std::function<point(T)> const& _value_fun){
 			value_fun = _value_fun;
 		}
 			
 		void
-		set_first_der(std::function<point(double)> const& _first_der_fun){
+		set_first_der(std::function<point(T)> const& _first_der_fun){
 			first_der_fun = _first_der_fun;
 		}
 			
 		void
-		set_second_der(std::function<point(double)> const& _second_der_fun){
+		set_second_der(std::function<point(T)> const& _second_der_fun){
 			second_der_fun = _second_der_fun;
 		}
 		
 		void
-		set_all(std::function<point(double)> const& _value_fun,
-				std::function<point(double)> const& _first_der_fun,
-				std::function<point(double)> const& _second_der_fun){
+		set_all(std::function<point(T)> const& _value_fun,
+				std::function<point(T)> const& _first_der_fun,
+				std::function<point(T)> const& _second_der_fun){
 			value_fun = _value_fun;
 			first_der_fun = _first_der_fun;
 			second_der_fun = _second_der_fun;				 
 		}
+		
+		//! Setting the function from one of another scalar type (converting parameter and points)
+		template <typename U>
+		void
+		set_function(std::function<BGLgeom::point<dim,U>(U)> const& _value_fun){
+			value_fun = convert_fun(_value_fun);
+		}
+		
+		//! Setting the first derivative from one of another scalar type
+		template <typename U>
+		void
+		set_first_der(std::function<BGLgeom::point<dim,U>(U)> const& _first_der_fun){
+			first_der_fun = convert_fun(_first_der_fun);
+		}
+		
+		//! Setting the second derivative from one of another scalar type
+		template <typename U>
+		void
+		set_second_der(std::function<BGLgeom::point<dim,U>(U)> const& _second_der_fun){
+			second_der_fun = convert_fun(_second_der_fun);
+		}
 		/*! @} */
 		
 		//! Length of the curve
-		double length() { return this->curv_abs(1); }
-		double length() const { return this->curv_abs(1); }
+		T length() { return this->curv_abs(1); }
+		T length() const { return this->curv_abs(1); }
 		
 		//! Evaluation of the curve in a given value of the parameter
 		point
-		operator()(double const& t) const {
+		operator()(T const& t) const {
 			if(t < 0 || t > 1){
 				std::cerr << "generic_geometry::operator(): parameter value out of bounds" << std::endl;
 				exit(EXIT_FAILURE);
@@ -144,7 +163,7 @@ class generic_geometry : public BGLgeom::edge_geometry<dim> {
 		
 		//! Evaluation in a vector of parameters
 	  	vect_pts
-	  	operator() (const std::vector<double> &t) const	{
+	  	operator() (const vect_double &t) const	{
 	    	vect_pts Pts(t.size());
 	   		for(std::size_t i = 0; i < t.size(); ++i)
 	   			Pts[i] = this->operator()(t[i]);	   			
@@ -153,7 +172,7 @@ class generic_geometry : public BGLgeom::edge_geometry<dim> {
 		
 		//! Evaluation of the first derivative in a given value of the parameter
 		point
-		first_der(const double & t) const { 
+		first_der(const T & t) const { 
 			if(t < 0 || t > 1){
 				std::cerr << "generic_geometry::first_der(): parameter value out of bounds" << std::endl;
 				exit(EXIT_FAILURE);
@@ -172,7 +191,7 @@ class generic_geometry : public BGLgeom::edge_geometry<dim> {
 		
 		//! Evaluation of the second derivative in a given value of the parameter
 		point 
-		second_der(const double & t) const {
+		second_der(const T & t) const {
 			if(t < 0 || t > 1){
 				std::cerr << "generic_geometry::second_der(): parameter value out of bounds" << std::endl;
 				exit(EXIT_FAILURE);
@@ -189,17 +208,17 @@ class generic_geometry : public BGLgeom::edge_geometry<dim> {
 			return Sder;
 		}
 		
-		//! Evaluation of the curvilinear abscissa
-		double curv_abs(const double & t) const {
+		//! Evaluation of the curvilinear abscissa (the quadrature is in double)
+		T curv_abs(const T & t) const {
 			if(t < 0 || t > 1){
 				std::cerr << "generic_geometry::curv_abs(): parameter value out of bounds" << std::endl;
 				exit(EXIT_FAILURE);
 			}	
 			//lambda functions that returns the integrand function, i.e. norm(first_derivative(t))
 	  		auto abscissa_integrand = [&](double t) -> double{
-				return this -> first_der(t).norm();
+				return this -> first_der(static_cast<T>(t)).norm();
 	  		};
-	  		double retval = BGLgeom::integrate(abscissa_integrand,0,t);
+	  		T retval = static_cast<T>(BGLgeom::integrate(abscissa_integrand,0,t));
 	  		return retval;	  		
 		}
 		
@@ -213,17 +232,17 @@ class generic_geometry : public BGLgeom::edge_geometry<dim> {
 		}
 		
 		//! Evaluation of the curvature
-		double curvature(const double & t) const {
+		T curvature(const T & t) const {
 			if(t < 0 || t > 1){
 				std::cerr << "generic_geometry::curvature(): parameter value out of bounds" << std::endl;
 				exit(EXIT_FAILURE);
 			}
-			if( (this->first_der(t)).norm() < tol_dist )
+			if( (this->first_der(t)).norm() < BGLgeom::tolerance<T>::dist() )
 				return 0; // otherwise at the denominator I will have zero or very close to it
-			double numerator;
+			T numerator;
 			if(dim == 3){
 				// explicit computation of the determinant
-				Eigen::Matrix<double,1,3> tmp( (this->first_der(t)(0,0) * this->second_der(t)(0,1) -
+				Eigen::Matrix<T,1,3> tmp( (this->first_der(t)(0,0) * this->second_der(t)(0,1) -
 							 					this->first_der(t)(0,1) * this->second_der(t)(0,0)),
 							 				   (this->first_der(t)(0,2) * this->second_der(t)(0,0) -
 							 					this->first_der(t)(0,0) * this->second_der(t)(0,2)),
@@ -234,7 +253,7 @@ class generic_geometry : public BGLgeom::edge_geometry<dim> {
 				numerator = std::abs(this->first_der(t)(0,0) * this->second_der(t)(0,1) - 
 							 		 this->first_der(t)(0,1) * this->second_der(t)(0,0));
 			}
-			double denominator( ((this->first_der(t)).norm()) *
+			T denominator( ((this->first_der(t)).norm()) *
 								((this->first_der(t)).norm()) *
 								((this->first_der(t)).norm()) );
 			return numerator/denominator;
@@ -254,10 +273,18 @@ class generic_geometry : public BGLgeom::edge_geometry<dim> {
 			
 			It only tells the coordinates of its extremes. May be useful for debugging
 		*/
-		friend std::ostream & operator<<(std::ostream & out, generic_geometry<dim> const& edge) {
+		friend std::ostream & operator<<(std::ostream & out, generic_geometry const& edge) {
 			out << "(generic)\tSource: " << edge(0) << ", Target: " << edge(1);
 			return out;
 		}	
+	
+	private:
+		//! Wraps a function of another scalar type, converting the parameter and the point
+		template <typename U>
+		static std::function<point(T)>
+		convert_fun(std::function<BGLgeom::point<dim,U>(U)> const& fun){
+			return [fun](T t) -> point { return fun(static_cast<U>(t)).template cast<T>(); };
+		}
 
 }; //generic_geometry
 
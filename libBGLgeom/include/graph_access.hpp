@@ -39,6 +39,8 @@
 #ifndef HH_GRAPH_ACCESS_HH
 #define HH_GRAPH_ACCESS_HH
 
+#include <vector>
+#include <type_traits>
 #include <boost/graph/adjacency_list.hpp>
 
 namespace BGLgeom{
@@ -132,6 +134,100 @@ target(BGLgeom::Edge_desc<Graph> const& e, Graph const& G){
 }
 /*! @} */
 
+/*!
+	@defgroup	Vertex_storage	Vertex properties storing data outside the graph
+	
+	Some vertex properties (as Vertex_store_property, see 
+	coordinate_store.hpp) keep their data in an array outside the graph, 
+	indexed by vertex descriptor: a property object takes its place in the 
+	array only when it becomes a vertex, and the array has to follow the 
+	vertices when they are renumbered. The builders call vertex_added() 
+	after boost::add_vertex() and vertices_renumbered() after a 
+	renumbering; for all the other properties these do nothing.
+	@{
+*/
+//! Nothing to do when a usual property becomes the vertex v
+template <typename Graph, typename Vertex, typename Vertex_prop>
+void
+attach_vertex_storage(Graph &, Vertex const&, Vertex_prop const*) {}
+
+//! Nothing to do when the vertices with usual properties are renumbered
+template <typename Graph, typename Vertex_prop>
+void
+sort_vertex_storage(Graph &, Vertex_prop const*) {}
+
+//! To be called after boost::add_vertex(), with the new vertex v
+template <typename Graph>
+void
+vertex_added(Graph & G, BGLgeom::Vertex_desc<Graph> const& v){
+	using Vertex_prop = typename boost::vertex_bundle_type<Graph>::type;
+	attach_vertex_storage(G, v, static_cast<Vertex_prop const*>(nullptr));
+}	//vertex_added
+
+//! To be called after the vertices of the graph have been renumbered
+template <typename Graph>
+void
+vertices_renumbered(Graph & G){
+	using Vertex_prop = typename boost::vertex_bundle_type<Graph>::type;
+	sort_vertex_storage(G, static_cast<Vertex_prop const*>(nullptr));
+}	//vertices_renumbered
+/*! @} */
+
+/*!
+	@defgroup	Storage_reservation	Reserving the storage of a boost::adjacency_list
+	
+	boost::adjacency_list has no public way to reserve the vector of the 
+	vertices or the out-edge lists, so the builders adding many vertices 
+	and edges at once would reallocate them many times. These functions 
+	use its members m_vertices and out_edge_list(), which are public but 
+	not part of the documented interface of the BGL: this is the only 
+	place of the library using them. They are defined only for 
+	boost::adjacency_list with boost::vecS as container for the vertices.
+	@{
+*/
+namespace storage_detail{
+
+//! Reserves an out-edge list stored in a std::vector
+template <typename Graph>
+void
+reserve_out_edges(Graph & G, std::vector<std::size_t> const& degree, std::true_type){
+	for(std::size_t v = 0; v < degree.size() && v < boost::num_vertices(G); ++v)
+		if(degree[v] > 0)
+			G.out_edge_list(v).reserve(G.out_edge_list(v).size() + degree[v]);
+}
+
+//! The other containers for the out-edge lists cannot be reserved
+template <typename Graph>
+void
+reserve_out_edges(Graph &, std::vector<std::size_t> const&, std::false_type) {}
+
+}	//storage_detail
+
+//! Reserves the vector of the vertices of G for n vertices in total
+template <typename Graph>
+void
+reserve_vertices(Graph & G, std::size_t const& n){
+	static_assert(std::is_same<typename Graph::vertex_list_selector, boost::vecS>::value,
+				  "BGLgeom::reserve_vertices(): the graph must use boost::vecS as container for the vertices");
+	G.m_vertices.reserve(n);
+}	//reserve_vertices
+
+/*!
+	@brief	Reserves the out-edge list of each vertex v for degree[v] more edges
+
+	It does nothing if the out-edge lists are not stored in a std::vector
+	(i.e. the graph does not use boost::vecS as out-edge container)
+*/
+template <typename Graph>
+void
+reserve_out_edges(Graph & G, std::vector<std::size_t> const& degree){
+	static_assert(std::is_same<typename Graph::vertex_list_selector, boost::vecS>::value,
+				  "BGLgeom::reserve_out_edges(): the graph must use boost::vecS as container for the vertices");
+	storage_detail::reserve_out_edges(G, degree,
+		std::integral_constant<bool, std::is_same<typename Graph::out_edge_list_selector, boost::vecS>::value>());
+}	//reserve_out_edges
+/*! @} */
+
 }	//BGLgeom
 
 #endif	//HH_GRAPH_ACCESS_HH
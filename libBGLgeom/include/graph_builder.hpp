@@ -49,8 +49,13 @@
 
 #include "generic_geometry.hpp"
 #include "linear_geometry.hpp"
+#include "linear_view_geometry.hpp"
 #include "bspline_geometry.hpp"
+#include "polyline_geometry.hpp"
 #include "graph_access.hpp"
+#include "vertex_hash.hpp"
+#include "edge_grid.hpp"
+#include "cluster_tracker.hpp"
 
 namespace BGLgeom{
 
@@ -87,7 +92,9 @@ check_if_edge_inserted(bool const& inserted){
 template <typename Graph>
 BGLgeom::Vertex_desc<Graph>
 new_vertex(Graph & G){	
-	return boost::add_vertex(G);
+	BGLgeom::Vertex_desc<Graph> v = boost::add_vertex(G);
+	BGLgeom::vertex_added(G, v);
+	return v;
 }	//new_vertex
 
 /*!
@@ -110,7 +117,8 @@ new_vertex(Vertex_prop const& v_prop,
 	if(check_unique){	
 		BGLgeom::Vertex_iter<Graph> v_it,v_end;	
 		for(std::tie(v_it,v_end)=boost::vertices(G); v_it != v_end; ++v_it){
-			if(v_prop.coordinates == G[*v_it].coordinates){
+			// Explicit call, otherwise the exact Eigen::MatrixBase::operator== would be chosen
+			if(BGLgeom::operator==(v_prop.coordinates, G[*v_it].coordinates)){
 				#ifndef NDEBUG
 					std::cout << "Vertex already existing" << std::endl;	
 				#endif
@@ -122,9 +130,101 @@ new_vertex(Vertex_prop const& v_prop,
 	#ifndef NDEBUG
 		std::cout << "New vertex created" << std::endl;
 	#endif
-	return boost::add_vertex(v_prop,G);	
+	BGLgeom::Vertex_desc<Graph> v = boost::add_vertex(v_prop,G);
+	BGLgeom::vertex_added(G, v);
+	return v;
 }	//new_vertex
 
+/*!
+	@brief	Creates a new vertex in the graph with the given properties, 
+			using a spatial hash to check if it is already present
+
+	It does the same as the previous function, but the check on the 
+	coordinates is performed looking only at the vertices stored in the 
+	cells of the spatial hash near the new vertex, instead of scanning all 
+	the vertices of the graph. The new vertex is added to the spatial hash.
+
+	@pre	The spatial hash has to contain all the vertices of the graph
+	@param v_prop The properties to be assigned to the new vertex
+	@param G The graph where to insert the new vertex
+	@param H The spatial hash of the vertices of G
+	@param check_unique Boolean: set true if you want to check wheter the
+			coordinates of the vertex you want to insert are already present
+			in the graph. If false, the vertex is only added to the spatial hash
+	@return The vertex descriptor of the new vertex
+*/
+template <typename Graph, typename Vertex_prop, unsigned int dim>
+BGLgeom::Vertex_desc<Graph>
+new_vertex(Vertex_prop const& v_prop,
+		   Graph & G,
+		   BGLgeom::vertex_hash<dim> & H,
+		   const bool check_unique = true){
+	
+	std::size_t v;
+	if(check_unique && H.find(v_prop.coordinates, v)){
+		#ifndef NDEBUG
+			std::cout << "Vertex already existing" << std::endl;	
+		#endif
+		return v;
+	}
+	#ifndef NDEBUG
+		std::cout << "New vertex created" << std::endl;
+	#endif
+	v = boost::add_vertex(v_prop,G);
+	BGLgeom::vertex_added(G, v);
+	H.insert(v, G[v].coordinates);
+	return v;
+}	//new_vertex (with spatial hash)
+
+/*!
+	@brief	Adds a new vertex to the graph, to the spatial hash and to the
+			connected components
+	
+	As the previous function; a vertex actually created (not found in the
+	spatial hash) is also added to the cluster_tracker C as a new cluster
+	
+	@pre	The cluster_tracker has to contain all the vertices of the graph
+	@param C The connected components of G
+	@return The vertex descriptor of the new vertex
+*/
+template <typename Graph, typename Vertex_prop, unsigned int dim>
+BGLgeom::Vertex_desc<Graph>
+new_vertex(Vertex_prop const& v_prop,
+		   Graph & G,
+		   BGLgeom::vertex_hash<dim> & H,
+		   BGLgeom::cluster_tracker<dim> & C,
+		   const bool check_unique = true){
+	BGLgeom::Vertex_desc<Graph> v = new_vertex(v_prop, G, H, check_unique);
+	if(v == C.num_vertices())
+		C.add_vertex(v, G[v].coordinates);
+	return v;
+}	//new_vertex (with spatial hash and connected components)
+
+/*!
+	@brief	Removes a vertex from the graph, updating the spatial hash
+	
+	@pre	The vertex must have no incident edges (as for boost::remove_vertex)
+	@pre	The graph must use boost::vecS as container for the vertices
+	@remark	Since the vertices following the removed one are renumbered, 
+			the cost is linear in the number of vertices
+	
+	@param v The vertex to be removed
+	@param G The graph
+	@param H The spatial hash of the vertices of G
+*/
+template <typename Graph, unsigned int dim>
+void
+remove_vertex(BGLgeom::Vertex_desc<Graph> const& v,
+			  Graph & G,
+			  BGLgeom::vertex_hash<dim> & H){
+	H.erase(v, G[v].coordinates);
+	boost::remove_vertex(v, G);
+	H.renumber_after_removal(v);
+	#ifndef NDEBUG
+		std::cout << "Vertex removed" << std::endl;
+	#endif
+}	//remove_vertex
+
 /*!
 	@brief	Creates a new edge in the graph
 	
@@ -274,6 +374,185 @@ new_linear_edge	(BGLgeom::Vertex_desc<Graph> const& src,
 	return e;
 }	//new_linear_edge (with properties)
 
+/*!
+	@brief	Adds a new linear edge to the graph and to the spatial index of the edges
+	
+	As the previous function, but the new edge is also inserted in the
+	edge_grid I, so that it will be found by I.candidates()
+	
+	@pre	The spatial index has to contain all the edges of the graph
+	@param src Vertex descriptor for the source
+	@param tgt Vertex descriptor fot the target
+	@param E_prop The edge properties to be assigned to the edge
+	@param G The graph where to insert the new edge
+	@param I The spatial index of the edges of G
+	@return The edge descriptor of the new edge
+*/
+template <typename Graph, typename Edge_prop, unsigned int dim, typename Edge>
+BGLgeom::Edge_desc<Graph>
+new_linear_edge	(BGLgeom::Vertex_desc<Graph> const& src,
+				 BGLgeom::Vertex_desc<Graph> const& tgt,
+				 Edge_prop const & E_prop,
+				 Graph & G,
+				 BGLgeom::edge_grid<dim,Edge> & I){
+	BGLgeom::Edge_desc<Graph> e = new_linear_edge(src, tgt, E_prop, G);
+	I.insert(e, G[e].geometry.get_source(), G[e].geometry.get_target());
+	return e;
+}	//new_linear_edge (with spatial index)
+
+/*!
+	@brief	Adds a new linear edge to the graph, to the spatial index of the
+			edges and to the connected components
+	
+	As the previous function, but the clusters of the two extremes are
+	also joined in the cluster_tracker C, adding the length of the edge
+	
+	@pre	The cluster_tracker has to contain all the vertices and the edges of the graph
+	@param C The connected components of G
+	@return The edge descriptor of the new edge
+*/
+template <typename Graph, typename Edge_prop, unsigned int dim, typename Edge>
+BGLgeom::Edge_desc<Graph>
+new_linear_edge	(BGLgeom::Vertex_desc<Graph> const& src,
+				 BGLgeom::Vertex_desc<Graph> const& tgt,
+				 Edge_prop const & E_prop,
+				 Graph & G,
+				 BGLgeom::edge_grid<dim,Edge> & I,
+				 BGLgeom::cluster_tracker<dim> & C){
+	BGLgeom::Edge_desc<Graph> e = new_linear_edge(src, tgt, E_prop, G, I);
+	C.add_edge(src, tgt, G[e].geometry.get_source(), G[e].geometry.get_target());
+	return e;
+}	//new_linear_edge (with spatial index and connected components)
+
+/*!
+	@brief	Removes an edge from the graph, updating the spatial index of the edges
+	
+	@pre	The edge property has to contain a linear geometry, whose extremes
+			are the ones used when the edge was inserted in the index
+	
+	@param e The edge to be removed
+	@param G The graph
+	@param I The spatial index of the edges of G
+*/
+template <typename Graph, unsigned int dim, typename Edge>
+void
+remove_edge(BGLgeom::Edge_desc<Graph> const& e,
+			Graph & G,
+			BGLgeom::edge_grid<dim,Edge> & I){
+	I.erase(e, G[e].geometry.get_source(), G[e].geometry.get_target());
+	boost::remove_edge(e, G);
+	#ifndef NDEBUG
+		std::cout << "Edge removed" << std::endl;
+	#endif
+}	//remove_edge
+
+/*!
+	@brief	Removes an edge from the graph, updating the spatial index of the
+			edges and the connected components
+	
+	@pre	The extremes of the edge have to stay connected by the other
+			edges of the graph (e.g. the edge has already been replaced by
+			its pieces), since the clusters cannot be split
+	
+	@param e The edge to be removed
+	@param G The graph
+	@param I The spatial index of the edges of G
+	@param C The connected components of G
+*/
+template <typename Graph, unsigned int dim, typename Edge>
+void
+remove_edge(BGLgeom::Edge_desc<Graph> const& e,
+			Graph & G,
+			BGLgeom::edge_grid<dim,Edge> & I,
+			BGLgeom::cluster_tracker<dim> & C){
+	C.remove_edge(boost::source(e, G), boost::target(e, G), G[e].geometry.get_source(), G[e].geometry.get_target());
+	remove_edge(e, G, I);
+}	//remove_edge (with connected components)
+
+/*!
+	@brief	Adds a new linear edge which references the coordinates of its vertices
+	
+	@remark	Use this only when you set "linear_view_geometry<dim>" as template parameter of the
+			Edge_base_property
+			
+	It adds a new edge assuming that the underlying geometry is the linear view
+	one. The geometry only stores the indices of source and target and the map
+	through which it reads their coordinates, so that changing the coordinates
+	of a vertex is automatically seen by all the incident edges.
+	
+	@note 	It performs a check on the insertion of the edge
+	@pre	The graph must use boost::vecS as container for the vertices
+	@pre	Obviously the BGLgeom::Edge_base_property struct or derived is required 
+			as edge property of the graph
+	@remark	The same coordinate map (usually a graph_coordinate_map built on
+			G) can be shared by all the edges of the graph. It has to outlive them
+			
+	@param src Vertex descriptor for the source
+	@param tgt Vertex descriptor fot the target
+	@param M The map giving access to the coordinates of the vertices of G
+	@param G The graph where to insert the new edge
+	@return The edge descriptor of the new edge
+*/
+template <typename Graph, unsigned int dim>
+BGLgeom::Edge_desc<Graph>
+new_linear_view_edge(BGLgeom::Vertex_desc<Graph> const& src,
+					 BGLgeom::Vertex_desc<Graph> const& tgt,
+					 BGLgeom::vertex_coordinate_map<dim> const& M,
+					 Graph & G){
+	bool inserted;
+	BGLgeom::Edge_desc<Graph> e;
+	std::tie(e, inserted) = boost::add_edge(src, tgt, G);
+	check_if_edge_inserted(inserted);
+	
+	// Setting up the geometry
+	G[e].geometry.set_coordinate_map(M);
+	G[e].geometry.set_source(src);
+	G[e].geometry.set_target(tgt);
+	#ifndef NDEBUG
+		std::cout << "New edge created: " << G[e].geometry << std::endl;
+	#endif
+	return e;
+}	//new_linear_view_edge
+
+/*!
+	@brief	Adds a new linear edge which references the coordinates of its 
+			vertices and assigns its properties
+	
+	@remark	Use this only when you set "linear_view_geometry<dim>" as template parameter of the
+			Edge_base_property
+			
+	As the previous one, but it directly assigns the properties to the new 
+	edge, re-setting in any case the geometry.
+	
+	@param src Vertex descriptor for the source
+	@param tgt Vertex descriptor fot the target
+	@param E_prop The edge properties to be assigned to the edge
+	@param M The map giving access to the coordinates of the vertices of G
+	@param G The graph where to insert the new edge
+	@return The edge descriptor of the new edge
+*/
+template <typename Graph, typename Edge_prop, unsigned int dim>
+BGLgeom::Edge_desc<Graph>
+new_linear_view_edge(BGLgeom::Vertex_desc<Graph> const& src,
+					 BGLgeom::Vertex_desc<Graph> const& tgt,
+					 Edge_prop const & E_prop,
+					 BGLgeom::vertex_coordinate_map<dim> const& M,
+					 Graph & G){
+	bool inserted;
+	BGLgeom::Edge_desc<Graph> e;
+	std::tie(e, inserted) = boost::add_edge(src, tgt, E_prop, G);
+	check_if_edge_inserted(inserted);
+	
+	// Setting up the geometry
+	G[e].geometry.set_coordinate_map(M);
+	G[e].geometry.set_source(src);
+	G[e].geometry.set_target(tgt);
+	#ifndef NDEBUG
+		std::cout << "New edge created: " << G[e].geometry << std::endl;
+	#endif
+	return e;
+}	//new_linear_view_edge (with properties)
+
 /*!
 	@brief	Adding a new generic edge to the graph
 	
@@ -607,6 +886,201 @@ new_bspline_edge	(BGLgeom::Vertex_desc<Graph> const& src,
 	return e;				 
 }	//new_bspline_edge (with properties)
 
+/*!
+	@brief	Adding a new bspline edge fitting a polyline to the graph
+	
+	@remark	Use this only when you set "bspline_geometry<dim,deg>" as template parameter of the
+			Edge_base_property
+			
+	It adds a new edge assuming that the underlying geometry is the bspline one.
+	The bspline is built with the least squares fitting constructor, i.e. with
+	the minimal number of control points that keeps the curve within the
+	tolerance from the given polyline.
+	
+	@note 	It performs a check on the insertion of the edge
+	@note	It checks if the ends of the parameterization (t=0 and t=1) conincide with
+			the coordinates of source and vertex passed in the vertex descriptors. If not,
+			it displays a warning message in the screen
+	@pre	Obviously the BGLgeom::Edge_base_property struct or derived is required 
+			as edge property of the graph
+
+	@param src Vertex descriptor for the source
+	@param tgt Vertex descriptor fot the target
+	@param P The points of the polyline to be fitted
+	@param tol The tolerance on the distance between the bspline and the polyline
+	@param G The graph where to insert the new edge
+	@return The edge descriptor of the new edge
+*/
+template <typename Graph, unsigned int dim>
+BGLgeom::Edge_desc<Graph>
+new_bspline_edge	(BGLgeom::Vertex_desc<Graph> const& src,
+					 BGLgeom::Vertex_desc<Graph> const& tgt,
+					 std::vector<BGLgeom::point<dim>> const& P,
+					 double const& tol,
+					 Graph & G){
+	bool inserted;
+	BGLgeom::Edge_desc<Graph> e;	
+	std::tie(e, inserted) = boost::add_edge(src, tgt, G);
+	check_if_edge_inserted(inserted);
+	
+	// Setting up the geometry
+	G[e].geometry.set_bspline(P,tol);
+	
+	if(G[src].coordinates != P.front())
+		std::cerr << "WARNING: source coordinates " << G[src].coordinates 
+				<< " do not coincide with the parametrized function evaluated in t=0" << std::endl;
+	if(G[tgt].coordinates != P.back())
+		std::cerr << "WARNING: target coordinates " << G[tgt].coordinates
+				<< " do not coincide with the parametrized function evaluated in t=1" << std::endl;
+	
+	#ifndef NDEBUG
+		std::cout << "New edge created: " << G[e].geometry << std::endl;
+	#endif
+	return e;				 
+}	//new_bspline_edge (fitting)
+
+/*!
+	@brief	Adding a new bspline edge fitting a polyline to the graph and assigning its properties
+	
+	@remark	Use this only when you set "bspline_geometry<dim,deg>" as template parameter of the
+			Edge_base_property
+			
+	As the previous one, but it assigns directly the properties to the new edge
+	(the geometry is re-set also if it is already set)
+	
+	@param src 			Vertex descriptor for the source
+	@param tgt 			Vertex descriptor fot the target
+	@param E_prop 		The edge properties to be assigned to the edge
+	@param P 			The points of the polyline to be fitted
+	@param tol 			The tolerance on the distance between the bspline and the polyline
+	@param G 			The graph where to insert the new edge
+	@return 			The edge descriptor of the new edge
+*/
+template <typename Graph, typename Edge_prop, unsigned int dim>
+BGLgeom::Edge_desc<Graph>
+new_bspline_edge	(BGLgeom::Vertex_desc<Graph> const& src,
+					 BGLgeom::Vertex_desc<Graph> const& tgt,
+				 	 Edge_prop const& E_prop,
+					 std::vector<BGLgeom::point<dim>> const& P,
+					 double const& tol,
+					 Graph & G){
+	bool inserted;
+	BGLgeom::Edge_desc<Graph> e;	
+	std::tie(e, inserted) = boost::add_edge(src, tgt, E_prop, G);
+	check_if_edge_inserted(inserted);
+	
+	// Setting up the geometry
+	G[e].geometry.set_bspline(P,tol);
+	
+	if(G[src].coordinates != P.front())
+		std::cerr << "WARNING: source coordinates " << G[src].coordinates 
+				<< " do not coincide with the parametrized function evaluated in t=0" << std::endl;
+	if(G[tgt].coordinates != P.back())
+		std::cerr << "WARNING: target coordinates " << G[tgt].coordinates
+				<< " do not coincide with the parametrized function evaluated in t=1" << std::endl;
+	
+	#ifndef NDEBUG
+		std::cout << "New edge created: " << G[e].geometry << std::endl;
+	#endif
+	return e;				 
+}	//new_bspline_edge (fitting, with properties)
+
+/*!
+	@brief	Adding a new polyline edge to the graph
+	
+	@remark	Use this only when you set "polyline_geometry<dim>" as template parameter of the
+			Edge_base_property
+	
+	It adds a new edge assuming that the underlying geometry is the polyline one,
+	and sets up the geometry with the given points.
+	
+	@note 	It performs a check on the insertion of the edge
+	@note	It checks if the first and the last points of the polyline coincide with
+			the coordinates of source and target. If not, it displays a warning 
+			message in the screen
+	@pre	Obviously the BGLgeom::Edge_base_property struct or derived is required 
+			as edge property of the graph
+	@remark	Please, remember that this function leaves all the edge properties 
+			(but the geometry, that is correctly set up) to its default value. 
+			They have to be set in a following moment
+			
+	@param src Vertex descriptor for the source
+	@param tgt Vertex descriptor fot the target
+	@param P The ordered points of the polyline
+	@param G The graph where to insert the new edge
+	@return The edge descriptor of the new edge
+*/
+template <typename Graph, unsigned int dim>
+BGLgeom::Edge_desc<Graph>
+new_polyline_edge	(BGLgeom::Vertex_desc<Graph> const& src,
+					 BGLgeom::Vertex_desc<Graph> const& tgt,
+					 std::vector<BGLgeom::point<dim>> const& P,
+					 Graph & G){
+	bool inserted;
+	BGLgeom::Edge_desc<Graph> e;	
+	std::tie(e, inserted) = boost::add_edge(src, tgt, G);
+	check_if_edge_inserted(inserted);
+	
+	// Setting up the geometry
+	G[e].geometry.set_points(P);
+	
+	if(G[src].coordinates != P.front())
+		std::cerr << "WARNING: source coordinates " << G[src].coordinates 
+				<< " do not coincide with the first point of the polyline" << std::endl;
+	if(G[tgt].coordinates != P.back())
+		std::cerr << "WARNING: target coordinates " << G[tgt].coordinates
+				<< " do not coincide with the last point of the polyline" << std::endl;
+	
+	#ifndef NDEBUG
+		std::cout << "New edge created: " << G[e].geometry << std::endl;
+	#endif
+	return e;
+}	//new_polyline_edge
+
+/*!
+	@brief	Adding a new polyline edge to the graph and assigning its properties
+	
+	@remark	Use this only when you set "polyline_geometry<dim>" as template parameter of the
+			Edge_base_property
+	
+	As the previous one, but it assigns directly the properties to the new edge
+	(the geometry is re-set also if it is already set)
+			
+	@param src 			Vertex descriptor for the source
+	@param tgt 			Vertex descriptor fot the target
+	@param E_prop 		The edge properties to be assigned to the edge
+	@param P 			The ordered points of the polyline
+	@param G 			The graph where to insert the new edge
+	@return 			The edge descriptor of the new edge
+*/
+template <typename Graph, typename Edge_prop, unsigned int dim>
+BGLgeom::Edge_desc<Graph>
+new_polyline_edge	(BGLgeom::Vertex_desc<Graph> const& src,
+					 BGLgeom::Vertex_desc<Graph> const& tgt,
+					 Edge_prop const& E_prop,
+					 std::vector<BGLgeom::point<dim>> const& P,
+					 Graph & G){
+	bool inserted;
+	BGLgeom::Edge_desc<Graph> e;	
+	std::tie(e, inserted) = boost::add_edge(src, tgt, E_prop, G);
+	check_if_edge_inserted(inserted);
+	
+	// Setting up the geometry
+	G[e].geometry.set_points(P);
+	
+	if(G[src].coordinates != P.front())
+		std::cerr << "WARNING: source coordinates " << G[src].coordinates 
+				<< " do not coincide with the first point of the polyline" << std::endl;
+	if(G[tgt].coordinates != P.back())
+		std::cerr << "WARNING: target coordinates " << G[tgt].coordinates
+				<< " do not coincide with the last point of the polyline" << std::endl;
+	
+	#ifndef NDEBUG
+		std::cout << "New edge created: " << G[e].geometry << std::endl;
+	#endif
+	return e;
+}	//new_polyline_edge (with properties)
+
 }	//BGLgeom
 
 #endif	//HH_GRAPH_BUILDER_HH
@@ -0,0 +1,675 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	graph_snapshot.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Binary snapshot of a graph, with memory-mapped reload
+
+	A graph built from the input files (with the intersections computed and
+	the meshes created on the edges) can be saved in a binary file with
+	save_snapshot(), and reloaded without rebuilding it. The file can be
+	mapped in memory with a snapshot_view, which reads vertices, edges,
+	geometries and meshes directly from the file, without copying them:
+	opening a snapshot only costs the mapping of the file. load_snapshot()
+	builds again a modifiable graph from it.
+
+	The file is made of a header and four sections, all aligned to 8 bytes:
+	- the header, with a magic string, the version of the format, the
+	  dimension, the number of boundary conditions, the type of the edge
+	  geometry and the size of the sections; \n
+	- the vertices: index, label (position in the characters section); \n
+	- the edges: source, target, index, label, and position in the doubles
+	  section of the data of the geometry and of the mesh; \n
+	- the doubles: the coordinates of all the vertices, then their boundary
+	  conditions, then geometries and meshes of the edges; \n
+	- the characters of all the labels.
+
+	The numbers are stored in the native format of the machine: a snapshot
+	is meant to restart a computation on the same machine, not to exchange
+	data (use the ASCII writers for that).
+*/
+
+#ifndef HH_GRAPH_SNAPSHOT_HH
+#define HH_GRAPH_SNAPSHOT_HH
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <Eigen/Dense>
+#include <boost/graph/adjacency_list.hpp>
+#include "point.hpp"
+#include "graph_access.hpp"
+#include "boundary_conditions.hpp"
+#include "linear_geometry.hpp"
+#include "bspline_geometry.hpp"
+#include "polyline_geometry.hpp"
+#include "linear_view_geometry.hpp"
+
+namespace BGLgeom{
+
+//! Version of the snapshot format written by this library
+constexpr std::uint32_t snapshot_version = 1;
+
+//! Header of a snapshot file
+struct snapshot_header{
+	//! It has to be "BGLGSNAP"
+	char magic[8];
+	//! Version of the format
+	std::uint32_t version;
+	//! Dimension of the space
+	std::uint32_t dim;
+	//! Number of boundary conditions of each vertex
+	std::uint32_t num_bc;
+	//! Type of the edge geometry (see snapshot_geometry)
+	std::uint32_t geometry;
+	//! Number of vertices
+	std::uint64_t n_vertices;
+	//! Number of edges
+	std::uint64_t n_edges;
+	//! Size of the doubles section
+	std::uint64_t n_doubles;
+	//! Size of the characters section
+	std::uint64_t n_chars;
+};	//snapshot_header
+
+//! Record of a vertex in a snapshot file
+struct snapshot_vertex{
+	//! Index of the vertex
+	std::int64_t index;
+	//! Position of the label in the characters section
+	std::uint64_t label_off;
+	//! Length of the label
+	std::uint64_t label_len;
+};	//snapshot_vertex
+
+//! Record of an edge in a snapshot file
+struct snapshot_edge{
+	//! Source of the edge
+	std::uint64_t source;
+	//! Target of the edge
+	std::uint64_t target;
+	//! Index of the edge
+	std::int64_t index;
+	//! Position of the label in the characters section
+	std::uint64_t label_off;
+	//! Length of the label
+	std::uint64_t label_len;
+	//! Position of the data of the geometry in the doubles section
+	std::uint64_t geom_off;
+	//! Number of doubles describing the geometry
+	std::uint64_t geom_len;
+	//! Position of the mesh in the doubles section (real mesh, then parametric)
+	std::uint64_t mesh_off;
+	//! Number of points of the real mesh
+	std::uint64_t n_real;
+	//! Number of points of the parametric mesh
+	std::uint64_t n_param;
+};	//snapshot_edge
+
+/*!
+	@brief	Read-only mapping of a whole file in memory
+
+	The file is mapped with mmap, so its pages are loaded by the operating
+	system only when they are accessed. If the file cannot be opened or
+	mapped it gives an error and aborts the program.
+*/
+class mapped_file{
+	public:
+		//! Constructor: maps the file
+		mapped_file(std::string const& filename);
+
+		//! Copying a mapping is not allowed
+		mapped_file(mapped_file const&) = delete;
+
+		//! Move constructor
+		mapped_file(mapped_file && other);
+
+		//! Copying a mapping is not allowed
+		mapped_file & operator=(mapped_file const&) = delete;
+
+		//! Move assignment
+		mapped_file & operator=(mapped_file && other);
+
+		//! Destructor: unmaps the file
+		virtual ~mapped_file();
+
+		//! Beginning of the file in memory
+		char const* data() const { return ptr; }
+
+		//! Size of the file
+		std::size_t size() const { return len; }
+
+	private:
+		//! The mapped memory
+		char const* ptr;
+		//! Its size
+		std::size_t len;
+};	//mapped_file
+
+/*!
+	@brief	Conversion of an edge geometry to and from the doubles of a snapshot
+
+	It has to be specialized for each geometry: the specialization defines
+	a tag identifying the geometry in the file, a function appending the
+	data of a geometry to a vector of doubles, one checking that some
+	doubles read from a file describe a geometry, and one rebuilding the
+	geometry from them. It is not defined for generic_geometry, since a
+	std::function cannot be saved on file.
+
+	@param Geom The type of the geometry
+*/
+template <typename Geom>
+struct snapshot_geometry;
+
+//! Linear geometry: coordinates of source and target
+template <unsigned int dim>
+struct snapshot_geometry<BGLgeom::linear_geometry<dim>>{
+	static constexpr std::uint32_t tag = 1;
+
+	static void
+	write(BGLgeom::linear_geometry<dim> const& geom, std::vector<double> & out){
+		for(std::size_t i = 0; i < dim; ++i)
+			out.push_back(geom.get_source()(i));
+		for(std::size_t i = 0; i < dim; ++i)
+			out.push_back(geom.get_target()(i));
+	}
+
+	static bool
+	valid(double const*, std::size_t const& n){ return n == 2*dim; }
+
+	static BGLgeom::linear_geometry<dim>
+	read(double const* data, std::size_t const&){
+		return BGLgeom::linear_geometry<dim>(Eigen::Map<const BGLgeom::point<dim>>(data),
+											 Eigen::Map<const BGLgeom::point<dim>>(data + dim));
+	}
+};
+
+//! Polyline geometry: coordinates of its points
+template <unsigned int dim>
+struct snapshot_geometry<BGLgeom::polyline_geometry<dim>>{
+	static constexpr std::uint32_t tag = 2;
+
+	static void
+	write(BGLgeom::polyline_geometry<dim> const& geom, std::vector<double> & out){
+		for(std::size_t j = 0; j < geom.get_num_points(); ++j)
+			for(std::size_t i = 0; i < dim; ++i)
+				out.push_back(geom.get_point(j)(i));
+	}
+
+	static bool
+	valid(double const*, std::size_t const& n){ return n % dim == 0; }
+
+	static BGLgeom::polyline_geometry<dim>
+	read(double const* data, std::size_t const& n){
+		if(n == 0)
+			return BGLgeom::polyline_geometry<dim>();
+		std::vector<BGLgeom::point<dim>> P(n/dim);
+		for(std::size_t j = 0; j < P.size(); ++j)
+			P[j] = Eigen::Map<const BGLgeom::point<dim>>(data + j*dim);
+		return BGLgeom::polyline_geometry<dim>(P);
+	}
+};
+
+/*!
+	@brief	Linear view geometry: indices of source and target
+
+	@note	The vertex_coordinate_map has to be set again on the edges of
+			the reloaded graph with set_coordinate_map(G, M)
+*/
+template <unsigned int dim>
+struct snapshot_geometry<BGLgeom::linear_view_geometry<dim>>{
+	static constexpr std::uint32_t tag = 3;
+
+	static void
+	write(BGLgeom::linear_view_geometry<dim> const& geom, std::vector<double> & out){
+		out.push_back(static_cast<double>(geom.get_source_index()));
+		out.push_back(static_cast<double>(geom.get_target_index()));
+	}
+
+	static bool
+	valid(double const* data, std::size_t const& n){ return n == 2 && data[0] >= 0 && data[1] >= 0; }
+
+	static BGLgeom::linear_view_geometry<dim>
+	read(double const* data, std::size_t const&){
+		BGLgeom::linear_view_geometry<dim> geom;
+		geom.set_source(static_cast<std::size_t>(data[0]));
+		geom.set_target(static_cast<std::size_t>(data[1]));
+		return geom;
+	}
+};
+
+/*!
+	@brief	Bspline geometry: number of control points, control points and knots
+
+	A payload is valid only if the number of control points nc is an
+	integer and it is followed by nc control points and nc+deg+1 knots
+*/
+template <int dim, int deg>
+struct snapshot_geometry<BGLgeom::bspline_geometry<dim,deg>>{
+	static constexpr std::uint32_t tag = 16 + deg;
+
+	static void
+	write(BGLgeom::bspline_geometry<dim,deg> const& geom, std::vector<double> & out){
+		out.push_back(static_cast<double>(geom.get_num_control_points()));
+		for(BGLgeom::point<dim> const& P : geom.get_control_points())
+			for(std::size_t i = 0; i < dim; ++i)
+				out.push_back(P(i));
+		out.insert(out.end(), geom.get_knots().begin(), geom.get_knots().end());
+	}
+
+	static bool
+	valid(double const* data, std::size_t const& n){
+		if(n == 0 || !(data[0] >= 0) || data[0] > static_cast<double>(n) || std::floor(data[0]) != data[0])
+			return false;
+		std::size_t nc = static_cast<std::size_t>(data[0]);
+		return nc == 0 ? n == 1 : n == 1 + nc*dim + nc + deg + 1;
+	}
+
+	static BGLgeom::bspline_geometry<dim,deg>
+	read(double const* data, std::size_t const& n){
+		BGLgeom::bspline_geometry<dim,deg> geom;
+		std::size_t nc = static_cast<std::size_t>(data[0]);
+		if(nc == 0)
+			return geom;
+		std::vector<BGLgeom::point<dim>> C(nc);
+		for(std::size_t j = 0; j < nc; ++j)
+			C[j] = Eigen::Map<const BGLgeom::point<dim>>(data + 1 + j*dim);
+		std::vector<double> k(data + 1 + nc*dim, data + n);
+		geom.set_bspline(C, k);
+		return geom;
+	}
+};
+
+/*!
+	@brief	Saves a graph in a binary snapshot file
+
+	It saves, for each vertex, coordinates, boundary conditions, label and
+	index, and for each edge source, target, geometry, mesh (real and
+	parametric), label and index. The edges are saved in the order of
+	boost::edges(G).
+
+	@pre	The graph must use boost::vecS as container for the vertices, and
+			its properties must be (or derive from) Vertex_base_property and
+			Edge_base_property
+	@note	Only the members of the base properties are saved: additional
+			members of derived properties are not
+	@remark	As for the other functions of the library, the dimension has to be
+			given explicitly, e.g. save_snapshot<Graph,2>(G, "graph.snap")
+
+	@param G The graph
+	@param filename The name of the file
+*/
+template <typename Graph, unsigned int dim>
+void
+save_snapshot(Graph const& G, std::string const& filename){
+	using Vertex_prop = typename boost::vertex_bundle_type<Graph>::type;
+	using Edge_prop = typename boost::edge_bundle_type<Graph>::type;
+	using Geom = typename Edge_prop::geom_t;
+
+	const std::size_t n_v = boost::num_vertices(G);
+	const std::size_t n_bc = Vertex_prop().BC.size();
+	std::vector<snapshot_vertex> V(n_v);
+	std::vector<snapshot_edge> E;
+	E.reserve(boost::num_edges(G));
+	std::vector<double> D;
+	D.reserve(n_v*(dim + 2*n_bc));
+	std::string chars;
+
+	// Vertices: all the coordinates first, so that they are contiguous
+	for(std::size_t v = 0; v < n_v; ++v)
+		for(std::size_t i = 0; i < dim; ++i)
+			D.push_back(G[v].coordinates(i));
+	for(std::size_t v = 0; v < n_v; ++v){
+		for(std::size_t i = 0; i < n_bc; ++i){
+			D.push_back(static_cast<double>(G[v].BC[i].type));
+			D.push_back(G[v].BC[i].value);
+		}
+		V[v].index = G[v].index;
+		V[v].label_off = chars.size();
+		V[v].label_len = G[v].label.size();
+		chars += G[v].label;
+	}
+
+	// Edges
+	BGLgeom::Edge_iter<Graph> e_it, e_end;
+	for(std::tie(e_it, e_end) = boost::edges(G); e_it != e_end; ++e_it){
+		Edge_prop const& prop = G[*e_it];
+		snapshot_edge rec;
+		rec.source = boost::source(*e_it, G);
+		rec.target = boost::target(*e_it, G);
+		rec.index = prop.index;
+		rec.label_off = chars.size();
+		rec.label_len = prop.label.size();
+		chars += prop.label;
+		rec.geom_off = D.size();
+		BGLgeom::snapshot_geometry<Geom>::write(prop.geometry, D);
+		rec.geom_len = D.size() - rec.geom_off;
+		rec.mesh_off = D.size();
+		rec.n_real = prop.mesh.real.size();
+		rec.n_param = prop.mesh.parametric.size();
+		for(BGLgeom::point<dim> const& P : prop.mesh.real)
+			for(std::size_t i = 0; i < dim; ++i)
+				D.push_back(P(i));
+		D.insert(D.end(), prop.mesh.parametric.begin(), prop.mesh.parametric.end());
+		E.push_back(rec);
+	}
+
+	snapshot_header H;
+	std::memcpy(H.magic, "BGLGSNAP", 8);
+	H.version = BGLgeom::snapshot_version;
+	H.dim = dim;
+	H.num_bc = n_bc;
+	H.geometry = BGLgeom::snapshot_geometry<Geom>::tag;
+	H.n_vertices = n_v;
+	H.n_edges = E.size();
+	H.n_doubles = D.size();
+	H.n_chars = chars.size();
+
+	std::ofstream out(filename, std::ios::binary);
+	if(!out){
+		std::cerr << "ERROR! BGLgeom::save_snapshot(): cannot open file " << filename << std::endl;
+		std::cerr << "Aborting" << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	out.write(reinterpret_cast<char const*>(&H), sizeof(H));
+	out.write(reinterpret_cast<char const*>(V.data()), V.size()*sizeof(snapshot_vertex));
+	out.write(reinterpret_cast<char const*>(E.data()), E.size()*sizeof(snapshot_edge));
+	out.write(reinterpret_cast<char const*>(D.data()), D.size()*sizeof(double));
+	out.write(chars.data(), chars.size());
+	out.close();
+}	//save_snapshot
+
+/*!
+	@brief	Read-only view of a snapshot file mapped in memory
+
+	All the data are read directly from the mapped file: coordinates and
+	meshes are returned as Eigen::Map, without copies. The whole file is
+	checked when it is opened (see check()): if it is not a snapshot, if it
+	was written with a different version of the format or for a different
+	dimension, if it is truncated, or if a record refers to data outside
+	its section or to a vertex which does not exist, it gives an error and
+	aborts. The accessors can then use the records without further checks.
+
+	@param dim Dimension of the space
+*/
+template <unsigned int dim>
+class snapshot_view{
+	public:
+		using point_map = Eigen::Map<const BGLgeom::point<dim>>;
+		using points_map = Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, dim, (dim == 1 ? Eigen::ColMajor : Eigen::RowMajor)>>;
+		using doubles_map = Eigen::Map<const Eigen::VectorXd>;
+
+		//! Constructor: maps the file and checks it
+		snapshot_view(std::string const& filename) : file(filename), H(nullptr), V(nullptr), E(nullptr), D(nullptr), C(nullptr) {
+			std::string msg = check(file.data(), file.size());
+			if(!msg.empty())
+				this->fail(filename, msg);
+			H = reinterpret_cast<snapshot_header const*>(file.data());
+			V = reinterpret_cast<snapshot_vertex const*>(file.data() + sizeof(snapshot_header));
+			E = reinterpret_cast<snapshot_edge const*>(V + H->n_vertices);
+			D = reinterpret_cast<double const*>(E + H->n_edges);
+			C = reinterpret_cast<char const*>(D + H->n_doubles);
+		};
+
+		/*!
+			@brief	Checks the content of a snapshot file
+
+			It checks the header, the size of the file, and that each record
+			refers to characters and doubles inside their sections and to
+			existing vertices. It reads only the records, not the data.
+
+			@param data The content of the file
+			@param size The size of the file
+			@return	An empty string if the snapshot is valid, otherwise the
+					description of the first error found
+		*/
+		static std::string
+		check(char const* data, std::size_t const& size){
+			if(size < sizeof(snapshot_header))
+				return "file too short";
+			snapshot_header const* h = reinterpret_cast<snapshot_header const*>(data);
+			if(std::memcmp(h->magic, "BGLGSNAP", 8) != 0)
+				return "not a snapshot file";
+			if(h->version != BGLgeom::snapshot_version)
+				return "unsupported version " + std::to_string(h->version);
+			if(h->dim != dim)
+				return "dimension " + std::to_string(h->dim) + " instead of " + std::to_string(dim);
+			// The sizes of the sections, checked one by one to avoid overflows
+			std::size_t left = size - sizeof(snapshot_header);
+			if(h->n_vertices > left/sizeof(snapshot_vertex))
+				return "wrong size";
+			left -= h->n_vertices*sizeof(snapshot_vertex);
+			if(h->n_edges > left/sizeof(snapshot_edge))
+				return "wrong size";
+			left -= h->n_edges*sizeof(snapshot_edge);
+			if(h->n_doubles > left/sizeof(double))
+				return "wrong size";
+			left -= h->n_doubles*sizeof(double);
+			if(h->n_chars != left)
+				return "wrong size";
+			// Coordinates and boundary conditions of the vertices
+			if(h->n_vertices > 0 && dim + 2*static_cast<std::uint64_t>(h->num_bc) > h->n_doubles/h->n_vertices)
+				return "vertex data outside the doubles section";
+			// Records of the vertices and of the edges
+			snapshot_vertex const* v_rec = reinterpret_cast<snapshot_vertex const*>(data + sizeof(snapshot_header));
+			for(std::size_t v = 0; v < h->n_vertices; ++v)
+				if(!inside(v_rec[v].label_off, v_rec[v].label_len, h->n_chars))
+					return "label of vertex " + std::to_string(v) + " outside the characters section";
+			snapshot_edge const* e_rec = reinterpret_cast<snapshot_edge const*>(v_rec + h->n_vertices);
+			for(std::size_t i = 0; i < h->n_edges; ++i){
+				snapshot_edge const& e = e_rec[i];
+				if(e.source >= h->n_vertices || e.target >= h->n_vertices)
+					return "edge " + std::to_string(i) + " with an extreme which is not a vertex";
+				if(!inside(e.label_off, e.label_len, h->n_chars))
+					return "label of edge " + std::to_string(i) + " outside the characters section";
+				if(!inside(e.geom_off, e.geom_len, h->n_doubles))
+					return "geometry of edge " + std::to_string(i) + " outside the doubles section";
+				if(e.n_real > h->n_doubles/dim || !inside(e.mesh_off, dim*e.n_real, h->n_doubles)
+				   || !inside(e.mesh_off + dim*e.n_real, e.n_param, h->n_doubles))
+					return "mesh of edge " + std::to_string(i) + " outside the doubles section";
+			}
+			return std::string();
+		}
+
+		//! Move constructor
+		snapshot_view(snapshot_view &&) = default;
+
+		//! Destructor
+		virtual ~snapshot_view() = default;
+
+		//! The header of the file
+		snapshot_header const& header() const { return *H; }
+
+		//! Number of vertices
+		std::size_t num_vertices() const { return H->n_vertices; }
+
+		//! Number of edges
+		std::size_t num_edges() const { return H->n_edges; }
+
+		//! Number of boundary conditions of each vertex
+		std::size_t num_bc() const { return H->num_bc; }
+
+		//! Coordinates of vertex v
+		point_map coordinates(std::size_t const& v) const { return point_map(D + v*dim); }
+
+		//! Coordinates of all the vertices, as the rows of a matrix
+		points_map all_coordinates() const { return points_map(D, H->n_vertices, dim); }
+
+		//! i-th boundary condition of vertex v
+		BGLgeom::boundary_condition
+		BC(std::size_t const& v, std::size_t const& i = 0) const {
+			double const* bc = D + H->n_vertices*dim + 2*(v*H->num_bc + i);
+			return BGLgeom::boundary_condition(static_cast<BGLgeom::BC_type>(static_cast<int>(bc[0])), bc[1]);
+		}
+
+		//! Index of vertex v
+		int vertex_index(std::size_t const& v) const { return V[v].index; }
+
+		//! Label of vertex v
+		std::string vertex_label(std::size_t const& v) const { return std::string(C + V[v].label_off, V[v].label_len); }
+
+		//! Source of the i-th edge
+		std::size_t source(std::size_t const& i) const { return E[i].source; }
+
+		//! Target of the i-th edge
+		std::size_t target(std::size_t const& i) const { return E[i].target; }
+
+		//! Index of the i-th edge
+		int edge_index(std::size_t const& i) const { return E[i].index; }
+
+		//! Label of the i-th edge
+		std::string edge_label(std::size_t const& i) const { return std::string(C + E[i].label_off, E[i].label_len); }
+
+		/*!
+			@brief	Geometry of the i-th edge
+
+			@pre	Geom has to be the geometry the graph was saved with: if
+					not, it gives an error and aborts
+		*/
+		template <typename Geom>
+		Geom
+		geometry(std::size_t const& i) const {
+			if(H->geometry != BGLgeom::snapshot_geometry<Geom>::tag){
+				std::cerr << "ERROR! BGLgeom::snapshot_view::geometry(): the snapshot has a different edge geometry" << std::endl;
+				std::cerr << "Aborting" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			if(!BGLgeom::snapshot_geometry<Geom>::valid(D + E[i].geom_off, E[i].geom_len)){
+				std::cerr << "ERROR! BGLgeom::snapshot_view::geometry(): corrupted geometry of edge " << i << std::endl;
+				std::cerr << "Aborting" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			return BGLgeom::snapshot_geometry<Geom>::read(D + E[i].geom_off, E[i].geom_len);
+		}
+
+		//! Points of the real mesh of the i-th edge, as the rows of a matrix
+		points_map mesh_real(std::size_t const& i) const { return points_map(D + E[i].mesh_off, E[i].n_real, dim); }
+
+		//! Parametric mesh of the i-th edge
+		doubles_map
+		mesh_parametric(std::size_t const& i) const {
+			return doubles_map(D + E[i].mesh_off + dim*E[i].n_real, E[i].n_param);
+		}
+
+	private:
+		//! The mapped file
+		BGLgeom::mapped_file file;
+		//! The header
+		snapshot_header const* H;
+		//! The vertices section
+		snapshot_vertex const* V;
+		//! The edges section
+		snapshot_edge const* E;
+		//! The doubles section
+		double const* D;
+		//! The characters section
+		char const* C;
+
+		//! True if the range [off, off+len) is inside a section of the given size
+		static bool
+		inside(std::uint64_t const& off, std::uint64_t const& len, std::uint64_t const& section){
+			return len <= section && off <= section - len;
+		}
+
+		//! Error while opening the snapshot
+		void
+		fail(std::string const& filename, std::string const& msg) const {
+			std::cerr << "ERROR! BGLgeom::snapshot_view(): " << filename << ": " << msg << std::endl;
+			std::cerr << "Aborting" << std::endl;
+			exit(EXIT_FAILURE);
+		}
+};	//snapshot_view
+
+/*!
+	@brief	Builds a graph from a snapshot mapped in memory
+
+	The vertices keep their indices and the edges are added in the order
+	they were saved.
+
+	@pre	The graph must be empty and use boost::vecS as container for the
+			vertices; its edge geometry must be the one of the snapshot
+	@param S The snapshot
+	@param G The graph where to copy the snapshot
+*/
+template <typename Graph, unsigned int dim>
+void
+load_snapshot(BGLgeom::snapshot_view<dim> const& S, Graph & G){
+	using Vertex_prop = typename boost::vertex_bundle_type<Graph>::type;
+	using Edge_prop = typename boost::edge_bundle_type<Graph>::type;
+	using Geom = typename Edge_prop::geom_t;
+
+	BGLgeom::reserve_vertices(G, S.num_vertices());
+	for(std::size_t v = 0; v < S.num_vertices(); ++v){
+		Vertex_prop prop(S.coordinates(v));
+		//Default BCs are not assigned, so sparse storages (see sparse_bc) stay empty
+		for(std::size_t i = 0; i < prop.BC.size() && i < S.num_bc(); ++i)
+			if(S.BC(v, i).type != BGLgeom::BC_type::NONE || S.BC(v, i).value != 0.0)
+				prop.BC[i] = S.BC(v, i);
+		prop.index = S.vertex_index(v);
+		prop.label = S.vertex_label(v);
+		BGLgeom::vertex_added(G, boost::add_vertex(prop, G));
+	}
+	std::vector<std::size_t> degree(S.num_vertices(), 0);
+	for(std::size_t i = 0; i < S.num_edges(); ++i){
+		++degree[S.source(i)];
+		++degree[S.target(i)];
+	}
+	BGLgeom::reserve_out_edges(G, degree);
+	for(std::size_t i = 0; i < S.num_edges(); ++i){
+		Edge_prop prop;
+		prop.geometry = S.template geometry<Geom>(i);
+		auto real = S.mesh_real(i);
+		prop.mesh.real.resize(real.rows());
+		for(std::size_t j = 0; j < prop.mesh.real.size(); ++j)
+			prop.mesh.real[j] = real.row(j);
+		auto param = S.mesh_parametric(i);
+		prop.mesh.parametric.assign(param.data(), param.data() + param.size());
+		prop.index = S.edge_index(i);
+		prop.label = S.edge_label(i);
+		boost::add_edge(S.source(i), S.target(i), prop, G);
+	}
+}	//load_snapshot
+
+/*!
+	@brief	Builds a graph from a snapshot file
+
+	@param filename The name of the file
+	@param G The graph where to copy the snapshot (it must be empty)
+*/
+template <typename Graph, unsigned int dim>
+void
+load_snapshot(std::string const& filename, Graph & G){
+	BGLgeom::snapshot_view<dim> S(filename);
+	BGLgeom::load_snapshot<Graph,dim>(S, G);
+}	//load_snapshot (from file)
+
+}	//BGLgeom
+
+#endif	//HH_GRAPH_SNAPSHOT_HH
@@ -0,0 +1,247 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	half_edge_graph.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Half-edge (DCEL) representation of a planar graph
+
+	A fracture network, once all the intersections have been computed, is
+	a planar graph: the fractures divide the plane in polygonal blocks of
+	matrix. The adjacency_list does not know the order of the edges around
+	a vertex, so it cannot give the blocks. Here each edge is stored as
+	two opposite half-edges; each half-edge knows the next one along the
+	boundary of the face on its left, so the boundary of a face is
+	visited in time proportional to its length, and an edge is split in
+	constant time.
+*/
+
+#ifndef HH_HALF_EDGE_GRAPH_HH
+#define HH_HALF_EDGE_GRAPH_HH
+
+#include <vector>
+#include <utility>
+#include <limits>
+#include <boost/graph/adjacency_list.hpp>
+#include "point.hpp"
+#include "graph_access.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	A polygonal block bounded by the edges of a planar graph
+
+	The boundary is counterclockwise. An edge entering the block without
+	closing a cycle (e.g. a fracture ending inside the block) appears in
+	the boundary twice, once per side
+*/
+struct polygonal_block{
+	//! Face of the half_edge_graph
+	std::size_t face;
+	//! Vertices of the outer boundary, counterclockwise
+	std::vector<BGLgeom::point<2>> boundary;
+	//! Vertices of the boundaries of the holes (clusters of edges inside the block), clockwise
+	std::vector<std::vector<BGLgeom::point<2>>> holes;
+	//! Area, without the holes
+	double area;
+};	//polygonal_block
+
+/*!
+	@brief	Half-edge data structure (doubly connected edge list) of a plane graph
+
+	The edge e is made of the half-edges 2e, from its source to its target,
+	and 2e+1, from its target to its source, so the twin of h is h^1. The
+	half-edges leaving a vertex are ordered by angle, and next(h) is the
+	half-edge following h along the boundary of the face on its left: the
+	boundaries of the bounded faces are counterclockwise, while the outer
+	boundary of each connected component is clockwise (negative area).
+
+	The vertices and the edges keep the indices they had in the graph it
+	is built from; the ones added by split_edge() take the following
+	indices.
+
+	@pre	The graph must be embedded in the plane: the edges (straight
+			segments) can meet only at their extremes, as in the graphs
+			given by refine_graph or by the arrangement builders. There
+			must be no loops and no two edges with the same extremes
+*/
+class half_edge_graph{
+	public:
+		//! Index of vertices, half-edges, edges and faces
+		using index = std::size_t;
+		//! The null index (e.g. the half-edge leaving an isolated vertex)
+		static const index null = std::numeric_limits<index>::max();
+
+		//! Default constructor: empty graph
+		half_edge_graph() = default;
+
+		/*!
+			@brief	Builds the structure from a list of edges
+
+			@param P The coordinates of the vertices
+			@param E The edges, as (source, target) indices in P
+		*/
+		void build(std::vector<BGLgeom::point<2>> const& P, std::vector<std::pair<index,index>> const& E);
+
+		//! Number of vertices
+		std::size_t num_vertices() const { return coords.size(); }
+
+		//! Number of edges
+		std::size_t num_edges() const { return he.size()/2; }
+
+		//! Number of half-edges
+		std::size_t num_half_edges() const { return he.size(); }
+
+		//! Number of faces, counting the outer one of each connected component
+		std::size_t num_faces() const { return face_he.size(); }
+
+		//! Coordinates of a vertex
+		BGLgeom::point<2> const& coordinates(index const& v) const { return coords[v]; }
+
+		//! A half-edge leaving the vertex v (null if v is isolated)
+		index out_half_edge(index const& v) const { return out[v]; }
+
+		//! Vertex from which the half-edge starts
+		index origin(index const& h) const { return he[h].origin; }
+
+		//! Vertex at which the half-edge ends
+		index target(index const& h) const { return he[h^1].origin; }
+
+		//! The opposite half-edge
+		index twin(index const& h) const { return h^1; }
+
+		//! The following half-edge along the face on the left
+		index next(index const& h) const { return he[h].next; }
+
+		//! The previous half-edge along the face on the left
+		index prev(index const& h) const { return he[h].prev; }
+
+		//! The edge of the half-edge
+		index edge(index const& h) const { return h/2; }
+
+		//! The face on the left of the half-edge
+		index face(index const& h) const { return he[h].face; }
+
+		//! A half-edge on the boundary of the face
+		index face_half_edge(index const& f) const { return face_he[f]; }
+
+		/*!
+			@brief	Next half-edge leaving the same vertex, turning
+					clockwise (after the last one, the first one)
+		*/
+		index next_around(index const& h) const { return he[h^1].next; }
+
+		//! Signed area of the face (positive for bounded faces)
+		double face_area(index const& f) const;
+
+		//! Vertices of the boundary of the face, in order
+		std::vector<index> face_vertices(index const& f) const;
+
+		/*!
+			@brief	Splits an edge in a point
+
+			The edge e keeps its source, and ends at the new vertex; the new
+			edge goes from the new vertex to the old target of e. The faces do
+			not change. The cost is constant
+
+			@pre	P must be on the edge, between its extremes
+			@param e The edge
+			@param P The point
+			@return The new vertex (the new edge has index num_edges()-1)
+		*/
+		index split_edge(index const& e, BGLgeom::point<2> const& P);
+
+		/*!
+			@brief	The polygonal blocks: the bounded faces, with their holes
+
+			The clusters of edges not connected to the boundary of a face
+			and lying inside it are its holes. Each one is assigned to the
+			smallest face of the other components containing it, with a
+			point in polygon test on the faces whose bounding box contains
+			it
+
+			@return The blocks, in the order of the faces
+		*/
+		std::vector<BGLgeom::polygonal_block> blocks() const;
+
+	private:
+		//! A half-edge
+		struct half_edge{
+			//! Vertex from which it starts
+			index origin;
+			//! Following and previous half-edge along the face on the left
+			index next, prev;
+			//! Face on the left
+			index face;
+		};	//half_edge
+
+		//! Coordinates of the vertices
+		std::vector<BGLgeom::point<2>> coords;
+		//! A half-edge leaving each vertex
+		std::vector<index> out;
+		//! The half-edges
+		std::vector<half_edge> he;
+		//! A half-edge of each face
+		std::vector<index> face_he;
+
+		//! Assigns the faces, following the cycles of next()
+		void make_faces();
+};	//half_edge_graph
+
+/*!
+	@brief	Builds the half-edge structure of a graph
+
+	The vertices keep their index, and the edges take the index of their
+	position in boost::edges(G); the half-edge 2e goes from the source to
+	the target of the edge as in G.
+
+	@pre	The graph must have an internal vertex_index property (as the
+			adjacency_list with boost::vecS as vertex container), and the
+			vertex property must have the 2D coordinates (as
+			Vertex_base_property<2>). It must be embedded in the plane, as
+			in the precondition of half_edge_graph
+	@param G The graph
+	@return The half-edge structure
+*/
+template <typename Graph>
+BGLgeom::half_edge_graph
+make_half_edge_graph(Graph const& G){
+	auto index = boost::get(boost::vertex_index, G);
+	std::vector<BGLgeom::point<2>> P(boost::num_vertices(G));
+	BGLgeom::Vertex_iter<Graph> v_it, v_end;
+	for(std::tie(v_it, v_end) = boost::vertices(G); v_it != v_end; ++v_it)
+		P[index[*v_it]] = G[*v_it].coordinates;
+	std::vector<std::pair<std::size_t,std::size_t>> E;
+	E.reserve(boost::num_edges(G));
+	BGLgeom::Edge_iter<Graph> e_it, e_end;
+	for(std::tie(e_it, e_end) = boost::edges(G); e_it != e_end; ++e_it)
+		E.push_back(std::make_pair(index[boost::source(*e_it,G)], index[boost::target(*e_it,G)]));
+	BGLgeom::half_edge_graph H;
+	H.build(P, E);
+	return H;
+}	//make_half_edge_graph
+
+}	//BGLgeom
+
+#endif	//HH_HALF_EDGE_GRAPH_HH
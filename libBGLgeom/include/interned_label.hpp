@@ -0,0 +1,182 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	interned_label.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Labels stored once and referred to by an integer id
+*/
+
+#ifndef HH_INTERNED_LABEL_HH
+#define HH_INTERNED_LABEL_HH
+
+#include <iostream>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+
+namespace BGLgeom{
+
+/*!
+	@brief	The table of all the different labels
+
+	Each different string is stored only once, and it is identified by its
+	position in the table. The id 0 is the empty string. The strings are
+	never removed from the table, and they are kept in a std::deque, so the
+	references returned by str() stay valid when new strings are added.
+	The table is shared by all the threads: intern() and str() lock it.
+*/
+class label_pool{
+	public:
+		//! The table used by all the interned labels
+		static label_pool &
+		instance(){
+			static label_pool pool;
+			return pool;
+		}
+
+		//! Id of a string, adding it to the table if it is not there yet
+		std::uint32_t
+		intern(std::string const& s){
+			if(s.empty())
+				return 0;
+			std::lock_guard<std::mutex> lock(m);
+			auto it = ids.find(s);
+			if(it != ids.end())
+				return it->second;
+			std::uint32_t id = strings.size();
+			strings.push_back(s);
+			ids.emplace(s, id);
+			return id;
+		}
+
+		//! The string with the given id (the reference is never invalidated)
+		std::string const&
+		str(std::uint32_t const& id) const {
+			std::lock_guard<std::mutex> lock(m);
+			return strings[id];
+		}
+
+		//! Number of different strings (including the empty one)
+		std::size_t
+		size() const {
+			std::lock_guard<std::mutex> lock(m);
+			return strings.size();
+		}
+
+		//! Memory used by the table (approximately)
+		std::size_t
+		bytes() const {
+			std::lock_guard<std::mutex> lock(m);
+			std::size_t b = strings.size()*sizeof(std::string) + ids.bucket_count()*sizeof(void*);
+			for(std::string const& s : strings)
+				b += 2*(s.capacity() + 1) + sizeof(std::pair<const std::string, std::uint32_t>);
+			return b;
+		}
+
+	private:
+		//! The strings (a deque, so that they are never moved)
+		std::deque<std::string> strings;
+		//! The id of each string
+		std::unordered_map<std::string, std::uint32_t> ids;
+		//! Lock on the table, which may be used by more threads
+		mutable std::mutex m;
+
+		//! Constructor: the table contains only the empty string
+		label_pool() : strings(1), ids(), m() {};
+};	//label_pool
+
+/*!
+	@brief	A label stored in the label_pool
+
+	It occupies 4 bytes instead of the size of a std::string, and equal
+	labels are stored only once. It converts to a std::string, and it can
+	be assigned a std::string, so it can be used as the label members of
+	the properties of vertices and edges.
+*/
+class interned_label{
+	public:
+		//! Default constructor: empty label
+		interned_label() : id(0) {};
+
+		//! Constructor from a string
+		interned_label(std::string const& s) : id(label_pool::instance().intern(s)) {};
+
+		//! Constructor from a C string
+		interned_label(const char* s) : id(label_pool::instance().intern(std::string(s))) {};
+
+		//! Assignment from a string
+		interned_label &
+		operator=(std::string const& s){
+			id = label_pool::instance().intern(s);
+			return *this;
+		}
+
+		//! Assignment from a C string
+		interned_label &
+		operator=(const char* s){
+			id = label_pool::instance().intern(std::string(s));
+			return *this;
+		}
+
+		//! The string
+		std::string const& str() const { return label_pool::instance().str(id); }
+
+		//! Conversion to string
+		operator std::string const&() const { return this->str(); }
+
+		//! Id of the label in the pool
+		std::uint32_t get_id() const { return id; }
+
+		//! True if the label is empty
+		bool empty() const { return id == 0; }
+
+		//! Length of the label
+		std::size_t size() const { return this->str().size(); }
+
+		//! Comparison between labels
+		friend bool operator==(interned_label const& a, interned_label const& b) { return a.id == b.id; }
+
+		//! Comparison between labels
+		friend bool operator!=(interned_label const& a, interned_label const& b) { return a.id != b.id; }
+
+		//! Comparison with a string
+		friend bool operator==(interned_label const& a, std::string const& b) { return a.str() == b; }
+
+		//! Comparison with a string
+		friend bool operator!=(interned_label const& a, std::string const& b) { return a.str() != b; }
+
+		//! Overload of operator<<
+		friend std::ostream & operator<<(std::ostream & out, interned_label const& l) { return out << l.str(); }
+
+	private:
+		//! Position of the string in the pool
+		std::uint32_t id;
+};	//interned_label
+
+}	//BGLgeom
+
+#endif	//HH_INTERNED_LABEL_HH
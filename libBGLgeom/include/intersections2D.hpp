@@ -234,6 +234,9 @@ struct Intersection {
 			different way: the tolerance tol to test the parametric coordinate
 			along the edge line and a scaled tolerance to check distances.
 			Another scaled tolerance is used to test if edges are parallel.
+			If with the tolerances the situation is not consistent (it 
+			would be Something_went_wrong), the intersection is computed 
+			by compute_intersection_exact
 
 	@pre The edges must have non null length
 	@par S1 First Edge
@@ -242,6 +245,68 @@ struct Intersection {
 */
 Intersection compute_intersection(linear_geometry<2> const& edge1,
 								  linear_geometry<2> const& edge2);
+
+/*!
+	@brief Computes intersection betweeen two edges, without tolerances
+	
+	The situation is found with exact orientation tests (see orient2d), 
+	so it is always consistent: two extremes are coincident only if they 
+	are exactly equal, an extreme lies on the other edge only if it is 
+	exactly on it, and so on. The result is given as in compute_intersection, 
+	with the same types of intersection; the intersection point of an X is 
+	computed in floating point
+	
+	@pre The edges must have non null length
+	@par S1 First Edge
+	@par S2 Second Edge
+	@return Intersection. A data structure containing the info about the intersection
+*/
+Intersection compute_intersection_exact(linear_geometry<2> const& edge1,
+										linear_geometry<2> const& edge2);
+
+/*!
+	@brief Computes intersection betweeen two edges given by their extremes
+
+	The extremes can be any Eigen object with at least two coordinates: 
+	points of another scalar type, padded points (see point.hpp), or maps
+	on the coordinates stored elsewhere. The first two coordinates are 
+	converted to double, which is exact for float, and the intersection 
+	is computed as in the version for linear_geometry<2>. So the result, 
+	and the intersection points, are in double
+	
+	@param A1 Source of the first edge
+	@param B1 Target of the first edge
+	@param A2 Source of the second edge
+	@param B2 Target of the second edge
+*/
+template <typename D1, typename D2, typename D3, typename D4>
+Intersection compute_intersection(Eigen::MatrixBase<D1> const& A1, Eigen::MatrixBase<D2> const& B1,
+								  Eigen::MatrixBase<D3> const& A2, Eigen::MatrixBase<D4> const& B2){
+	return compute_intersection(linear_geometry<2>(A1.template head<2>().template cast<double>(), B1.template head<2>().template cast<double>()),
+								linear_geometry<2>(A2.template head<2>().template cast<double>(), B2.template head<2>().template cast<double>()));
+}
+
+//! Computes intersection betweeen two edges given by their extremes, without tolerances (see above)
+template <typename D1, typename D2, typename D3, typename D4>
+Intersection compute_intersection_exact(Eigen::MatrixBase<D1> const& A1, Eigen::MatrixBase<D2> const& B1,
+										Eigen::MatrixBase<D3> const& A2, Eigen::MatrixBase<D4> const& B2){
+	return compute_intersection_exact(linear_geometry<2>(A1.template head<2>().template cast<double>(), B1.template head<2>().template cast<double>()),
+									  linear_geometry<2>(A2.template head<2>().template cast<double>(), B2.template head<2>().template cast<double>()));
+}
+
+//! Computes intersection betweeen two edges of another scalar type (the result is in double, see above)
+template <typename T>
+Intersection compute_intersection(linear_geometry<2,T> const& edge1,
+								  linear_geometry<2,T> const& edge2){
+	return compute_intersection(edge1.get_source(), edge1.get_target(), edge2.get_source(), edge2.get_target());
+}
+
+//! Computes intersection betweeen two edges of another scalar type, without tolerances (see above)
+template <typename T>
+Intersection compute_intersection_exact(linear_geometry<2,T> const& edge1,
+										linear_geometry<2,T> const& edge2){
+	return compute_intersection_exact(edge1.get_source(), edge1.get_target(), edge2.get_source(), edge2.get_target());
+}
                            		
 //! Overload of operator<< to show the infos obtained by the function
 std::ostream & operator<< (std::ostream & out, Intersection const& I);
@@ -47,20 +47,21 @@ namespace BGLgeom{
 	It is parametrized between 0 and 1
 	
 	@param dim Dimension of the space
+	@param T Scalar type of the coordinates and of the parameter
 */
-template <unsigned int dim>
-class linear_geometry : public BGLgeom::edge_geometry<dim> {
+template <unsigned int dim, typename T = double>
+class linear_geometry : public BGLgeom::edge_geometry<dim,T> {
 		
 	private:
 		//! Coordinates of the source of the edge
-		BGLgeom::point<dim> SRC;
+		BGLgeom::point<dim,T> SRC;
 		//! Coordinates of the target of the edge
-		BGLgeom::point<dim> TGT;
+		BGLgeom::point<dim,T> TGT;
 
 	public:
-		using point = BGLgeom::point<dim>;
+		using point = BGLgeom::point<dim,T>;
 		using vect_pts = std::vector<point>;
-		using vect_double = std::vector<double>;
+		using vect_double = std::vector<T>;
 		
 		//! Default constructor 
 		linear_geometry() : SRC(), TGT() {};	
@@ -83,13 +84,15 @@ class linear_geometry : public BGLgeom::edge_geometry<dim> {
 		//! Move assignment
 		linear_geometry & operator=(linear_geometry &&) = default;
 		
-		//! Sets the value for the source
+		//! Sets the value for the source (converting its coordinates to T)
+		template <typename Derived>
 		void
-		set_source(point const& SRC_) { SRC = SRC_; }
+		set_source(Eigen::MatrixBase<Derived> const& SRC_) { SRC = SRC_.template cast<T>(); }
 		
-		//! Sets the value for the target
+		//! Sets the value for the target (converting its coordinates to T)
+		template <typename Derived>
 		void
-		set_target(point const& TGT_) {	TGT = TGT_;	}
+		set_target(Eigen::MatrixBase<Derived> const& TGT_) {	TGT = TGT_.template cast<T>();	}
 		
 		//! Getting source's coordinates
 		point get_source() { return SRC; }
@@ -100,8 +103,8 @@ class linear_geometry : public BGLgeom::edge_geometry<dim> {
 		point get_target() const { return TGT; }
 		
 		//! Computing the length of the edge
-		double length() { return (TGT-SRC).norm(); }
-		double length() const { return (TGT-SRC).norm(); }
+		T length() { return (TGT-SRC).norm(); }
+		T length() const { return (TGT-SRC).norm(); }
 	 
 	    /*! 
 	    	@brief	Evaluates the line at a given value of the parameter
@@ -110,7 +113,7 @@ class linear_geometry : public BGLgeom::edge_geometry<dim> {
 	    	a warning on std::cerr and abort the program
 	    */
 		point
-		operator() (double const& t) const {
+		operator() (T const& t) const {
 			if(t > 1 || t < 0){
 				std::cerr << "linear_geometry::operator(): parameter value out of bounds" << std::endl;
 				exit(EXIT_FAILURE);
@@ -126,10 +129,33 @@ class linear_geometry : public BGLgeom::edge_geometry<dim> {
    				P_vect[i] = this->operator()(t[i]); //(TGT-SRC)*t[i] + SRC;   			
    		 	return P_vect;
   		}
+
+		/*!
+			@brief	Padded batch evaluation of the line in a vector of values of the parameter
+			
+			Same as operator(), but the points are of type Point stored with 
+			allocator Alloc: with padded_point (see point.hpp) the evaluation 
+			is vectorized. It is used to build the meshes with other types of 
+			points (see padded_mesh in mesh.hpp)
+		*/
+		template <typename Point, typename Alloc>
+		void
+		evaluate(vect_double const& t, std::vector<Point,Alloc> & P_vect) const {
+			const Point S = BGLgeom::convert_point<Point,dim>(SRC);
+			const Point D = BGLgeom::convert_point<Point,dim>(TGT) - S;
+			P_vect.resize(t.size());
+			for(std::size_t i = 0; i < t.size(); ++i){
+				if(t[i] > 1 || t[i] < 0){
+					std::cerr << "linear_geometry::evaluate(): parameter value out of bounds" << std::endl;
+					exit(EXIT_FAILURE);
+				}
+				P_vect[i] = D*static_cast<typename Point::Scalar>(t[i]) + S;
+			}
+		}
 		
 		//! Evaluates the first derivative of the line
 		point 
-		first_der(double const& t = 0) const { return TGT-SRC; }
+		first_der(T const& t = 0) const { return TGT-SRC; }
 		
 		//! Evaluates the first derivatives in a vector of values of the parameter
 		vect_pts
@@ -142,7 +168,7 @@ class linear_geometry : public BGLgeom::edge_geometry<dim> {
 		
 		//! Evaluates the second derivative of the line (of course returns zero!)
 		point
-		second_der(const double & t = 0) const { return point::Zero(); }
+		second_der(const T & t = 0) const { return point::Zero(); }
 		
 		//! Evaluates the second derivative of the line in a vector of parameters
 		vect_pts
@@ -158,8 +184,8 @@ class linear_geometry : public BGLgeom::edge_geometry<dim> {
 	    	
 			@param t Value of the parameter (between 0 and 1) where to evaluate the curvilinear abscissa
 		*/
-		double
-		curv_abs(const double & t) const {
+		T
+		curv_abs(const T & t) const {
 			if(t < 0 || t > 1){
 				std::cerr << "linear_geometry::curv_abs(): parameter value out of bounds" << std::endl;
 				exit(EXIT_FAILURE);
@@ -177,13 +203,13 @@ class linear_geometry : public BGLgeom::edge_geometry<dim> {
 		}
 		
 		//! Evaluates the curvature of the line (of course zero again!)
-		double
-		curvature(const double & x) const { return 0; }
+		T
+		curvature(const T & x) const { return 0; }
 		
 		//! Evaluates the curvature of the line in a vector of parameters
 		vect_double
 		curvature(vect_double const& t) const {
-			return vect_double(t.size(),0.0);
+			return vect_double(t.size(),0);
 		}
 		
 		/*!
@@ -191,7 +217,7 @@ class linear_geometry : public BGLgeom::edge_geometry<dim> {
 			
 			It only tells the coordinates of its extremes. May be useful for debugging
 		*/
-		friend std::ostream & operator<<(std::ostream & out, linear_geometry<dim> const& edge) {
+		friend std::ostream & operator<<(std::ostream & out, linear_geometry const& edge) {
 			out << "(linear)\tSource: " << edge.SRC << ", Target: " << edge.TGT;
 			return out;
 		}
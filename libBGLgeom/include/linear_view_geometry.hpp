@@ -0,0 +1,342 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	linear_view_geometry.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Linear geometry on an edge which reads the coordinates of its
+			extremes from the vertices of the graph
+*/
+
+#ifndef HH_LINEAR_VIEW_GEOMETRY_HH
+#define HH_LINEAR_VIEW_GEOMETRY_HH
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <Eigen/Dense>
+#include <tuple>
+#include <boost/graph/adjacency_list.hpp>
+#include "point.hpp"
+#include "edge_geometry.hpp"
+#include "linear_geometry.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	Abstract access to the coordinates of the vertices
+
+	It is the way a linear_view_geometry reaches the coordinates of its
+	extremes, without knowing the type of the graph they belong to.
+
+	@param dim Dimension of the space
+*/
+template <unsigned int dim>
+class vertex_coordinate_map {
+	public:
+		//! Coordinates of the vertex with index v
+		virtual BGLgeom::point<dim>
+		operator() (std::size_t const& v) const = 0;
+
+		//! Destructor
+		virtual ~vertex_coordinate_map() = default;
+};	//vertex_coordinate_map
+
+/*!
+	@brief	Access to the coordinates of the vertices of a graph
+
+	It reads the coordinates stored in the vertex property of the graph
+	(as BGLgeom::Vertex_base_property does), so it always sees the current
+	position of the vertices.
+
+	@pre	The vertex descriptors of the graph have to be indices, i.e. the
+			graph must use boost::vecS as container for the vertices
+	@warning	It stores the address of the graph: the graph must not be
+				moved or destroyed while the map is in use. A copy of the
+				graph needs its own map (see linear_view_geometry)
+
+	@param Graph The type of the graph
+	@param dim Dimension of the space
+*/
+template <typename Graph, unsigned int dim>
+class graph_coordinate_map : public vertex_coordinate_map<dim> {
+	private:
+		//! The graph whose coordinates are read
+		Graph const* G;
+
+	public:
+		//! Constructor
+		graph_coordinate_map(Graph const& _G) : G(&_G) {};
+
+		//! Coordinates of the vertex with index v
+		BGLgeom::point<dim>
+		operator() (std::size_t const& v) const { return (*G)[v].coordinates; }
+};	//graph_coordinate_map
+
+/*!
+	@brief	The class handling a linear geometry whose extremes are vertices of a graph
+
+	It behaves as linear_geometry (it is parametrized between 0 and 1),
+	but instead of a copy of the coordinates of source and target it
+	only stores their vertex indices, together with a pointer to a
+	vertex_coordinate_map shared by all the edges of the graph. This
+	avoids duplicating the coordinates of each vertex on all its incident
+	edges, and moving a vertex (i.e. changing its coordinates in the
+	vertex property) automatically updates all the incident edges.
+
+	The map belongs to the graph, not to the edge: a copy of the geometry
+	keeps the indices but has no map, and the assignment of a geometry
+	changes the indices but keeps the map. In this way the edges of a copy
+	of the graph (boost::adjacency_list copies the edge properties) never
+	read the coordinates of the original graph: their map has to be set
+	with set_coordinate_map(G, M), and reading their coordinates before
+	gives an error.
+
+	@note	The mesh possibly created on the edge is a copy of the points,
+			so it has to be rebuilt if a vertex is moved
+	@warning	Since the extremes are referenced by index, removing vertices
+				from a graph with boost::vecS as vertex container (that
+				renumbers the vertices) invalidates the geometry
+
+	@param dim Dimension of the space
+*/
+template <unsigned int dim>
+class linear_view_geometry : public BGLgeom::edge_geometry<dim> {
+
+	private:
+		//! Access to the coordinates of the vertices
+		vertex_coordinate_map<dim> const* coords;
+		//! Index of the source of the edge
+		std::size_t SRC;
+		//! Index of the target of the edge
+		std::size_t TGT;
+
+	public:
+		using point = BGLgeom::point<dim>;
+		using vect_pts = std::vector<point>;
+		using vect_double = std::vector<double>;
+
+		//! Default constructor
+		linear_view_geometry() : coords(nullptr), SRC(0), TGT(0) {};
+
+		//! Constructor
+		linear_view_geometry(vertex_coordinate_map<dim> const& _coords,
+							 std::size_t const& SRC_,
+							 std::size_t const& TGT_) : coords(&_coords), SRC(SRC_), TGT(TGT_) {};
+
+		//! Copy constructor: it copies the indices, not the map (see above)
+		linear_view_geometry(linear_view_geometry const& other) : coords(nullptr), SRC(other.SRC), TGT(other.TGT) {};
+
+		//! Move constructor
+		linear_view_geometry(linear_view_geometry &&) = default;
+
+		//! Destructor
+		virtual ~linear_view_geometry() = default;
+
+		//! Assignment operator: it copies the indices, and keeps the map of this edge
+		linear_view_geometry &
+		operator=(linear_view_geometry const& other){
+			SRC = other.SRC;
+			TGT = other.TGT;
+			return *this;
+		}
+
+		//! Move assignment: as the assignment operator
+		linear_view_geometry &
+		operator=(linear_view_geometry && other){
+			return *this = static_cast<linear_view_geometry const&>(other);
+		}
+
+		//! Sets the map used to access the coordinates of the vertices
+		void
+		set_coordinate_map(vertex_coordinate_map<dim> const& _coords) { coords = &_coords; }
+
+		//! Sets the index of the source
+		void
+		set_source(std::size_t const& SRC_) { SRC = SRC_; }
+
+		//! Sets the index of the target
+		void
+		set_target(std::size_t const& TGT_) { TGT = TGT_; }
+
+		//! Getting source's index
+		std::size_t get_source_index() const { return SRC; }
+
+		//! Getting target's index
+		std::size_t get_target_index() const { return TGT; }
+
+		//! True if the map used to access the coordinates of the vertices is set
+		bool has_coordinate_map() const { return coords != nullptr; }
+
+		//! Getting source's coordinates
+		point get_source() const { return this->map()(SRC); }
+
+		//! Getting target's coordinates
+		point get_target() const { return this->map()(TGT); }
+
+		//! Computing the length of the edge
+		double length() const { return (this->get_target() - this->get_source()).norm(); }
+
+		//! Conversion to a linear_geometry owning a copy of the coordinates of the extremes
+		operator BGLgeom::linear_geometry<dim>() const {
+			return BGLgeom::linear_geometry<dim>(this->get_source(), this->get_target());
+		}
+
+		/*!
+	    	@brief	Evaluates the line at a given value of the parameter
+
+	    	It tests if the given parameter belongs to [0,1]. If not, it gives
+	    	a warning on std::cerr and abort the program
+	    */
+		point
+		operator() (double const& t) const {
+			if(t > 1 || t < 0){
+				std::cerr << "linear_view_geometry::operator(): parameter value out of bounds" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			point S = this->get_source();
+			return point((this->get_target()-S)*t+S);
+		};
+
+  		//! It evaluates the line in a vector of values of the parameter
+  		vect_pts
+  		operator() (vect_double const& t) const {
+  			point S = this->get_source();
+  			point D = this->get_target() - S;
+    		vect_pts P_vect(t.size());
+   			for (std::size_t i = 0; i < t.size(); ++i){
+   				if(t[i] > 1 || t[i] < 0){
+					std::cerr << "linear_view_geometry::operator(): parameter value out of bounds" << std::endl;
+					exit(EXIT_FAILURE);
+				}
+   				P_vect[i] = D*t[i] + S;
+   			}
+   		 	return P_vect;
+  		}
+
+		//! Evaluates the first derivative of the line
+		point
+		first_der(double const& t = 0) const { return this->get_target() - this->get_source(); }
+
+		//! Evaluates the first derivatives in a vector of values of the parameter
+		vect_pts
+		first_der(vect_double const& t) const {
+			return vect_pts(t.size(), this->first_der());
+		}
+
+		//! Evaluates the second derivative of the line (of course returns zero!)
+		point
+		second_der(const double & t = 0) const { return point::Zero(); }
+
+		//! Evaluates the second derivative of the line in a vector of parameters
+		vect_pts
+		second_der(vect_double const& t) const {
+			return vect_pts(t.size(), point::Zero());
+		}
+
+		/*!
+			@brief Curvilinear abscissa.
+
+			It tests if the given parameter belongs to [0,1]. If not, it gives
+	    	a warning on std::cerr and abort the program
+
+			@param t Value of the parameter (between 0 and 1) where to evaluate the curvilinear abscissa
+		*/
+		double
+		curv_abs(const double & t) const {
+			if(t < 0 || t > 1){
+				std::cerr << "linear_view_geometry::curv_abs(): parameter value out of bounds" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			return this->length() * t;
+		}
+
+		//! Evaluates the cuvilinear abscissa in a vector of parameters
+		vect_double
+		curv_abs(vect_double const& t) const {
+			vect_double C(t.size());
+			for(std::size_t i = 0; i < t.size(); ++i)
+				C[i] = this->curv_abs(t[i]);
+			return C;
+		}
+
+		//! Evaluates the curvature of the line (of course zero again!)
+		double
+		curvature(const double & x) const { return 0; }
+
+		//! Evaluates the curvature of the line in a vector of parameters
+		vect_double
+		curvature(vect_double const& t) const {
+			return vect_double(t.size(),0.0);
+		}
+
+		/*!
+			@brief	Overload of operator<<
+
+			It tells the indices and the coordinates of its extremes (if the
+			map is set). May be useful for debugging
+		*/
+		friend std::ostream & operator<<(std::ostream & out, linear_view_geometry<dim> const& edge) {
+			if(!edge.coords)
+				return out << "(linear view)\tSource: " << edge.SRC << ", Target: " << edge.TGT << " (no coordinate map)";
+			out << "(linear view)\tSource: " << edge.SRC << " (" << edge.get_source()
+				<< "), Target: " << edge.TGT << " (" << edge.get_target() << ")";
+			return out;
+		}
+
+	private:
+		//! The map, giving an error and aborting if it is not set
+		vertex_coordinate_map<dim> const&
+		map() const {
+			if(!coords){
+				std::cerr << "ERROR! linear_view_geometry: the coordinate map is not set (copied edge?), use set_coordinate_map()" << std::endl;
+				std::cerr << "Aborting" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			return *coords;
+		}
+
+}; //linear_view_geometry
+
+/*!
+	@brief	Sets the map used to access the coordinates of the vertices on
+			all the edges of a graph with linear_view_geometry
+
+	It is needed after copying a graph (or loading it from a snapshot),
+	since the copied edges have no map.
+
+	@param G The graph
+	@param M The map giving access to the coordinates of the vertices of G
+*/
+template <typename Graph, unsigned int dim>
+void
+set_coordinate_map(Graph & G, vertex_coordinate_map<dim> const& M){
+	typename boost::graph_traits<Graph>::edge_iterator e_it, e_end;
+	for(std::tie(e_it, e_end) = boost::edges(G); e_it != e_end; ++e_it)
+		G[*e_it].geometry.set_coordinate_map(M);
+}	//set_coordinate_map
+
+} //BGLgeom
+
+#endif	//HH_LINEAR_VIEW_GEOMETRY_HH
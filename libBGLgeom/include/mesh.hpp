@@ -36,6 +36,8 @@
 #include <memory>
 #include <iostream>
 #include <cstdlib>
+#include <type_traits>
+#include <utility>
 #include "mesh_generators.hpp"
 #include "point.hpp"
 
@@ -50,12 +52,16 @@ namespace BGLgeom{
 	
 	@param Geom The geometry of the edge
 	@param dim The dimension of the space
+	@param T The scalar type of the points and of the parametric mesh
+	@param Point The type of the real points (for instance padded_point, see 
+				 padded_mesh); it must have at least dim coordinates of type T
+	@param Alloc The allocator of the real points
 */
-template <unsigned int dim>
+template <unsigned int dim, typename T = double, typename Point = BGLgeom::point<dim,T>, typename Alloc = std::allocator<Point>>
 struct mesh{
 	// Aliases
-	using vect_pts = std::vector<BGLgeom::point<dim>>;
-	using vect = std::vector<double>;
+	using vect_pts = std::vector<Point,Alloc>;
+	using vect = std::vector<T>;
 
 	//! The vector containing the real mesh, the coordinates of the points in the space
 	vect_pts real;
@@ -128,7 +134,8 @@ struct mesh{
 	void
 	uniform_mesh(unsigned int const& n, std::function<vect_pts(vect const&)> const& eval ) {
 		BGLgeom::Mesh1D temp_mesh(BGLgeom::Domain1D(0,1), n);
-		parametric = temp_mesh.getMesh();
+		std::vector<double> const& temp_param = temp_mesh.getMesh();
+		parametric.assign(temp_param.begin(), temp_param.end());
 		real = eval(parametric);
 	}
 	
@@ -146,10 +153,64 @@ struct mesh{
 					std::function<double(double)> const& spacing_function,
 					std::function<vect_pts(vect const&)> const& eval){
 		BGLgeom::Mesh1D temp_mesh(BGLgeom::Domain1D(0,1), n, spacing_function);
-		parametric= temp_mesh.getMesh();
+		std::vector<double> const& temp_param = temp_mesh.getMesh();
+		parametric.assign(temp_param.begin(), temp_param.end());
 		real = eval(parametric);
 	}
 };	//mesh
+
+/*!
+	@brief	Announces that the mesh is going to be read soon
+
+	The writers call it on the next edge while they are writing the current
+	one. A mesh in memory has nothing to prepare: the overload for meshes
+	stored on file (see mesh_arena.hpp) starts loading them
+*/
+template <unsigned int dim, typename T, typename Point, typename Alloc>
+inline void
+prefetch_mesh(mesh<dim,T,Point,Alloc> const&) {}
+
+/*!
+	@brief	Alias template for a mesh whose real points are padded_point
+	
+	The points are stored in an aligned_vector and evaluated with the 
+	vectorized evaluate() of the geometries (see point.hpp). The writers 
+	and the other users of the meshes only read the first dim coordinates
+*/
+template <unsigned int dim, typename T = double>
+using padded_mesh = BGLgeom::mesh<dim, T, BGLgeom::padded_point<dim,T>, Eigen::aligned_allocator<BGLgeom::padded_point<dim,T>>>;
+
+//! Evaluator of a geometry that already returns the points of the mesh
+template <typename Mesh, typename Geom>
+inline std::function<typename Mesh::vect_pts(typename Mesh::vect const&)>
+mesh_evaluator(Geom const& geom, std::true_type){
+	return std::cref(geom);
+}
+
+//! Evaluator of a geometry that returns other points: they are built with evaluate()
+template <typename Mesh, typename Geom>
+inline std::function<typename Mesh::vect_pts(typename Mesh::vect const&)>
+mesh_evaluator(Geom const& geom, std::false_type){
+	return [&geom](typename Mesh::vect const& t){
+		typename Mesh::vect_pts P;
+		geom.evaluate(t, P);
+		return P;
+	};
+}
+
+/*!
+	@brief	Function used by the meshes of type Mesh to evaluate the geometry
+	
+	If the geometry returns the same vector of points of the mesh it is the
+	geometry itself, otherwise the points are built by its evaluate() method
+	(for instance for padded_mesh). The geometry must outlive the function
+*/
+template <typename Mesh, typename Geom>
+inline std::function<typename Mesh::vect_pts(typename Mesh::vect const&)>
+mesh_evaluator(Geom const& geom){
+	using geom_pts = decltype(geom(std::declval<typename Mesh::vect const&>()));
+	return mesh_evaluator<Mesh>(geom, std::is_same<typename Mesh::vect_pts, geom_pts>());
+}
  
 }	//BGLgeom
 
@@ -0,0 +1,463 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	mesh_arena.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Storage of the meshes of the edges in a file mapped in memory
+
+	For very large networks the meshes on the edges may not fit in memory.
+	With these classes the graph (vertices, edges, geometries) stays in
+	memory, while the points of the meshes are written in a file and mapped
+	in memory only when they are read, within a memory budget: when the
+	budget is exceeded, the parts of the file used least recently are
+	unmapped. To use it, give arena_mesh<dim> as third template parameter
+	of Edge_base_property, create a mesh_arena<dim> and make it the current
+	one before creating the meshes:
+	\code
+	using Edge_prop = BGLgeom::Edge_base_property<BGLgeom::linear_geometry<3>, 3, BGLgeom::arena_mesh<3>>;
+	BGLgeom::mesh_arena<3> arena("meshes.arena", 256 << 20);
+	arena.make_current();
+	G[e].make_uniform_mesh(100);
+	\endcode
+	The writers read the meshes as usual, and ask the arena to load in
+	advance the mesh of the next edge while writing the current one.
+
+	@note	Only the meshes go out of core: the geometries of the edges (as
+			the control points and knots of a bspline_geometry, or the
+			points of a polyline_geometry) stay in memory with the graph
+*/
+
+#ifndef HH_MESH_ARENA_HH
+#define HH_MESH_ARENA_HH
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <iterator>
+#include <functional>
+#include <cstdlib>
+#include <Eigen/Dense>
+#include "point.hpp"
+#include "mesh.hpp"
+#include "mesh_generators.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	File where data are appended, read through memory mappings
+
+	The file is divided in chunks (4 MiB by default). Each block of data
+	appended to the file lies in a single chunk, or, if it is larger than a
+	chunk, in consecutive chunks not shared with other blocks: so each block
+	belongs to one segment of the file (a chunk, or the chunks of a large
+	block), which is mapped as a whole when the block is read. The segments
+	mapped at the same time do not exceed the given budget: the least
+	recently used ones are unmapped to make room for new ones.
+
+	@warning	The pointers returned by access() are valid only until the
+				next call to access() or prefetch(), which may unmap them
+*/
+class arena_file{
+	public:
+		/*!
+			@brief	Constructor: creates the file (overwriting it if it exists)
+
+			@param filename The name of the file
+			@param budget Maximum number of bytes mapped at the same time
+			@param chunk_size Size of the chunks of the file (rounded up to the page size)
+			@param remove If true the file is deleted by the destructor
+		*/
+		arena_file(std::string const& filename,
+				   std::size_t const& budget,
+				   std::size_t const& chunk_size = std::size_t(1) << 22,
+				   bool const& remove = true);
+
+		//! Copying an arena is not allowed
+		arena_file(arena_file const&) = delete;
+
+		//! Copying an arena is not allowed
+		arena_file & operator=(arena_file const&) = delete;
+
+		//! Destructor: unmaps everything and closes (and possibly deletes) the file
+		virtual ~arena_file();
+
+		/*!
+			@brief	Appends a block of data to the file
+
+			@return The position of the block in the file
+		*/
+		std::size_t
+		append(void const* data, std::size_t const& bytes);
+
+		/*!
+			@brief	Access to a block of data appended to the file
+
+			It maps the segment containing the block, if it is not mapped yet
+			(unmapping the least recently used segments if needed)
+
+			@param offset The position of the block, as returned by append()
+			@param bytes The size of the block
+			@return Pointer to the block in memory
+		*/
+		char const*
+		access(std::size_t const& offset, std::size_t const& bytes);
+
+		/*!
+			@brief	Announces that a block of data is going to be read soon
+
+			It maps its segment and asks the operating system to start reading
+			it from the disk, without waiting for it
+		*/
+		void
+		prefetch(std::size_t const& offset, std::size_t const& bytes);
+
+		//! Size of the data in the file
+		std::size_t size() const { return end; }
+
+		//! Number of bytes currently mapped
+		std::size_t mapped_bytes() const { return mapped; }
+
+		//! Number of segments mapped since the creation of the arena
+		std::size_t num_mappings() const { return n_mappings; }
+
+		//! Memory budget
+		std::size_t get_budget() const { return budget; }
+
+	private:
+		//! A mapped segment
+		struct segment{
+			//! Beginning of the mapping
+			char* ptr;
+			//! Size of the mapping
+			std::size_t len;
+			//! Position in the list of the segments, ordered by use
+			std::list<std::size_t>::iterator lru_pos;
+		};
+
+		//! The name of the file
+		std::string filename;
+		//! The file descriptor
+		int fd;
+		//! Memory budget
+		std::size_t budget;
+		//! Size of the chunks
+		std::size_t chunk;
+		//! If the file has to be deleted at the end
+		bool remove_file;
+		//! End of the data in the file
+		std::size_t end;
+		//! Bytes currently mapped
+		std::size_t mapped;
+		//! Total number of mappings
+		std::size_t n_mappings;
+		//! Mapped segments, by first chunk
+		std::unordered_map<std::size_t, segment> segments;
+		//! First chunks of the mapped segments, from the most recently used
+		std::list<std::size_t> lru;
+		//! Last segment accessed (to avoid looking for it again)
+		std::size_t last_first;
+		//! Its mapping
+		char* last_ptr;
+		//! Its position in the list of the segments ordered by use
+		std::list<std::size_t>::iterator last_pos;
+
+		//! Maps (or finds) the segment containing the given block
+		segment &
+		map_segment(std::size_t const& offset, std::size_t const& bytes);
+};	//arena_file
+
+//! Position of a mesh in a mesh_arena
+struct arena_handle{
+	//! Position of the block in the file
+	std::size_t offset;
+	//! Size of the block
+	std::size_t bytes;
+	//! Number of points of the real mesh
+	std::size_t n_real;
+	//! Number of values of the parametric mesh
+	std::size_t n_param;
+};	//arena_handle
+
+/*!
+	@brief	Arena storing the meshes of the edges of a graph
+
+	Each mesh is stored as a block with the coordinates of the points of
+	the real mesh followed by the values of the parametric mesh.
+
+	@param dim Dimension of the space
+*/
+template <unsigned int dim>
+class mesh_arena : public arena_file{
+	public:
+		using point = BGLgeom::point<dim>;
+		using vect_pts = std::vector<point>;
+		using vect = std::vector<double>;
+
+		//! Constructor (see arena_file)
+		mesh_arena(std::string const& filename,
+				   std::size_t const& budget,
+				   std::size_t const& chunk_size = std::size_t(1) << 22,
+				   bool const& remove = true) : arena_file(filename, budget, chunk_size, remove) {};
+
+		//! Destructor
+		virtual ~mesh_arena(){
+			if(current() == this)
+				current() = nullptr;
+		}
+
+		//! Stores a mesh in the file
+		arena_handle
+		store(vect_pts const& real, vect const& parametric){
+			std::vector<double> buf;
+			buf.reserve(real.size()*dim + parametric.size());
+			for(point const& P : real)
+				for(std::size_t i = 0; i < dim; ++i)
+					buf.push_back(P(i));
+			buf.insert(buf.end(), parametric.begin(), parametric.end());
+			arena_handle h;
+			h.bytes = buf.size()*sizeof(double);
+			h.offset = (h.bytes > 0 ? this->append(buf.data(), h.bytes) : 0);
+			h.n_real = real.size();
+			h.n_param = parametric.size();
+			return h;
+		}
+
+		//! Values of a stored mesh (coordinates of the real mesh, then the parametric one)
+		double const*
+		values(arena_handle const& h){
+			return reinterpret_cast<double const*>(this->access(h.offset, h.bytes));
+		}
+
+		//! Makes this the arena where the new meshes of arena_mesh are stored
+		void
+		make_current() { current() = this; }
+
+		//! The arena where the new meshes of arena_mesh are stored
+		static mesh_arena* &
+		current(){
+			static mesh_arena* arena = nullptr;
+			return arena;
+		}
+};	//mesh_arena
+
+/*!
+	@brief	Mesh of an edge stored in a mesh_arena
+
+	It can be used instead of BGLgeom::mesh in the edge property, and it
+	offers the same interface: the members real and parametric are views
+	of the points stored in the arena, with size(), empty(), operator[]
+	and iterators, so the code reading a mesh (as the writers) does not
+	change. The points are read from the file each time they are accessed.
+
+	A new mesh is stored in the arena it was stored in before, or in the
+	current arena (mesh_arena::make_current()) for a new edge. Storing a
+	new mesh on an edge does not free the space of the old one in the file.
+
+	@param dim Dimension of the space
+*/
+template <unsigned int dim>
+struct arena_mesh{
+	using point = BGLgeom::point<dim>;
+	using vect_pts = std::vector<point>;
+	using vect = std::vector<double>;
+
+	/*!
+		@brief	Read-only view of the values of the mesh in the arena
+
+		@param T The type of the values (points for the real mesh, double for the parametric one)
+		@param n_comp Number of doubles for each value
+	*/
+	template <typename T, std::size_t n_comp>
+	class view{
+		public:
+			//! Iterator on the values
+			class const_iterator{
+				public:
+					using iterator_category = std::forward_iterator_tag;
+					using value_type = T;
+					using difference_type = std::ptrdiff_t;
+					using pointer = T const*;
+					using reference = T;
+
+					const_iterator(view const* _v, std::size_t _i) : v(_v), i(_i) {};
+					T operator*() const { return (*v)[i]; }
+					const_iterator & operator++() { ++i; return *this; }
+					const_iterator operator++(int) { const_iterator tmp(*this); ++i; return tmp; }
+					bool operator==(const_iterator const& other) const { return i == other.i; }
+					bool operator!=(const_iterator const& other) const { return i != other.i; }
+				private:
+					view const* v;
+					std::size_t i;
+			};
+
+			//! Default constructor: empty view
+			view() : arena(nullptr), h(), start(0), n(0) {};
+
+			//! Constructor
+			view(mesh_arena<dim>* _arena, arena_handle const& _h, std::size_t const& _start, std::size_t const& _n) :
+				arena(_arena), h(_h), start(_start), n(_n) {};
+
+			//! Number of values
+			std::size_t size() const { return n; }
+
+			//! True if there are no values
+			bool empty() const { return n == 0; }
+
+			//! The i-th value
+			T
+			operator[](std::size_t const& i) const {
+				return read(arena->values(h) + start + i*n_comp);
+			}
+
+			//! First value
+			T front() const { return (*this)[0]; }
+
+			//! Last value
+			T back() const { return (*this)[n-1]; }
+
+			//! Beginning of the values
+			const_iterator begin() const { return const_iterator(this, 0); }
+
+			//! End of the values
+			const_iterator end() const { return const_iterator(this, n); }
+
+		private:
+			//! The arena
+			mesh_arena<dim>* arena;
+			//! The block of the mesh
+			arena_handle h;
+			//! Position of the first value in the block (in doubles)
+			std::size_t start;
+			//! Number of values
+			std::size_t n;
+
+			static point read(double const* p, point*) { return Eigen::Map<const point>(p); }
+			static double read(double const* p, double*) { return *p; }
+			static T read(double const* p) { return read(p, static_cast<T*>(nullptr)); }
+	};	//view
+
+	//! Points of the real mesh
+	view<point, dim> real;
+	//! Values of the parametric mesh
+	view<double, 1> parametric;
+
+	//! Default constructor
+	arena_mesh() : real(), parametric(), arena(nullptr), h() {};
+
+	//! Constructor from a mesh in memory, stored in the current arena
+	arena_mesh(vect_pts const& _real, vect const& _parametric) : real(), parametric(), arena(nullptr), h() {
+		this->set(_real, _parametric);
+	};
+
+	//! Copy constructor
+	arena_mesh(arena_mesh const&) = default;
+
+	//! Move constructor
+	arena_mesh(arena_mesh &&) = default;
+
+	//! Assignment operator
+	arena_mesh & operator=(arena_mesh const&) = default;
+
+	//! Move assignment
+	arena_mesh & operator=(arena_mesh &&) = default;
+
+	//! Destructor
+	virtual ~arena_mesh() = default;
+
+	//! Clear both the real and the parametric mesh
+	void
+	clear(){
+		real = view<point, dim>();
+		parametric = view<double, 1>();
+		h = arena_handle();
+	}
+
+	//! True if both the real and the parametric mesh are empty
+	bool
+	empty() const { return real.empty() && parametric.empty(); }
+
+	//! Stores a mesh in the arena
+	void
+	set(vect_pts const& _real, vect const& _parametric){
+		if(arena == nullptr)
+			arena = mesh_arena<dim>::current();
+		if(arena == nullptr){
+			std::cerr << "ERROR! BGLgeom::arena_mesh::set(): no current mesh_arena, call make_current() first" << std::endl;
+			std::cerr << "Aborting" << std::endl;
+			exit(EXIT_FAILURE);
+		}
+		h = arena->store(_real, _parametric);
+		real = view<point, dim>(arena, h, 0, h.n_real);
+		parametric = view<double, 1>(arena, h, h.n_real*dim, h.n_param);
+	}
+
+	//! Copy of the mesh in memory
+	BGLgeom::mesh<dim>
+	to_mesh() const {
+		return BGLgeom::mesh<dim>(vect_pts(real.begin(), real.end()), vect(parametric.begin(), parametric.end()));
+	}
+
+	//! Asks the arena to start loading the mesh
+	void
+	prefetch() const {
+		if(arena != nullptr && h.bytes > 0)
+			arena->prefetch(h.offset, h.bytes);
+	}
+
+	//! Creates a uniform parametric mesh, evaluates it and stores it (see mesh::uniform_mesh())
+	void
+	uniform_mesh(unsigned int const& n, std::function<vect_pts(vect const&)> const& eval){
+		BGLgeom::Mesh1D temp_mesh(BGLgeom::Domain1D(0,1), n);
+		vect param = temp_mesh.getMesh();
+		this->set(eval(param), param);
+	}
+
+	//! Creates a non-uniform parametric mesh, evaluates it and stores it (see mesh::variable_mesh())
+	void
+	variable_mesh(unsigned int const& n,
+				  std::function<double(double)> const& spacing_function,
+				  std::function<vect_pts(vect const&)> const& eval){
+		BGLgeom::Mesh1D temp_mesh(BGLgeom::Domain1D(0,1), n, spacing_function);
+		vect param = temp_mesh.getMesh();
+		this->set(eval(param), param);
+	}
+
+	private:
+		//! The arena where the mesh is stored
+		mesh_arena<dim>* arena;
+		//! The block of the mesh
+		arena_handle h;
+};	//arena_mesh
+
+//! Starts loading a mesh stored in an arena (see prefetch_mesh() in mesh.hpp)
+template <unsigned int dim>
+inline void
+prefetch_mesh(arena_mesh<dim> const& M) { M.prefetch(); }
+
+}	//BGLgeom
+
+#endif	//HH_MESH_ARENA_HH
@@ -0,0 +1,67 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	parallel_intersections.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	All the intersections in a set of segments, computed by more threads
+
+	The sweep line (sweep_intersections.hpp) is inherently sequential.
+	Here the segments are put in a uniform grid (edge_grid), and each
+	segment is tested only against the following segments whose bounding
+	box meets its own: the segments are split in blocks, which the threads
+	take one at a time, and the results of the blocks are joined in their
+	order, so that they do not depend on the number of threads.
+*/
+
+#ifndef HH_PARALLEL_INTERSECTIONS_HH
+#define HH_PARALLEL_INTERSECTIONS_HH
+
+#include <vector>
+#include "linear_geometry.hpp"
+#include "sweep_intersections.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	Computes all the intersections between the segments of a set,
+			using more threads
+
+	The result is the same of compute_all_intersections() and of
+	compute_all_intersections_brute_force(), for any number of threads.
+
+	@pre	The segments must have non null length: the null ones are ignored
+
+	@param S The segments
+	@param n_threads Number of threads. If zero (the default), the number
+			of concurrent threads supported by the machine
+	@return The intersections, ordered by (first, second)
+*/
+std::vector<segment_intersection>
+compute_all_intersections_parallel(std::vector<BGLgeom::linear_geometry<2>> const& S,
+								   unsigned int n_threads = 0);
+
+}	//BGLgeom
+
+#endif	//HH_PARALLEL_INTERSECTIONS_HH
@@ -35,17 +35,119 @@
 #include <iostream>
 #include <iomanip>
 #include <Eigen/Dense>
+#include <vector>
 #include <limits>
+#include <algorithm>
 
 #ifndef TOL
 #define TOL 20*std::numeric_limits<double>::epsilon()
 #endif
 
+/*!
+	Number of doubles used in 3D by the padded batch evaluation (see padded_point):
+	with the default value 4 they are aligned and Eigen vectorizes their 
+	operations; define it as 3 to store them as the usual points
+*/
+#ifndef BGLGEOM_PADDED_SIZE_3D
+#define BGLGEOM_PADDED_SIZE_3D 4
+#endif
+
 namespace BGLgeom{
 
-//! Alias template for a point in N-th dimensional space, using Eigen::Matrix
+/*!
+	@brief	Alias template for a point in N-th dimensional space, using Eigen::Matrix
+	
+	The coordinates are double by default; with T = float the points use 
+	half of the memory (see also the scalar type of linear_geometry and 
+	mesh)
+*/
+template <unsigned int N, typename T = double>
+using point = Eigen::Matrix<T,1,N>;
+
+/*!
+	@brief	Tolerances used for the given scalar type
+	
+	For double they are TOL, used to compare points, and 1e-8, used by the
+	geometries to check if a derivative vanishes. For the other types they
+	are the same values, but not smaller than 100 times the machine 
+	epsilon of the type, since for float TOL would be below the precision
+	of the coordinates.
+*/
+template <typename T>
+struct tolerance{
+	//! Tolerance to compare points (see operator==)
+	static T
+	value() { return std::max(static_cast<T>(TOL), 100*std::numeric_limits<T>::epsilon()); }
+	
+	//! Tolerance on the norm of the derivatives of the geometries
+	static T
+	dist() { return std::max(static_cast<T>(1e-8), 100*std::numeric_limits<T>::epsilon()); }
+};	//tolerance
+
+//! Tolerances for double (see tolerance)
+template <>
+struct tolerance<double>{
+	//! Tolerance to compare points (see operator==)
+	static double value() { return TOL; }
+	
+	//! Tolerance on the norm of the derivatives of the geometries
+	static double dist() { return 1e-8; }
+};	//tolerance<double>
+
+//! Number of doubles used to store a point of the N-th dimensional space as a padded_point
 template <unsigned int N>
-using point = Eigen::Matrix<double,1,N>;
+struct padded_size{
+	static constexpr int value = (N == 3 ? BGLGEOM_PADDED_SIZE_3D : N);
+};
+
+/*!
+	@brief	Alias template for the points of the padded batch evaluation
+	
+	A point<3> uses 24 bytes and Eigen cannot vectorize it well. A
+	padded_point<3> uses 4 doubles (the last one is zero) so that it is 
+	aligned (to 16 bytes, or 32 with AVX) and all the operations on it are 
+	vectorized. It must be stored in an aligned_vector. The geometries 
+	evaluate into it (see their evaluate() methods), the bspline can store
+	its control points as padded points and the mesh its real points (see
+	padded_mesh in mesh.hpp). In the other dimensions it is the same as 
+	point<N>. See test_padded_batch_evaluation for the timings.
+*/
+template <unsigned int N, typename T = double>
+using padded_point = Eigen::Matrix<T,1,padded_size<N>::value>;
+
+//! Alias template for a std::vector of fixed size Eigen objects, with the right alignment
+template <typename T>
+using aligned_vector = std::vector<T, Eigen::aligned_allocator<T>>;
+
+//! Converts a point to a padded_point, setting to zero the padding
+template <unsigned int N, typename T = double>
+inline padded_point<N,T>
+pad(point<N,T> const& P){
+	padded_point<N,T> Q = padded_point<N,T>::Zero();
+	Q.template head<N>() = P;
+	return Q;
+}
+
+//! Converts a padded_point to a point, discarding the padding
+template <unsigned int N, typename T = double>
+inline point<N,T>
+unpad(padded_point<N,T> const& Q){
+	return Q.template head<N>();
+}
+
+/*!
+	@brief	Converts the first N coordinates of P to the point type Point
+	
+	The other coordinates of Point (the padding) are set to zero. It is 
+	used to move between point, padded_point and the other scalar types
+*/
+template <typename Point, unsigned int N, typename Derived>
+inline Point
+convert_point(Eigen::MatrixBase<Derived> const& P){
+	Point Q = Point::Zero();
+	Q.template head<N>() = P.template head<N>().template cast<typename Point::Scalar>();
+	return Q;
+}
 
 //! Overload of the input operator for Eigen Matrices
 template <typename Derived>
@@ -107,12 +209,17 @@ operator> (Eigen::DenseBase<Derived> const& P1, Eigen::DenseBase<Derived> const&
 /*!
 	@brief Operator== overloading		
 		
-	It checks if all the coordinates are equal, with a default tolerance
+	It checks if all the coordinates are equal, with the tolerance of
+	their scalar type (see tolerance)
+	
+	@note	For two points P1 == P2 resolves to the (exact) member operator== 
+			of Eigen::MatrixBase, since it is a better match: this one has to 
+			be called explicitly, as BGLgeom::operator==(P1,P2)
 */
 template <typename Derived>
 bool
 operator== (Eigen::DenseBase<Derived> const& P1, Eigen::DenseBase<Derived> const& P2){
-	return (P1-P2).norm() < TOL;
+	return (P1.derived()-P2.derived()).norm() < tolerance<typename Derived::Scalar>::value();
 }
 
 /*!
@@ -0,0 +1,399 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	polyline_geometry.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Concrete class for a piecewise linear geometry on an edge
+*/
+
+#ifndef HH_POLYLINE_GEOMETRY_HH
+#define HH_POLYLINE_GEOMETRY_HH
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <Eigen/Dense>
+#include "point.hpp"
+#include "edge_geometry.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	The class handling a piecewise linear geometry for an edge
+
+	The edge is the polyline through an ordered set of points. The
+	coordinates of the points are stored one after the other in a flat
+	buffer, together with the cumulative length of the polyline at each
+	point. The curve is parametrized between 0 and 1 proportionally to
+	the arc length, so the curvilinear abscissa and the length are exact,
+	and the evaluation at a given parameter only needs a binary search
+	on the cumulative lengths (logarithmic in the number of points).
+
+	@note	The curve is only piecewise differentiable: at the points of the
+			polyline the first derivative of the segment that follows the
+			point is returned (of the last segment at t=1). The second
+			derivative is zero everywhere
+	@note	The curvature is a discrete estimate: at each inner point we take
+			the curvature of the circle through the point and its two
+			neighbours, and in between the points we interpolate it linearly
+
+	@param dim Dimension of the space
+	@param T Scalar type of the coordinates and of the parameter
+*/
+template <unsigned int dim, typename T = double>
+class polyline_geometry : public BGLgeom::edge_geometry<dim,T> {
+
+	private:
+		//! Coordinates of the points of the polyline, stored consecutively
+		std::vector<T> coords;
+		//! Cumulative length of the polyline at each point
+		std::vector<T> cum_length;
+		//! Discrete curvature at each point
+		std::vector<T> kappa;
+
+	public:
+		using point = BGLgeom::point<dim,T>;
+		using vect_pts = std::vector<point>;
+		using vect_double = std::vector<T>;
+
+		//! Default constructor
+		polyline_geometry() : coords(), cum_length(), kappa() {};
+
+		/*!
+			@brief	Constructor
+
+			@param P The ordered points of the polyline. Coincident consecutive
+					 points are discarded
+		*/
+		polyline_geometry(vect_pts const& P) : coords(), cum_length(), kappa() {
+			this->set_points(P);
+		}
+
+		//! Copy constructor
+		polyline_geometry(polyline_geometry const&) = default;
+
+		//! Move constructor
+		polyline_geometry(polyline_geometry &&) = default;
+
+		//! Destructor
+		virtual ~polyline_geometry() = default;
+
+		//! Assignment operator
+		polyline_geometry & operator=(polyline_geometry const&) = default;
+
+		//! Move assignment
+		polyline_geometry & operator=(polyline_geometry &&) = default;
+
+		/*!
+			@brief	Sets the points of the polyline
+
+			It builds the flat buffer of coordinates, the cumulative length
+			and the discrete curvature at the points. Coincident consecutive
+			points would give segments of null length and are discarded.
+			If less than two distinct points are given, it shows an error
+			message and aborts the program
+
+			@param P The ordered points of the polyline
+		*/
+		void
+		set_points(vect_pts const& P){
+			coords.clear();
+			cum_length.clear();
+			kappa.clear();
+			coords.reserve(dim*P.size());
+			cum_length.reserve(P.size());
+			for(std::size_t i = 0; i < P.size(); ++i){
+				if(cum_length.empty()){
+					cum_length.push_back(0.0);
+				} else {
+					T len = (P[i] - this->get_point(cum_length.size()-1)).norm();
+					if(len == 0)
+						continue;
+					cum_length.push_back(cum_length.back() + len);
+				}
+				for(std::size_t j = 0; j < dim; ++j)
+					coords.push_back(P[i](j));
+			}
+			if(cum_length.size() < 2){
+				std::cerr << "ERROR! BGLgeom::polyline_geometry::set_points(): " << std::endl;
+				std::cerr << "\tat least two distinct points are needed" << std::endl;
+				std::cerr << "Aborting" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			this->compute_curvature();
+		}
+
+		//! Sets the points of the polyline from points of another scalar type (converting them to T)
+		template <typename U>
+		void
+		set_points(std::vector<BGLgeom::point<dim,U>> const& P){
+			vect_pts P_T(P.size());
+			for(std::size_t i = 0; i < P.size(); ++i)
+				P_T[i] = P[i].template cast<T>();
+			this->set_points(P_T);
+		}
+
+		//! Number of points of the polyline
+		std::size_t get_num_points() const { return cum_length.size(); }
+
+		//! Getting the coordinates of the i-th point of the polyline
+		point
+		get_point(std::size_t const& i) const {
+			return Eigen::Map<const point>(&coords[dim*i]);
+		}
+
+		//! Getting all the points of the polyline
+		vect_pts
+		get_points() const {
+			vect_pts P(this->get_num_points());
+			for(std::size_t i = 0; i < P.size(); ++i)
+				P[i] = this->get_point(i);
+			return P;
+		}
+
+		//! Getting source's coordinates
+		point get_source() const { return this->get_point(0); }
+
+		//! Getting target's coordinates
+		point get_target() const { return this->get_point(this->get_num_points()-1); }
+
+		//! Length of the edge
+		T length() const { return cum_length.empty() ? T(0) : cum_length.back(); }
+
+		/*!
+	    	@brief	Evaluates the polyline at a given value of the parameter
+
+	    	It tests if the given parameter belongs to [0,1]. If not, it gives
+	    	a warning on std::cerr and abort the program
+	    */
+		point
+		operator() (T const& t) const {
+			check_param(t, "operator()");
+			T s = t * this->length();
+			std::size_t i = this->locate(s);
+			return this->eval_on_segment(i, s);
+		}
+
+		/*!
+			@brief	Evaluates the polyline in a vector of values of the parameter
+
+			If the parameters are sorted (as in a mesh), the segments are
+			found walking along the polyline, otherwise by binary search
+		*/
+		vect_pts
+		operator() (vect_double const& t) const {
+			vect_pts P_vect(t.size());
+			std::size_t i = 0;
+			for(std::size_t k = 0; k < t.size(); ++k){
+				check_param(t[k], "operator()");
+				T s = t[k] * this->length();
+				i = this->locate(s, i);
+				P_vect[k] = this->eval_on_segment(i, s);
+			}
+			return P_vect;
+		}
+
+		//! Evaluates the first derivative of the polyline
+		point
+		first_der(T const& t) const {
+			check_param(t, "first_der");
+			return this->segment_der(this->locate(t * this->length()));
+		}
+
+		//! Evaluates the first derivative in a vector of values of the parameter
+		vect_pts
+		first_der(vect_double const& t) const {
+			vect_pts Fder(t.size());
+			std::size_t i = 0;
+			for(std::size_t k = 0; k < t.size(); ++k){
+				check_param(t[k], "first_der");
+				i = this->locate(t[k] * this->length(), i);
+				Fder[k] = this->segment_der(i);
+			}
+			return Fder;
+		}
+
+		//! Evaluates the second derivative (zero on each segment)
+		point
+		second_der(T const& t) const { return point::Zero(); }
+
+		//! Evaluates the second derivative in a vector of parameters
+		vect_pts
+		second_der(vect_double const& t) const {
+			return vect_pts(t.size(), point::Zero());
+		}
+
+		/*!
+			@brief	Curvilinear abscissa
+
+			It is exact, since the parametrization is proportional to the arc length.
+			It tests if the given parameter belongs to [0,1]. If not, it gives
+	    	a warning on std::cerr and abort the program
+		*/
+		T
+		curv_abs(T const& t) const {
+			check_param(t, "curv_abs");
+			return t * this->length();
+		}
+
+		//! Evaluates the curvilinear abscissa in a vector of parameters
+		vect_double
+		curv_abs(vect_double const& t) const {
+			vect_double C(t.size());
+			for(std::size_t i = 0; i < t.size(); ++i)
+				C[i] = this->curv_abs(t[i]);
+			return C;
+		}
+
+		//! Evaluates the discrete curvature at a given value of the parameter
+		T
+		curvature(T const& t) const {
+			check_param(t, "curvature");
+			T s = t * this->length();
+			return this->curvature_on_segment(this->locate(s), s);
+		}
+
+		//! Evaluates the discrete curvature in a vector of parameters
+		vect_double
+		curvature(vect_double const& t) const {
+			vect_double K(t.size());
+			std::size_t i = 0;
+			for(std::size_t k = 0; k < t.size(); ++k){
+				check_param(t[k], "curvature");
+				T s = t[k] * this->length();
+				i = this->locate(s, i);
+				K[k] = this->curvature_on_segment(i, s);
+			}
+			return K;
+		}
+
+		/*!
+			@brief	Overload of operator<<
+
+			It tells the coordinates of its extremes and the number of points.
+			May be useful for debugging
+		*/
+		friend std::ostream & operator<<(std::ostream & out, polyline_geometry const& edge) {
+			out << "(polyline)\tSource: " << edge.get_source() << ", Target: " << edge.get_target()
+				<< ", Number of points: " << edge.get_num_points();
+			return out;
+		}
+
+	private:
+		//! Checks that the parameter is in [0,1], otherwise aborts
+		static void
+		check_param(T const& t, const char* fun){
+			if(t > 1 || t < 0){
+				std::cerr << "polyline_geometry::" << fun << "(): parameter value out of bounds" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		/*!
+			@brief	Finds the segment containing the given arc length
+
+			@param s The arc length
+			@param hint A segment to start from: if s lies in it or in the
+						following one the search is not performed
+			@return The index i of the segment, such that cum_length[i] <= s < cum_length[i+1]
+					(the last segment if s is the length of the polyline)
+		*/
+		std::size_t
+		locate(T const& s, std::size_t const& hint = 0) const {
+			const std::size_t n_seg = cum_length.size() - 1;
+			if(hint < n_seg && cum_length[hint] <= s){
+				if(s < cum_length[hint+1])
+					return hint;
+				if(hint+1 < n_seg && s < cum_length[hint+2])
+					return hint+1;
+			}
+			auto it = std::upper_bound(cum_length.begin()+1, cum_length.end()-1, s);
+			return (it - cum_length.begin()) - 1;
+		}
+
+		//! Evaluation of the point with arc length s on segment i
+		point
+		eval_on_segment(std::size_t const& i, T const& s) const {
+			T lambda = (s - cum_length[i]) / (cum_length[i+1] - cum_length[i]);
+			return (T(1) - lambda) * this->get_point(i) + lambda * this->get_point(i+1);
+		}
+
+		//! First derivative on segment i, with respect to the parameter in [0,1]
+		point
+		segment_der(std::size_t const& i) const {
+			return (this->get_point(i+1) - this->get_point(i)) *
+					this->length() / (cum_length[i+1] - cum_length[i]);
+		}
+
+		//! Discrete curvature at arc length s on segment i
+		T
+		curvature_on_segment(std::size_t const& i, T const& s) const {
+			T lambda = (s - cum_length[i]) / (cum_length[i+1] - cum_length[i]);
+			return (T(1) - lambda) * kappa[i] + lambda * kappa[i+1];
+		}
+
+		/*!
+			@brief	Computes the discrete curvature at the points
+
+			At each inner point it is the inverse of the radius of the circle
+			through the point and its neighbours: 2*sin(theta)/|P(i+1)-P(i-1)|,
+			with theta the angle between the two segments (infinite if the
+			polyline goes back on itself). At the ends it is the one of the
+			nearest inner point
+		*/
+		void
+		compute_curvature(){
+			const std::size_t n = cum_length.size();
+			kappa.assign(n, 0.0);
+			for(std::size_t i = 1; i+1 < n; ++i){
+				point a = this->get_point(i) - this->get_point(i-1);
+				point b = this->get_point(i+1) - this->get_point(i);
+				T la = cum_length[i] - cum_length[i-1];
+				T lb = cum_length[i+1] - cum_length[i];
+				T lc = (a+b).norm();
+				if(lc == 0){	// the polyline goes back on itself
+					kappa[i] = std::numeric_limits<T>::infinity();
+					continue;
+				}
+				// Angle between the segments, in a form that is accurate also for small angles
+				point ua = a / la;
+				point ub = b / lb;
+				T theta = 2 * std::atan2((ua-ub).norm(), (ua+ub).norm());
+				kappa[i] = 2 * std::sin(theta) / lc;
+			}
+			if(n > 2){
+				kappa.front() = kappa[1];
+				kappa.back() = kappa[n-2];
+			}
+		}
+
+}; //polyline_geometry
+
+} //BGLgeom
+
+#endif	//HH_POLYLINE_GEOMETRY_HH
@@ -0,0 +1,64 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	predicates.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Exact orientation test of three points
+
+	The orientation is computed in floating point, and the result is
+	accepted if it is larger than a bound of its rounding error; otherwise
+	(only for almost collinear points) it is computed again exactly, as a
+	sum of non overlapping doubles (an expansion). This is the approach of
+	J.R. Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast
+	Robust Geometric Predicates", 1997.
+
+	@note	It requires IEEE double arithmetic with round to nearest and
+			no contraction of products and sums (fused multiply-add) or
+			extended precision: this holds for the flags used here (SSE2
+			arithmetic on x86-64, ISO C++ mode). Overflow and underflow
+			are not handled
+*/
+
+#ifndef HH_PREDICATES_HH
+#define HH_PREDICATES_HH
+
+#include "point.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	Orientation of three points
+
+	@return A value with the exact sign of the determinant
+			\f$ (a-c) \times (b-c) \f$: positive if a, b, c are in
+			counterclockwise order, negative if clockwise, zero if they are
+			collinear. The value is an approximation of the determinant
+*/
+double
+orient2d(BGLgeom::point<2> const& a, BGLgeom::point<2> const& b, BGLgeom::point<2> const& c);
+
+}	//BGLgeom
+
+#endif	//HH_PREDICATES_HH
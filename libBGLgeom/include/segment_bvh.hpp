@@ -0,0 +1,244 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	segment_bvh.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Segments in 3D closer than a given distance, with a bounding
+			volume hierarchy
+
+	The intersections in intersections2D.hpp are only for plane segments:
+	in a network of vessels, reconstructed in 3D from images, two edges
+	which touch or overlap never meet exactly, they just pass nearer than
+	their radius. Here the closest approach of two segments in 3D is
+	computed, and all the pairs of segments of a set closer than a given
+	distance are found: the segments are put in a binary tree of bounding
+	boxes (BVH), and each segment visits only the boxes near to its own,
+	so the cost is O(n log n) plus the number of pairs found.
+*/
+
+#ifndef HH_SEGMENT_BVH_HH
+#define HH_SEGMENT_BVH_HH
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include "point.hpp"
+#include "linear_geometry.hpp"
+
+namespace BGLgeom{
+
+//! Closest approach of two segments
+struct closest_approach{
+	//! Distance between the segments
+	double distance;
+	//! Parameters in [0,1] of the nearest points on the first and on the second segment
+	double s, t;
+	//! The nearest points on the first and on the second segment
+	BGLgeom::point<3> P1, P2;
+	/*!
+		@brief	True if the segments meet: their distance is below the
+				tolerance of compute_intersection(), i.e. TOL times the
+				length of the longer one
+	*/
+	bool intersect;
+};	//closest_approach
+
+/*!
+	@brief	Computes the closest approach of two segments in 3D
+
+	If the nearest points are not unique (parallel segments whose
+	projections overlap) one of the pairs is returned. A segment of null
+	length is treated as a point.
+
+	@param S1 The first segment
+	@param S2 The second segment
+	@return The distance and the nearest points
+*/
+BGLgeom::closest_approach
+compute_closest_approach(BGLgeom::linear_geometry<3> const& S1, BGLgeom::linear_geometry<3> const& S2);
+
+//! A pair of segments of a set closer than a given distance
+struct segment_proximity{
+	//! Position of the first segment in the set
+	std::size_t first;
+	//! Position of the second segment in the set (first < second)
+	std::size_t second;
+	//! The closest approach, as computed by compute_closest_approach(S[first], S[second])
+	BGLgeom::closest_approach C;
+};	//segment_proximity
+
+/*!
+	@brief	Bounding volume hierarchy over a set of segments in 3D
+
+	Each node stores the bounding box of its segments; a node with more
+	than leaf_size segments is split in two at the median of the centres
+	of the segments along the longest side of their bounding box. The
+	nodes are stored in depth-first order, with the left child following
+	its parent, and the segments are stored (by coordinates) in the order
+	of the leaves, so that a query reads memory almost sequentially.
+*/
+class segment_bvh{
+	public:
+		//! Maximum number of segments in a leaf
+		static const std::size_t leaf_size = 4;
+
+		//! Default constructor: empty tree
+		segment_bvh() = default;
+
+		//! Constructor: builds the tree over the segments
+		segment_bvh(std::vector<BGLgeom::linear_geometry<3>> const& S) { this->build(S); }
+
+		//! (Re)builds the tree over the segments
+		void build(std::vector<BGLgeom::linear_geometry<3>> const& S);
+
+		//! Number of segments
+		std::size_t size() const { return index.size(); }
+
+		//! Number of nodes
+		std::size_t num_nodes() const { return nodes.size(); }
+
+		/*!
+			@brief	Segments whose bounding box is closer than d to the one
+					of the segment from A to B
+
+			All the segments closer than d to the segment are found, but
+			also some farther ones: the caller has to compute their distance.
+
+			@param A,B The extremes of the segment
+			@param d The distance
+			@param E (Output) The positions in the set of the segments found,
+					 in increasing order
+		*/
+		void
+		candidates(BGLgeom::point<3> const& A, BGLgeom::point<3> const& B, double const& d, std::vector<std::size_t> & E) const;
+
+		/*!
+			@brief	Calls f(k) on the segments whose bounding box is closer than
+					d to the box [lo, hi]
+
+			k is the position of the segment in the order of the leaves: its
+			position in the set is original(k), its extremes source(k) and
+			target(k)
+		*/
+		template <typename F>
+		void
+		for_each_near(double const lo[3], double const hi[3], double const& d, F const& f) const {
+			if(nodes.empty())
+				return;
+			std::uint32_t stack[64];
+			std::size_t top = 0;
+			stack[top++] = 0;
+			while(top > 0){
+				node const& N = nodes[stack[--top]];
+				if(N.lo[0] > hi[0] + d || N.hi[0] < lo[0] - d ||
+				   N.lo[1] > hi[1] + d || N.hi[1] < lo[1] - d ||
+				   N.lo[2] > hi[2] + d || N.hi[2] < lo[2] - d)
+					continue;
+				if(N.count > 0){
+					for(std::size_t k = N.first; k < N.first + N.count; ++k)
+						f(k);
+				} else {
+					// The left child follows its parent
+					stack[top++] = N.first;
+					stack[top++] = static_cast<std::uint32_t>(&N - nodes.data()) + 1;
+				}
+			}
+		}
+
+		//! Position in the set of the k-th segment in the order of the leaves
+		std::size_t original(std::size_t const& k) const { return index[k]; }
+
+		//! Source of the k-th segment in the order of the leaves
+		BGLgeom::point<3> source(std::size_t const& k) const { return BGLgeom::point<3>(seg[k].a[0], seg[k].a[1], seg[k].a[2]); }
+
+		//! Target of the k-th segment in the order of the leaves
+		BGLgeom::point<3> target(std::size_t const& k) const { return BGLgeom::point<3>(seg[k].b[0], seg[k].b[1], seg[k].b[2]); }
+
+	private:
+		//! A node of the tree
+		struct node{
+			//! Bounding box
+			double lo[3], hi[3];
+			//! For a leaf, the first segment; otherwise the right child
+			std::uint32_t first;
+			//! Number of segments of a leaf, zero for the other nodes
+			std::uint32_t count;
+		};	//node
+
+		//! A segment in the order of the leaves
+		struct segment{
+			//! Extremes
+			double a[3], b[3];
+		};	//segment
+
+		//! The nodes, in depth-first order
+		std::vector<node> nodes;
+		//! The segments, in the order of the leaves
+		std::vector<segment> seg;
+		//! Position in the set of the segments, in the order of the leaves
+		std::vector<std::size_t> index;
+};	//segment_bvh
+
+/*!
+	@brief	Computes all the pairs of segments of a set closer than a given
+			distance, using more threads
+
+	In a network the edges meeting at a vertex have distance zero: with
+	skip_adjacent they are not reported (two segments are adjacent if they
+	have an extreme in common, up to the tolerance of compute_intersection()).
+	The result does not depend on the number of threads.
+
+	@param S The segments
+	@param d The distance: the pairs with distance <= d are found
+	@param skip_adjacent If true (the default) the pairs of segments with an
+			extreme in common are not reported
+	@param n_threads Number of threads. If zero (the default), the number
+			of concurrent threads supported by the machine
+	@return The pairs found, ordered by (first, second)
+*/
+std::vector<segment_proximity>
+compute_close_pairs(std::vector<BGLgeom::linear_geometry<3>> const& S,
+					double const& d,
+					bool const& skip_adjacent = true,
+					unsigned int n_threads = 0);
+
+/*!
+	@brief	Computes the pairs of segments closer than a given distance,
+			testing each pair
+
+	Reference implementation, with cost O(n^2): it gives the same result
+	of compute_close_pairs()
+*/
+std::vector<segment_proximity>
+compute_close_pairs_brute_force(std::vector<BGLgeom::linear_geometry<3>> const& S,
+								double const& d,
+								bool const& skip_adjacent = true);
+
+//! Overload of operator<<
+std::ostream & operator<<(std::ostream & out, segment_proximity const& SP);
+
+}	//BGLgeom
+
+#endif	//HH_SEGMENT_BVH_HH
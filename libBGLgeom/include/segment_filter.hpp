@@ -0,0 +1,107 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	segment_filter.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Fast test of a segment against many segments, before
+			compute_intersection
+
+	compute_intersection() builds the interfaces of the two edges, the
+	tolerances and a large Intersection object for each pair, but most of
+	the pairs given by a spatial index do not intersect. Here the
+	segments are stored by coordinates (x0, y0, x1, y1 in four arrays), and
+	a segment is tested against 64 of them at a time, with the same
+	operations for all of them and no branches, so that the compiler can
+	vectorize the loop: the result is a bitmask of the segments which may
+	intersect it, on which compute_intersection() has to be called.
+	\code
+	BGLgeom::segment_block B;
+	for(auto const& s : near) B.push_back(s.get_source(), s.get_target());
+	for(std::size_t first = 0; first < B.size(); first += BGLgeom::segment_block::width){
+		std::uint64_t mask = B.candidates(A, C, first);
+		for(std::size_t k = first; mask != 0; ++k, mask >>= 1)
+			if(mask & 1) ... compute_intersection(near[k], ...) ...
+	}
+	\endcode
+*/
+
+#ifndef HH_SEGMENT_FILTER_HH
+#define HH_SEGMENT_FILTER_HH
+
+#include <vector>
+#include <cstdint>
+#include "point.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	Segments stored by coordinates, to be tested against a segment
+
+	The test is conservative: a segment is discarded only if its bounding
+	box or its position with respect to the line of the other segment
+	(or vice versa) exclude any intersection found by compute_intersection()
+	with its tolerances, so no intersection is lost
+*/
+class segment_block{
+	public:
+		//! Number of segments tested by each call of candidates()
+		static const std::size_t width = 64;
+
+		//! Removes all the segments
+		void clear();
+
+		//! Reserves space for n segments
+		void reserve(std::size_t const& n);
+
+		//! Adds the segment from A to B
+		void push_back(BGLgeom::point<2> const& A, BGLgeom::point<2> const& B);
+
+		//! Number of segments
+		std::size_t size() const { return x0.size(); }
+
+		/*!
+			@brief	Segments which may intersect the segment from A to B
+
+			@param A,B The extremes of the segment
+			@param first The first segment tested: the ones from first to
+						 first+width (or to the end) are tested
+			@return A bitmask: bit k is set if the segment first+k may
+					intersect the segment from A to B
+		*/
+		std::uint64_t
+		candidates(BGLgeom::point<2> const& A, BGLgeom::point<2> const& B, std::size_t const& first) const;
+
+	private:
+		//! Coordinates of the sources
+		std::vector<double> x0, y0;
+		//! Coordinates of the targets
+		std::vector<double> x1, y1;
+		//! Lengths
+		std::vector<double> len;
+};	//segment_block
+
+}	//BGLgeom
+
+#endif	//HH_SEGMENT_FILTER_HH
@@ -0,0 +1,253 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	spatial_reorder.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Renumbering of vertices and edges of a graph along a space-filling curve
+
+	After many insertions and removals the order in which vertices and edges
+	are stored has nothing to do with their position in space, so visiting
+	the neighbours of a vertex, or writing the graph on a file, jumps all
+	around the memory. These functions sort the vertices along a Morton
+	(Z-order) or Hilbert curve over their coordinates, so that vertices
+	close in space are also close in memory, and rebuild the graph storing
+	vertices and edges in this order.
+*/
+
+#ifndef HH_SPATIAL_REORDER_HH
+#define HH_SPATIAL_REORDER_HH
+
+#include <vector>
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <boost/graph/adjacency_list.hpp>
+#include "point.hpp"
+#include "graph_access.hpp"
+
+namespace BGLgeom{
+
+//! The space-filling curves available to sort the vertices
+enum class sfc_curve {morton, hilbert};
+
+/*!
+	@brief	Position of a point along a space-filling curve
+
+	The bounding box [lo, lo+extent]^dim is divided in 2^b cells per side,
+	where b is the number of bits available for each coordinate in a 64 bit
+	key; the key is the index along the curve of the cell containing P.
+	For the Hilbert curve the transposition algorithm of J. Skilling
+	("Programming the Hilbert curve", 2004) is used.
+
+	@param P The point
+	@param lo The lower corner of the bounding box of all the points
+	@param extent The length of the side of the (cubic) bounding box
+	@param curve The space-filling curve to be used
+	@return The key of the point along the curve
+*/
+template <unsigned int dim>
+std::uint64_t
+sfc_key(BGLgeom::point<dim> const& P,
+		BGLgeom::point<dim> const& lo,
+		double const& extent,
+		sfc_curve const& curve = sfc_curve::hilbert){
+
+	const unsigned int b = (64/dim < 32 ? 64/dim : 32);
+	const double n_cells = static_cast<double>((std::uint64_t(1) << b) - 1);
+
+	// Integer coordinates of the cell
+	std::array<std::uint64_t, dim> X;
+	for(std::size_t i = 0; i < dim; ++i){
+		double x = (extent > 0 ? (P(i) - lo(i)) / extent : 0.0);
+		x = std::min(std::max(x, 0.0), 1.0);
+		X[i] = static_cast<std::uint64_t>(x * n_cells);
+	}
+
+	if(curve == sfc_curve::hilbert){
+		const std::uint64_t M = std::uint64_t(1) << (b-1);
+		// Inverse undo
+		for(std::uint64_t Q = M; Q > 1; Q >>= 1){
+			std::uint64_t mask = Q - 1;
+			for(std::size_t i = 0; i < dim; ++i){
+				if(X[i] & Q)
+					X[0] ^= mask;
+				else {
+					std::uint64_t t = (X[0] ^ X[i]) & mask;
+					X[0] ^= t;
+					X[i] ^= t;
+				}
+			}
+		}
+		// Gray encode
+		for(std::size_t i = 1; i < dim; ++i)
+			X[i] ^= X[i-1];
+		std::uint64_t t = 0;
+		for(std::uint64_t Q = M; Q > 1; Q >>= 1)
+			if(X[dim-1] & Q)
+				t ^= Q - 1;
+		for(std::size_t i = 0; i < dim; ++i)
+			X[i] ^= t;
+	}
+
+	// Interleaving the bits, from the most significant one
+	std::uint64_t key = 0;
+	for(int j = b-1; j >= 0; --j)
+		for(std::size_t i = 0; i < dim; ++i)
+			key = (key << 1) | ((X[i] >> j) & 1);
+	return key;
+}	//sfc_key
+
+/*!
+	@brief	Order of the vertices of a graph along a space-filling curve
+
+	@pre	The vertex descriptors have to be indices, i.e. the graph must use
+			boost::vecS as container for the vertices
+	@param G The graph, whose vertex property contains the coordinates
+	@param curve The space-filling curve to be used
+	@return The new index of each vertex (indexed by the old one)
+*/
+template <typename Graph, unsigned int dim>
+std::vector<std::size_t>
+spatial_order(Graph const& G, sfc_curve const& curve = sfc_curve::hilbert){
+	const std::size_t n = boost::num_vertices(G);
+	std::vector<std::size_t> new_index(n);
+	if(n == 0)
+		return new_index;
+
+	// Bounding box
+	BGLgeom::point<dim> lo = G[0].coordinates, hi = G[0].coordinates;
+	for(std::size_t v = 1; v < n; ++v){
+		lo = lo.cwiseMin(G[v].coordinates);
+		hi = hi.cwiseMax(G[v].coordinates);
+	}
+	const double extent = (hi - lo).maxCoeff();
+
+	// Sorting the vertices by key; the old index breaks the ties
+	std::vector<std::pair<std::uint64_t, std::size_t>> keys(n);
+	for(std::size_t v = 0; v < n; ++v)
+		keys[v] = std::make_pair(BGLgeom::sfc_key<dim>(G[v].coordinates, lo, extent, curve), v);
+	std::sort(keys.begin(), keys.end());
+	for(std::size_t i = 0; i < n; ++i)
+		new_index[keys[i].second] = i;
+	return new_index;
+}	//spatial_order
+
+/*!
+	@brief	Copies a graph storing vertices and edges along a space-filling curve
+
+	The vertices of G_out are the ones of G_in sorted along the curve;
+	the edges are stored in the order of their first extreme (the one
+	with lower new index) and then of the other one, so that the edges
+	incident to close vertices are close in memory. Source and target of
+	each edge, and all the vertex and edge properties, are preserved.
+	G_out has no spare capacity left by previous removals.
+
+	@pre	Both graphs must use boost::vecS as container for the vertices
+	@warning	Edge properties referring to vertices by index (as
+				linear_view_geometry) are copied as they are, so they have
+				to be updated with the returned renumbering; the copied
+				linear_view_geometry has no coordinate map, which has to be
+				set with set_coordinate_map(G_out, M)
+	@warning	With Vertex_store_property the vertices of G_out share the
+				rows of the coordinate_store with the ones of G_in, and the
+				rows are permuted to follow the new numbering: G_in must not
+				be used afterwards
+	@remark	The graph property (if any) is not copied: the indices it may
+			contain (as a vertex_hash) refer to the old numbering
+
+	@param G_in The graph to be reordered
+	@param G_out (Output) The reordered graph. It must be empty
+	@param curve The space-filling curve to be used
+	@return The new index of each vertex (indexed by the old one)
+*/
+template <typename Graph, unsigned int dim>
+std::vector<std::size_t>
+reorder_graph(Graph const& G_in, Graph & G_out, sfc_curve const& curve = sfc_curve::hilbert){
+	const std::size_t n = boost::num_vertices(G_in);
+	std::vector<std::size_t> new_index = BGLgeom::spatial_order<Graph,dim>(G_in, curve);
+
+	// Vertices
+	std::vector<std::size_t> old_index(n);
+	for(std::size_t v = 0; v < n; ++v)
+		old_index[new_index[v]] = v;
+	BGLgeom::reserve_vertices(G_out, n);
+	for(std::size_t i = 0; i < n; ++i)
+		boost::add_vertex(G_in[old_index[i]], G_out);
+
+	// Edges, sorted by their extremes in the new numbering
+	using sorted_edge = std::pair<std::pair<std::size_t, std::size_t>, BGLgeom::Edge_desc<Graph>>;
+	std::vector<sorted_edge> E;
+	E.reserve(boost::num_edges(G_in));
+	std::vector<std::size_t> degree(n, 0);
+	BGLgeom::Edge_iter<Graph> e_it, e_end;
+	for(std::tie(e_it, e_end) = boost::edges(G_in); e_it != e_end; ++e_it){
+		std::size_t s = new_index[boost::source(*e_it, G_in)];
+		std::size_t t = new_index[boost::target(*e_it, G_in)];
+		E.push_back(std::make_pair(std::make_pair(std::min(s,t), std::max(s,t)), *e_it));
+		++degree[s];
+		++degree[t];
+	}
+	std::stable_sort(E.begin(), E.end(),
+					 [](sorted_edge const& a, sorted_edge const& b){ return a.first < b.first; });
+	BGLgeom::reserve_out_edges(G_out, degree);
+	for(auto const& item : E){
+		BGLgeom::Edge_desc<Graph> const& e = item.second;
+		boost::add_edge(new_index[boost::source(e, G_in)],
+						new_index[boost::target(e, G_in)],
+						G_in[e], G_out);
+	}
+	// The vertex properties keeping their data outside the graph follow the new numbering
+	BGLgeom::vertices_renumbered(G_out);
+	return new_index;
+}	//reorder_graph
+
+/*!
+	@brief	Reorders a graph along a space-filling curve, in place
+
+	The graph property is kept, but the indices it may contain refer to
+	the old numbering, so they have to be rebuilt.
+	@see reorder_graph(G_in, G_out, curve)
+
+	@param G The graph to be reordered
+	@param curve The space-filling curve to be used
+	@return The new index of each vertex (indexed by the old one)
+*/
+template <typename Graph, unsigned int dim>
+std::vector<std::size_t>
+reorder_graph(Graph & G, sfc_curve const& curve = sfc_curve::hilbert){
+	Graph G_out;
+	std::vector<std::size_t> new_index = BGLgeom::reorder_graph<Graph,dim>(G, G_out, curve);
+	G_out[boost::graph_bundle] = G[boost::graph_bundle];
+	G.swap(G_out);
+	// The swap copies the vertex properties: the ones keeping their data outside the graph are attached again
+	BGLgeom::vertices_renumbered(G);
+	return new_index;
+}	//reorder_graph (in place)
+
+}	//BGLgeom
+
+#endif	//HH_SPATIAL_REORDER_HH
@@ -0,0 +1,94 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	sweep_intersections.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	All the intersections in a set of segments, with a sweep line
+
+	When all the segments are known in advance, the intersections can be
+	computed all together with the Bentley-Ottmann algorithm instead of
+	testing each segment against all the others: a vertical line sweeps
+	the plane from left to right, and only the segments adjacent along the
+	line are tested. The cost is O((n+k) log n), with n segments and k
+	intersections.
+*/
+
+#ifndef HH_SWEEP_INTERSECTIONS_HH
+#define HH_SWEEP_INTERSECTIONS_HH
+
+#include <iostream>
+#include <vector>
+#include "linear_geometry.hpp"
+#include "intersections2D.hpp"
+
+namespace BGLgeom{
+
+//! An intersection between two segments of a set
+struct segment_intersection{
+	//! Position of the first segment in the set
+	std::size_t first;
+	//! Position of the second segment in the set (first < second)
+	std::size_t second;
+	//! The intersection, as computed by compute_intersection(S[first], S[second])
+	BGLgeom::Intersection I;
+};	//segment_intersection
+
+/*!
+	@brief	Computes all the intersections between the segments of a set
+
+	The sweep line finds the pairs of segments which meet, including the
+	ones which only touch at the extremes or overlap; each pair is then
+	classified by compute_intersection(), so the result (intersection
+	points, intersection_type) is the same one obtained testing the two
+	segments directly, with the segment S[first] as first argument.
+
+	@note	Points closer than TOL (scaled with the size of the set) are
+			considered coincident, as in compute_intersection()
+	@pre	The segments must have non null length: the null ones are ignored
+
+	@param S The segments
+	@return The intersections, ordered by (first, second)
+*/
+std::vector<segment_intersection>
+compute_all_intersections(std::vector<BGLgeom::linear_geometry<2>> const& S);
+
+/*!
+	@brief	Computes all the intersections testing each pair of segments
+
+	Reference implementation, with cost O(n^2): it gives the same result
+	of compute_all_intersections()
+
+	@param S The segments
+	@return The intersections, ordered by (first, second)
+*/
+std::vector<segment_intersection>
+compute_all_intersections_brute_force(std::vector<BGLgeom::linear_geometry<2>> const& S);
+
+//! Overload of operator<<
+std::ostream & operator<<(std::ostream & out, segment_intersection const& SI);
+
+}	//BGLgeom
+
+#endif	//HH_SWEEP_INTERSECTIONS_HH
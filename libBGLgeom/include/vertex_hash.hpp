@@ -0,0 +1,245 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	vertex_hash.hpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Spatial hash to find the vertices of a graph by their coordinates
+*/
+
+#ifndef HH_VERTEX_HASH_HH
+#define HH_VERTEX_HASH_HH
+
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <boost/functional/hash.hpp>
+#include "point.hpp"
+
+namespace BGLgeom{
+
+/*!
+	@brief	Spatial hash of the vertices of a graph
+
+	The space is divided in a uniform grid of cubic cells, and each vertex
+	is stored, together with its coordinates, in the cell containing it.
+	Only the non-empty cells are stored, in a hash table. Looking for a
+	vertex with the same coordinates as a given point (i.e. closer than
+	TOL, as in the operator== for points) only requires to visit the cells
+	that intersect the ball of radius TOL around the point: this is the
+	cell of the point, plus the neighbouring ones when the point is closer
+	than TOL to the boundary of its cell. Hence the search is O(1) instead
+	of a scan over all the vertices of the graph.
+
+	@note	The index has to be kept updated when the graph changes: the
+			functions new_vertex() and remove_vertex() in graph_builder.hpp
+			taking a vertex_hash as argument do this. If the coordinates of
+			a vertex are modified, erase() and insert() have to be called
+	@pre	The vertex descriptors have to be indices, i.e. the graph must use
+			boost::vecS as container for the vertices
+
+	@param dim Dimension of the space
+*/
+template <unsigned int dim>
+class vertex_hash {
+
+	public:
+		using point = BGLgeom::point<dim>;
+
+		/*!
+			@brief	Constructor
+
+			@param _cell_size The size of the cells of the grid. It should be
+					of the same order of the distance between the vertices.
+					It is anyway taken not smaller than TOL
+		*/
+		vertex_hash(double const& _cell_size = 1e-3) :
+			cell_size(std::max(_cell_size, static_cast<double>(TOL))), cells(), n_vertices(0) {};
+
+		//! Copy constructor
+		vertex_hash(vertex_hash const&) = default;
+
+		//! Move constructor
+		vertex_hash(vertex_hash &&) = default;
+
+		//! Assignment operator
+		vertex_hash & operator=(vertex_hash const&) = default;
+
+		//! Move assignment
+		vertex_hash & operator=(vertex_hash &&) = default;
+
+		//! Destructor
+		virtual ~vertex_hash() = default;
+
+		//! Size of the cells
+		double get_cell_size() const { return cell_size; }
+
+		//! Number of vertices in the index
+		std::size_t size() const { return n_vertices; }
+
+		//! Removes all the vertices from the index
+		void
+		clear() { cells.clear(); n_vertices = 0; }
+
+		/*!
+			@brief	(Re)builds the index from all the vertices of a graph
+
+			@param G The graph, whose vertex property contains the coordinates
+		*/
+		template <typename Graph>
+		void
+		build(Graph const& G){
+			this->clear();
+			cells.reserve(num_vertices(G));
+			for(std::size_t v = 0; v < num_vertices(G); ++v)
+				this->insert(v, G[v].coordinates);
+		}
+
+		//! Adds vertex v, with coordinates P, to the index
+		void
+		insert(std::size_t const& v, point const& P){
+			cells[this->cell_of(P)].push_back(std::make_pair(v, P));
+			++n_vertices;
+		}
+
+		/*!
+			@brief	Removes vertex v, with coordinates P, from the index
+
+			@return False if the vertex was not in the index
+		*/
+		bool
+		erase(std::size_t const& v, point const& P){
+			auto c = cells.find(this->cell_of(P));
+			if(c == cells.end())
+				return false;
+			auto & bucket = c->second;
+			for(std::size_t i = 0; i < bucket.size(); ++i)
+				if(bucket[i].first == v){
+					bucket[i] = bucket.back();
+					bucket.pop_back();
+					if(bucket.empty())
+						cells.erase(c);
+					--n_vertices;
+					return true;
+				}
+			return false;
+		}
+
+		/*!
+			@brief	Updates the indices after the removal of vertex v from a graph
+
+			A graph with boost::vecS as vertex container renumbers all the
+			vertices following the removed one. This has to be called after
+			boost::remove_vertex(v, G), and it is linear in the number of vertices
+		*/
+		void
+		renumber_after_removal(std::size_t const& v){
+			for(auto & c : cells)
+				for(auto & item : c.second)
+					if(item.first > v)
+						--item.first;
+		}
+
+		/*!
+			@brief	Looks for a vertex with the same coordinates of P
+
+			Two points have the same coordinates if their distance is less
+			than TOL. If more than one vertex is found, the one with the
+			lowest index is returned, as a linear scan of the vertices would do
+
+			@param P The point to look for
+			@param v (Output) The index of the vertex found
+			@return True if a vertex has been found
+		*/
+		bool
+		find(point const& P, std::size_t & v) const {
+			// Range of cells intersecting the ball of radius TOL around P
+			std::array<long long, dim> lo, hi, key;
+			for(std::size_t j = 0; j < dim; ++j){
+				lo[j] = this->coord_of(P(j) - TOL);
+				hi[j] = this->coord_of(P(j) + TOL);
+			}
+			bool found = false;
+			v = std::numeric_limits<std::size_t>::max();
+			key = lo;
+			while(true){
+				auto c = cells.find(key);
+				if(c != cells.end())
+					for(auto const& item : c->second)
+						if(item.first < v && BGLgeom::operator==(item.second, P)){
+							v = item.first;
+							found = true;
+						}
+				// Next cell in the range (at most 2^dim of them)
+				std::size_t j = 0;
+				while(j < dim && key[j] == hi[j]){
+					key[j] = lo[j];
+					++j;
+				}
+				if(j == dim)
+					break;
+				++key[j];
+			}
+			return found;
+		}
+
+	private:
+		//! Integer coordinates of a cell
+		using cell_key = std::array<long long, dim>;
+
+		//! Hash function for the cells
+		struct cell_key_hash {
+			std::size_t
+			operator() (cell_key const& k) const { return boost::hash_range(k.begin(), k.end()); }
+		};
+
+		//! Size of the cells
+		double cell_size;
+		//! The non-empty cells, with the vertices (and their coordinates) they contain
+		std::unordered_map<cell_key, std::vector<std::pair<std::size_t, point>>, cell_key_hash> cells;
+		//! Number of vertices
+		std::size_t n_vertices;
+
+		//! Integer coordinate of the cell containing x
+		long long
+		coord_of(double const& x) const { return static_cast<long long>(std::floor(x / cell_size)); }
+
+		//! The cell containing P
+		cell_key
+		cell_of(point const& P) const {
+			cell_key k;
+			for(std::size_t j = 0; j < dim; ++j)
+				k[j] = this->coord_of(P(j));
+			return k;
+		}
+
+};	//vertex_hash
+
+}	//BGLgeom
+
+#endif	//HH_VERTEX_HASH_HH
@@ -43,10 +43,10 @@
 
 namespace BGLgeom{
 
-//! Helper function to write a point in a pts file format
-template <unsigned int dim>
+//! Helper function to write a point (of any scalar type) in a pts file format
+template <unsigned int dim, typename Derived>
 void
-write_point_pts(std::ostream & out, BGLgeom::point<dim> const& P){
+write_point_pts(std::ostream & out, Eigen::MatrixBase<Derived> const& P){
 	out << std::setw(16);
 	for(std::size_t i=0; i<dim-1; ++i)
 		out << std::fixed << std::setprecision(8) << P(0,i) << std::setw(16);
@@ -130,6 +130,7 @@ class writer_pts{
 				std::cout << "Writing pts file ..." << std::endl;
 				out_file << "BEGIN_LIST" << std::endl;
 				for(std::tie(e_it, e_end) = BGLgeom::edges(G); e_it != e_end; ++e_it){
+					this->prefetch_next(G, e_it, e_end);
 					this->export_edge(G, *e_it, src, tgt, i);
 				}
 				out_file << "END_LIST";
@@ -152,6 +153,7 @@ class writer_pts{
 				// Writing on file
 				out_file << "BEGIN_LIST" << std::endl;
 				for(std::tie(e_it, e_end) = BGLgeom::edges(G); e_it != e_end; ++e_it){
+					this->prefetch_next(G, e_it, e_end);
 					this->export_info(G, *e_it);
 				}
 				out_file << "END_LIST";
@@ -165,6 +167,21 @@ class writer_pts{
 		//! The name of the ouput file
 		std::string filename;
 	
+		/*!
+			@brief	Asks to load in advance the mesh of the edge following e_it
+
+			It matters only if the meshes are stored on file (see mesh_arena.hpp),
+			so that reading the next mesh overlaps with writing the current one
+		*/
+		void
+		prefetch_next(Graph const& G,
+					  BGLgeom::Edge_iter<Graph> const& e_it,
+					  BGLgeom::Edge_iter<Graph> const& e_end){
+			BGLgeom::Edge_iter<Graph> next = e_it;
+			if(++next != e_end)
+				prefetch_mesh(G[*next].mesh);
+		}
+		
 		/*!
 			@brief Inner method to output a single edge
 			
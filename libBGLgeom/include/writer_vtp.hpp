@@ -32,6 +32,7 @@
 #define HH_WRITER_VTP_HH
 
 #include <string>
+#include "mesh.hpp"
 
 #include <vtkVersion.h>
 #include <vtkSmartPointer.h>
@@ -175,8 +176,13 @@ class writer_vtp{
 			std::cout << "Writing vtp file ..." << std::endl;
 			BGLgeom::Edge_iter<Graph> e_it, e_end;
 			unsigned int n_vertices = 0;
-			for(std::tie(e_it, e_end) = boost::edges(G); e_it != e_end; ++e_it)
-				add_line(*e_it, G, n_vertices);							
+			for(std::tie(e_it, e_end) = boost::edges(G); e_it != e_end; ++e_it){
+				// Loading in advance the mesh of the next edge, if it is stored on file
+				BGLgeom::Edge_iter<Graph> next = e_it;
+				if(++next != e_end)
+					prefetch_mesh(G[*next].mesh);
+				add_line(*e_it, G, n_vertices);
+			}							
 			generate_output(n_vertices);
 			std::cout << "Done" << std::endl;
 		}	
@@ -215,10 +221,10 @@ class writer_vtp{
 				insert_point<dim>(SRC,points);
 				insert_point<dim>(TGT,points);		
 			} else {	// if the Mesh is defined, create the points of the mesh, included source and target
-				double const *P; //it will contain the point coordinates;
-				for(const BGLgeom::point<dim>& point: G[e].mesh.real){
-					P = point.data();
-					insert_point<dim>(P,points);			
+				BGLgeom::point<dim> P; //it will contain the point coordinates (as double, whatever the scalar type of the mesh);
+				for(auto const& point: G[e].mesh.real){
+					P = point.template head<dim>().template cast<double>();
+					insert_point<dim>(P.data(),points);
  				}
 			}	//else
 			
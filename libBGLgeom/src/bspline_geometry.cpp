@@ -36,6 +36,7 @@
 #include <functional>
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
 #include "bspline_geometry.hpp"
 
 using namespace BGLgeom;
@@ -48,8 +49,10 @@ sub2ind (int i, int j, int m, int n)
 { return (i + j * m); }
 
 
-int
-findspan (int n, int p, double t, const vect &U) {
+//! Implementation of findspan, shared by the double and the float overloads
+template <typename T>
+static int
+findspan_impl (int n, int p, T t, std::vector<T> const& U) {
 	int ret = 0;
 	if (t > U[U.size () - 1] || t < U[0]){
 		std::cerr << "Value " << t
@@ -57,20 +60,23 @@ findspan (int n, int p, double t, const vect &U) {
 	            << U[U.size () - 1] - t << "\n";
 	    exit(EXIT_FAILURE);
 	} else {
-		while ((ret++ < n) && (U[ret] <= t)) { };
+		// First knot in U[1..n] greater than t, by binary search
+		ret = std::upper_bound(U.begin()+1, U.begin()+n+1, t) - U.begin();
 	}
 	return (ret-1);
-}	//findspan
+}	//findspan_impl
 
 
-void
-basisfun (int i, double t, int p, const vect &U, vect &N){
+//! Implementation of basisfun, shared by the double and the float overloads
+template <typename T>
+static void
+basisfun_impl (int i, T t, int p, std::vector<T> const& U, std::vector<T> & N){
 	int j,r;
-	double saved, temp;
+	T saved, temp;
 
 	// work space
-	double left[p+1];
-	double right[p+1];
+	T left[p+1];
+	T right[p+1];
 
 	N[0] = 1.0;
 	for (j = 1; j <= p; j++) {
@@ -84,6 +90,20 @@ basisfun (int i, double t, int p, const vect &U, vect &N){
 	    }
 	    N[j] = saved;
 	}
-}	//basisfun
+}	//basisfun_impl
+
+
+int
+findspan (int n, int p, double t, const vect &U) { return findspan_impl(n, p, t, U); }
+
+int
+findspan (int n, int p, float t, std::vector<float> const& U) { return findspan_impl(n, p, t, U); }
+
+
+void
+basisfun (int i, double t, int p, const vect &U, vect &N){ basisfun_impl(i, t, p, U, N); }
+
+void
+basisfun (int i, float t, int p, std::vector<float> const& U, std::vector<float> & N){ basisfun_impl(i, t, p, U, N); }
 
 }	//BGLgeom
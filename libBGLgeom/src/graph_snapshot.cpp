@@ -0,0 +1,95 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	graph_snapshot.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Definition of the memory mapping of the snapshot files
+*/
+
+#include "graph_snapshot.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace BGLgeom{
+
+mapped_file::mapped_file(std::string const& filename) : ptr(nullptr), len(0) {
+	int fd = open(filename.c_str(), O_RDONLY);
+	if(fd < 0){
+		std::cerr << "ERROR! BGLgeom::mapped_file(): cannot open " << filename << ": " << std::strerror(errno) << std::endl;
+		std::cerr << "Aborting" << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	struct stat st;
+	if(fstat(fd, &st) != 0){
+		std::cerr << "ERROR! BGLgeom::mapped_file(): cannot read the size of " << filename << std::endl;
+		std::cerr << "Aborting" << std::endl;
+		close(fd);
+		exit(EXIT_FAILURE);
+	}
+	len = st.st_size;
+	if(len > 0){
+		void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(p == MAP_FAILED){
+			std::cerr << "ERROR! BGLgeom::mapped_file(): cannot map " << filename << ": " << std::strerror(errno) << std::endl;
+			std::cerr << "Aborting" << std::endl;
+			close(fd);
+			exit(EXIT_FAILURE);
+		}
+		ptr = static_cast<char const*>(p);
+	}
+	// The mapping stays valid after closing the file descriptor
+	close(fd);
+}	//mapped_file
+
+mapped_file::mapped_file(mapped_file && other) : ptr(other.ptr), len(other.len) {
+	other.ptr = nullptr;
+	other.len = 0;
+}	//mapped_file (move)
+
+mapped_file &
+mapped_file::operator=(mapped_file && other){
+	if(this != &other){
+		if(ptr != nullptr)
+			munmap(const_cast<char*>(ptr), len);
+		ptr = other.ptr;
+		len = other.len;
+		other.ptr = nullptr;
+		other.len = 0;
+	}
+	return *this;
+}	//operator=
+
+mapped_file::~mapped_file(){
+	if(ptr != nullptr)
+		munmap(const_cast<char*>(ptr), len);
+}	//~mapped_file
+
+}	//BGLgeom
@@ -0,0 +1,261 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	half_edge_graph.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Implementation of the half-edge representation of a planar graph
+*/
+
+#include "half_edge_graph.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace BGLgeom{
+
+const half_edge_graph::index half_edge_graph::null;
+
+namespace{
+
+using index = half_edge_graph::index;
+
+//! Signed area of a polygon
+double
+signed_area(std::vector<BGLgeom::point<2>> const& P){
+	double A = 0;
+	for(std::size_t i = 0, j = P.size()-1; i < P.size(); j = i++)
+		A += P[j](0)*P[i](1) - P[i](0)*P[j](1);
+	return 0.5*A;
+}	//signed_area
+
+//! True if P is inside the polygon (crossing number)
+bool
+inside(BGLgeom::point<2> const& P, std::vector<BGLgeom::point<2>> const& poly){
+	bool in = false;
+	for(std::size_t i = 0, j = poly.size()-1; i < poly.size(); j = i++)
+		if((poly[i](1) > P(1)) != (poly[j](1) > P(1)) &&
+		   P(0) < poly[j](0) + (P(1) - poly[j](1))*(poly[i](0) - poly[j](0))/(poly[i](1) - poly[j](1)))
+			in = !in;
+	return in;
+}	//inside
+
+}	//anonymous
+
+void
+half_edge_graph::build(std::vector<BGLgeom::point<2>> const& P, std::vector<std::pair<index,index>> const& E){
+	coords = P;
+	out.assign(P.size(), null);
+	he.resize(2*E.size());
+	for(std::size_t e = 0; e < E.size(); ++e){
+		he[2*e].origin = E[e].first;
+		he[2*e+1].origin = E[e].second;
+	}
+
+	// The half-edges leaving each vertex, sorted by angle
+	std::vector<std::size_t> first(P.size()+1, 0);
+	for(half_edge const& h : he)
+		++first[h.origin+1];
+	for(std::size_t v = 0; v < P.size(); ++v)
+		first[v+1] += first[v];
+	std::vector<index> around(he.size());
+	std::vector<double> angle(he.size());
+	{
+		std::vector<std::size_t> pos(first.begin(), first.end()-1);
+		for(index h = 0; h < he.size(); ++h){
+			around[pos[he[h].origin]++] = h;
+			const BGLgeom::point<2> d = coords[this->target(h)] - coords[he[h].origin];
+			angle[h] = std::atan2(d(1), d(0));
+		}
+	}
+	for(std::size_t v = 0; v < P.size(); ++v){
+		std::sort(around.begin() + first[v], around.begin() + first[v+1],
+				  [&](index const& a, index const& b){ return angle[a] < angle[b]; });
+		if(first[v+1] > first[v])
+			out[v] = around[first[v]];
+	}
+
+	// Arriving in v through h, the face on the left continues with the
+	// half-edge leaving v which precedes the twin of h counterclockwise
+	for(std::size_t v = 0; v < P.size(); ++v){
+		const std::size_t k = first[v+1] - first[v];
+		for(std::size_t i = 0; i < k; ++i){
+			const index h = around[first[v] + i]^1;
+			const index n = around[first[v] + (i + k - 1) % k];
+			he[h].next = n;
+			he[n].prev = h;
+		}
+	}
+	this->make_faces();
+}	//build
+
+void
+half_edge_graph::make_faces(){
+	face_he.clear();
+	for(half_edge & h : he)
+		h.face = null;
+	for(index h = 0; h < he.size(); ++h){
+		if(he[h].face != null)
+			continue;
+		const index f = face_he.size();
+		face_he.push_back(h);
+		index g = h;
+		do{
+			he[g].face = f;
+			g = he[g].next;
+		} while(g != h);
+	}
+}	//make_faces
+
+double
+half_edge_graph::face_area(index const& f) const {
+	double A = 0;
+	const index h0 = face_he[f];
+	index h = h0;
+	do{
+		BGLgeom::point<2> const& P = coords[he[h].origin];
+		BGLgeom::point<2> const& Q = coords[this->target(h)];
+		A += P(0)*Q(1) - Q(0)*P(1);
+		h = he[h].next;
+	} while(h != h0);
+	return 0.5*A;
+}	//face_area
+
+std::vector<index>
+half_edge_graph::face_vertices(index const& f) const {
+	std::vector<index> V;
+	const index h0 = face_he[f];
+	index h = h0;
+	do{
+		V.push_back(he[h].origin);
+		h = he[h].next;
+	} while(h != h0);
+	return V;
+}	//face_vertices
+
+index
+half_edge_graph::split_edge(index const& e, BGLgeom::point<2> const& P){
+	// h: u -> v and t: v -> u become h: u -> w and t: w -> u; the new edge
+	// has n0: w -> v and n1: v -> w. Along the two faces:
+	// ... hp, h, hn ...   ->   ... hp, h, n0, hn ...
+	// ... tp, t, tn ...   ->   ... tp, n1, t, tn ...
+	const index h = 2*e, t = 2*e+1;
+	const index n0 = he.size(), n1 = n0 + 1;
+	const index v = he[t].origin, w = coords.size();
+	coords.push_back(P);
+	out.push_back(t);
+	he.resize(he.size() + 2);
+	const index hn = he[h].next, tp = he[t].prev;
+	// If v is the end of a dangling edge, t follows h directly
+	he[n0].origin = w;
+	he[n0].face = he[h].face;
+	he[n0].prev = h;
+	he[n0].next = (hn == t ? n1 : hn);
+	he[n1].origin = v;
+	he[n1].face = he[t].face;
+	he[n1].prev = (tp == h ? n0 : tp);
+	he[n1].next = t;
+	he[he[n0].next].prev = n0;
+	he[he[n1].prev].next = n1;
+	he[h].next = n0;
+	he[t].prev = n1;
+	he[t].origin = w;
+	if(out[v] == t)
+		out[v] = n1;
+	return w;
+}	//split_edge
+
+std::vector<BGLgeom::polygonal_block>
+half_edge_graph::blocks() const {
+	// Connected components
+	std::vector<index> comp(coords.size(), null);
+	std::vector<index> stack;
+	std::size_t n_comp = 0;
+	for(index s = 0; s < coords.size(); ++s){
+		if(comp[s] != null)
+			continue;
+		comp[s] = n_comp;
+		stack.push_back(s);
+		while(!stack.empty()){
+			const index v = stack.back();
+			stack.pop_back();
+			if(out[v] == null)
+				continue;
+			index h = out[v];
+			do{
+				const index w = this->target(h);
+				if(comp[w] == null){
+					comp[w] = n_comp;
+					stack.push_back(w);
+				}
+				h = this->next_around(h);
+			} while(h != out[v]);
+		}
+		++n_comp;
+	}
+
+	// The bounded faces are the blocks; the other ones are the outer
+	// boundaries of the components, which may be holes of a block
+	std::vector<polygonal_block> B;
+	std::vector<std::vector<BGLgeom::point<2>>> outer;
+	std::vector<index> outer_comp;
+	for(index f = 0; f < face_he.size(); ++f){
+		std::vector<BGLgeom::point<2>> poly;
+		for(index v : this->face_vertices(f))
+			poly.push_back(coords[v]);
+		const double A = signed_area(poly);
+		if(A > 0)
+			B.push_back(polygonal_block{f, poly, {}, A});
+		else {
+			outer.push_back(poly);
+			outer_comp.push_back(comp[he[face_he[f]].origin]);
+		}
+	}
+	std::vector<BGLgeom::point<2>> lo, hi;
+	for(polygonal_block const& b : B){
+		lo.push_back(b.boundary[0]);
+		hi.push_back(b.boundary[0]);
+		for(BGLgeom::point<2> const& P : b.boundary){
+			lo.back() = lo.back().cwiseMin(P);
+			hi.back() = hi.back().cwiseMax(P);
+		}
+	}
+	for(std::size_t k = 0; k < outer.size(); ++k){
+		BGLgeom::point<2> const& P = outer[k][0];
+		std::size_t best = B.size();
+		for(std::size_t b = 0; b < B.size(); ++b){
+			if(comp[he[face_he[B[b].face]].origin] == outer_comp[k] ||
+			   (P.array() < lo[b].array()).any() || (P.array() > hi[b].array()).any())
+				continue;
+			if((best == B.size() || B[b].area < B[best].area) && inside(P, B[b].boundary))
+				best = b;
+		}
+		if(best < B.size()){
+			B[best].holes.push_back(outer[k]);
+			B[best].area += signed_area(outer[k]);
+		}
+	}
+	return B;
+}	//blocks
+
+}	//BGLgeom
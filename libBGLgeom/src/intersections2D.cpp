@@ -30,9 +30,12 @@
 */
 
 #include "intersections2D.hpp"
+#include "predicates.hpp"
 #include <iostream>
 #include <iomanip>
 #include <numeric>
+#include <algorithm>
+#include <cmath>
 
 using namespace BGLgeom;
 
@@ -53,8 +56,11 @@ std::pair<bool, std::array<double,2>> solve 	(std::array<std::array<double,2>,2>
 }	//solve
 
 
-Intersection compute_intersection	(linear_geometry<2> const& edge1,
-									linear_geometry<2> const& edge2){
+namespace{
+
+//! The classification with the tolerances, see compute_intersection
+Intersection compute_intersection_tolerance	(linear_geometry<2> const& edge1,
+											linear_geometry<2> const& edge2){
 	Intersection out;
 	linear_edge_interface S1(edge1);
 	linear_edge_interface S2(edge2);
@@ -139,6 +145,12 @@ Intersection compute_intersection	(linear_geometry<2> const& edge1,
 	    //double tol2=tol/len2;
 	    bool inside = (t1>=-0.5*TOL) && (t1<= 1.0+0.5*TOL) && (t2>=-0.5*TOL) && (t2<= 1.0+0.5*TOL);
 	    if (!inside){
+	        // The lines meet outside the segments: the only intersection may be a common extreme
+	        if(out.intersect){
+	            out.intersectionPoint = translate_array_to_eigen(intersectionPoints, out.numberOfIntersections);
+	            compute_intersection_type(out);
+	            return out;
+	        }
 	        // No intersecion, end here
 	        out.how = intersection_type::No_intersection;
 	        return out;
@@ -288,11 +300,111 @@ Intersection compute_intersection	(linear_geometry<2> const& edge1,
 		return out;
 	}
 
+} //compute_intersection_tolerance
+
+//! True if the two points have exactly the same coordinates
+inline bool same_point(point<2> const& P, point<2> const& Q){
+	return P(0) == Q(0) && P(1) == Q(1);
+}
+
+}	//anonymous
+
+Intersection compute_intersection	(linear_geometry<2> const& edge1,
+									linear_geometry<2> const& edge2){
+	Intersection out = compute_intersection_tolerance(edge1, edge2);
+	// The tolerances may give an inconsistent situation: the exact predicates always give a consistent one
+	if(out.how == intersection_type::Something_went_wrong){
+	#ifndef NDEBUG
+		std::cerr << "Intersection not classified with the tolerances: using the exact predicates" << std::endl;
+	#endif
+		out = compute_intersection_exact(edge1, edge2);
+	}
+	return out;
 } //compute_intersection
 
+Intersection compute_intersection_exact	(linear_geometry<2> const& edge1,
+										linear_geometry<2> const& edge2){
+	Intersection out;
+	const std::array<point<2>,2> S1{{edge1.get_source(), edge1.get_target()}};
+	const std::array<point<2>,2> S2{{edge2.get_source(), edge2.get_target()}};
+	// Position of the extremes of each segment with respect to the line of the other one
+	const std::array<double,2> side2{{orient2d(S1[0], S1[1], S2[0]), orient2d(S1[0], S1[1], S2[1])}};
+	if((side2[0] > 0 && side2[1] > 0) || (side2[0] < 0 && side2[1] < 0)){
+		out.how = intersection_type::No_intersection;
+		return out;
+	}
+	const std::array<double,2> side1{{orient2d(S2[0], S2[1], S1[0]), orient2d(S2[0], S2[1], S1[1])}};
+	if((side1[0] > 0 && side1[1] > 0) || (side1[0] < 0 && side1[1] < 0)){
+		out.how = intersection_type::No_intersection;
+		return out;
+	}
+	
+	std::array<point<2>,2> P;
+	auto add_point = [&](point<2> const& X, unsigned int const& i, unsigned int const& j){
+		P[out.numberOfIntersections++] = X;
+		out.endPointIsIntersection[i][j] = true;
+	};
+	// Common extremes
+	for(unsigned int i = 0; i < 2; ++i)
+		for(unsigned int j = 0; j < 2; ++j)
+			if(same_point(S1[i], S2[j])){
+				add_point(S1[i], 0, i);
+				out.endPointIsIntersection[1][j] = true;
+				out.otherEdgePoint[0][i] = j;
+				out.otherEdgePoint[1][j] = i;
+			}
+	out.intersect = true;
+	
+	if(side2[0] == 0 && side2[1] == 0){
+		out.parallel = true;
+		out.collinear = true;
+		if(out.numberOfIntersections == 2){
+			out.identical = true;
+			out.how = intersection_type::Identical;
+			out.intersectionPoint = P;
+			return out;
+		}
+		// The extremes inside the other segment, comparing the coordinate 
+		// which varies more along the (common) line
+		const unsigned int d = (std::abs(S1[1](0) - S1[0](0)) >= std::abs(S1[1](1) - S1[0](1)) ? 0 : 1);
+		auto inside = [d](point<2> const& X, std::array<point<2>,2> const& S){
+			return std::min(S[0](d), S[1](d)) <= X(d) && X(d) <= std::max(S[0](d), S[1](d));
+		};
+		for(unsigned int j = 0; j < 2 && out.numberOfIntersections < 2; ++j)
+			if(!out.endPointIsIntersection[1][j] && inside(S2[j], S1))
+				add_point(S2[j], 1, j);
+		for(unsigned int i = 0; i < 2 && out.numberOfIntersections < 2; ++i)
+			if(!out.endPointIsIntersection[0][i] && inside(S1[i], S2))
+				add_point(S1[i], 0, i);
+		if(out.numberOfIntersections == 0){
+			out.intersect = false;
+			out.how = intersection_type::No_intersection;
+			return out;
+		}
+	} else if(out.numberOfIntersections == 0){
+		// An extreme lying on the line of the other segment lies on the segment
+		for(unsigned int j = 0; j < 2; ++j)
+			if(side2[j] == 0)
+				add_point(S2[j], 1, j);
+		for(unsigned int i = 0; i < 2; ++i)
+			if(side1[i] == 0)
+				add_point(S1[i], 0, i);
+		// Otherwise the segments cross in an inner point
+		if(out.numberOfIntersections == 0){
+			const double t = side1[0] / (side1[0] - side1[1]);
+			P[out.numberOfIntersections++] = S1[0] + t*(S1[1] - S1[0]);
+		}
+	}
+	out.intersectionPoint = P;
+	compute_intersection_type(out);
+	return out;
+} //compute_intersection_exact
+
 	
 void compute_intersection_type(Intersection & out){
 	// Identical and No_intersection cases already handled in compute_intersection
+	// If no situation matches the flags, they are not consistent
+	out.how = intersection_type::Something_went_wrong;
 	// Computing the number of intersection points
 	unsigned int numEndPointIntersections = 0;
 	for(std::size_t i=0; i<2; ++i){
@@ -0,0 +1,165 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	mesh_arena.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Definition of the file mapped in memory used to store the meshes
+*/
+
+#include "mesh_arena.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace BGLgeom{
+
+arena_file::arena_file(std::string const& _filename,
+					   std::size_t const& _budget,
+					   std::size_t const& chunk_size,
+					   bool const& remove) :	filename(_filename),
+												fd(-1),
+												budget(_budget),
+												chunk(),
+												remove_file(remove),
+												end(0),
+												mapped(0),
+												n_mappings(0),
+												segments(),
+												lru(),
+												last_first(0),
+												last_ptr(nullptr),
+												last_pos() {
+	// The chunks have to be multiple of the page size, since they are mapped separately
+	const std::size_t page = sysconf(_SC_PAGESIZE);
+	chunk = ((std::max(chunk_size, page) + page - 1) / page) * page;
+	fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(fd < 0){
+		std::cerr << "ERROR! BGLgeom::arena_file(): cannot open " << filename << ": " << std::strerror(errno) << std::endl;
+		std::cerr << "Aborting" << std::endl;
+		exit(EXIT_FAILURE);
+	}
+}	//arena_file
+
+arena_file::~arena_file(){
+	for(auto & s : segments)
+		munmap(s.second.ptr, s.second.len);
+	close(fd);
+	if(remove_file)
+		unlink(filename.c_str());
+}	//~arena_file
+
+std::size_t
+arena_file::append(void const* data, std::size_t const& bytes){
+	// A block does not cross the end of a chunk, unless it is larger than a
+	// chunk: then it starts a new chunk, and the next block starts after it
+	std::size_t in_chunk = end % chunk;
+	if(in_chunk > 0 && in_chunk + bytes > chunk)
+		end += chunk - in_chunk;
+	const std::size_t offset = end;
+	char const* p = static_cast<char const*>(data);
+	std::size_t written = 0;
+	while(written < bytes){
+		ssize_t w = pwrite(fd, p + written, bytes - written, offset + written);
+		if(w < 0){
+			std::cerr << "ERROR! BGLgeom::arena_file::append(): cannot write on " << filename << ": " << std::strerror(errno) << std::endl;
+			std::cerr << "Aborting" << std::endl;
+			exit(EXIT_FAILURE);
+		}
+		written += w;
+	}
+	end = offset + bytes;
+	if(bytes > chunk && end % chunk > 0)
+		end += chunk - end % chunk;
+	// Keeping the blocks aligned to doubles
+	end = (end + 7) / 8 * 8;
+	return offset;
+}	//append
+
+arena_file::segment &
+arena_file::map_segment(std::size_t const& offset, std::size_t const& bytes){
+	const std::size_t first = offset / chunk;
+	auto it = segments.find(first);
+	if(it != segments.end()){
+		lru.splice(lru.begin(), lru, it->second.lru_pos);
+		return it->second;
+	}
+	const std::size_t len = ((offset % chunk + bytes + chunk - 1) / chunk) * chunk;
+	// Making room for the new segment
+	while(!lru.empty() && mapped + len > budget){
+		auto victim = segments.find(lru.back());
+		munmap(victim->second.ptr, victim->second.len);
+		mapped -= victim->second.len;
+		if(victim->first == last_first)
+			last_ptr = nullptr;
+		segments.erase(victim);
+		lru.pop_back();
+	}
+	void* p = mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, first*chunk);
+	if(p == MAP_FAILED){
+		std::cerr << "ERROR! BGLgeom::arena_file::access(): cannot map " << filename << ": " << std::strerror(errno) << std::endl;
+		std::cerr << "Aborting" << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	mapped += len;
+	++n_mappings;
+	lru.push_front(first);
+	segment s;
+	s.ptr = static_cast<char*>(p);
+	s.len = len;
+	s.lru_pos = lru.begin();
+	return segments.emplace(first, s).first->second;
+}	//map_segment
+
+char const*
+arena_file::access(std::size_t const& offset, std::size_t const& bytes){
+	const std::size_t first = offset / chunk;
+	if(last_ptr == nullptr || first != last_first){
+		segment & s = this->map_segment(offset, bytes);
+		last_ptr = s.ptr;
+		last_pos = s.lru_pos;
+		last_first = first;
+	}
+	else if(last_pos != lru.begin())
+		// A prefetch() may have pushed it back in the list
+		lru.splice(lru.begin(), lru, last_pos);
+	return last_ptr + (offset - first*chunk);
+}	//access
+
+void
+arena_file::prefetch(std::size_t const& offset, std::size_t const& bytes){
+	segment & s = this->map_segment(offset, bytes);
+	const std::size_t page = sysconf(_SC_PAGESIZE);
+	const std::size_t in_seg = offset - (offset / chunk)*chunk;
+	const std::size_t begin = (in_seg / page) * page;
+	const std::size_t stop = std::min(s.len, ((in_seg + bytes + page - 1) / page) * page);
+	madvise(s.ptr + begin, stop - begin, MADV_WILLNEED);
+}	//prefetch
+
+}	//BGLgeom
@@ -0,0 +1,135 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	parallel_intersections.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Implementation of the intersections of a set of segments with
+			more threads
+*/
+
+#include "parallel_intersections.hpp"
+#include "edge_grid.hpp"
+#include "intersections2D.hpp"
+#include "segment_filter.hpp"
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+
+namespace BGLgeom{
+
+namespace{
+
+//! Number of segments in each block of work
+const std::size_t block_size = 1024;
+
+//! True if the segment has null length
+bool
+is_null(BGLgeom::linear_geometry<2> const& S){
+	return (S.get_target() - S.get_source()).norm() == 0;
+}
+
+/*!
+	@brief	Intersections of the segments of a block with the following ones
+
+	@param S The segments
+	@param grid The spatial index of the segments
+	@param first First segment of the block
+	@param last One past the last segment of the block
+	@param out (Output) The intersections, ordered by (first, second)
+*/
+void
+intersect_block(std::vector<BGLgeom::linear_geometry<2>> const& S,
+				BGLgeom::edge_grid<2,std::size_t> const& grid,
+				std::size_t const& first,
+				std::size_t const& last,
+				std::vector<segment_intersection> & out){
+	std::vector<std::size_t> near;
+	BGLgeom::segment_block near_block;
+	for(std::size_t i = first; i < last; ++i){
+		if(is_null(S[i]))
+			continue;
+		// The candidates are ordered by position in S: only the following ones are kept
+		grid.candidates(S[i].get_source(), S[i].get_target(), near);
+		near.erase(near.begin(), std::upper_bound(near.begin(), near.end(), i));
+		near_block.clear();
+		for(std::size_t j : near)
+			near_block.push_back(S[j].get_source(), S[j].get_target());
+		// compute_intersection is called only on the segments not discarded by a first fast test
+		for(std::size_t b = 0; b < near.size(); b += BGLgeom::segment_block::width){
+			std::uint64_t mask = near_block.candidates(S[i].get_source(), S[i].get_target(), b);
+			for(std::size_t k = b; mask != 0; ++k, mask >>= 1){
+				if(!(mask & 1) || is_null(S[near[k]]))
+					continue;
+				segment_intersection SI{i, near[k], BGLgeom::compute_intersection(S[i], S[near[k]])};
+				if(SI.I.intersect)
+					out.push_back(SI);
+			}
+		}
+	}
+}	//intersect_block
+
+}	//anonymous
+
+std::vector<segment_intersection>
+compute_all_intersections_parallel(std::vector<BGLgeom::linear_geometry<2>> const& S,
+								   unsigned int n_threads){
+	if(n_threads == 0)
+		n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+	BGLgeom::edge_grid<2,std::size_t> grid;
+	grid.build_from_segments(S);
+
+	// Each block has its own list, so the threads never write in the same place
+	const std::size_t n_blocks = (S.size() + block_size - 1) / block_size;
+	std::vector<std::vector<segment_intersection>> found(n_blocks);
+	std::atomic<std::size_t> next_block(0);
+	auto work = [&](){
+		for(std::size_t b = next_block++; b < n_blocks; b = next_block++)
+			intersect_block(S, grid, b*block_size, std::min((b+1)*block_size, S.size()), found[b]);
+	};
+	if(n_threads == 1)
+		work();
+	else{
+		std::vector<std::thread> threads;
+		for(unsigned int t = 0; t < n_threads; ++t)
+			threads.emplace_back(work);
+		for(std::thread & t : threads)
+			t.join();
+	}
+
+	// The blocks are joined in order
+	std::size_t n = 0;
+	for(auto const& B : found)
+		n += B.size();
+	std::vector<segment_intersection> out;
+	out.reserve(n);
+	for(auto const& B : found)
+		out.insert(out.end(), B.begin(), B.end());
+	return out;
+}	//compute_all_intersections_parallel
+
+}	//BGLgeom
@@ -0,0 +1,144 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	predicates.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Implementation of the exact orientation test
+*/
+
+#include "predicates.hpp"
+#include <array>
+#include <cstddef>
+
+namespace BGLgeom{
+
+namespace{
+
+//! Unit roundoff of doubles
+const double epsilon = 1.1102230246251565e-16;		// 2^-53
+
+//! Constant to split a double in two halves of 26 bits
+const double splitter = 134217729.0;				// 2^27 + 1
+
+//! Bound of the relative error of the orientation computed in floating point
+const double ccw_error_bound = (3.0 + 16.0*epsilon)*epsilon;
+
+//! x + y = a + b exactly, with x = fl(a + b)
+inline void
+two_sum(double const& a, double const& b, double & x, double & y){
+	x = a + b;
+	const double b_virtual = x - a;
+	const double a_virtual = x - b_virtual;
+	y = (a - a_virtual) + (b - b_virtual);
+}
+
+//! hi + lo = a, with hi and lo of at most 26 bits
+inline void
+split(double const& a, double & hi, double & lo){
+	const double c = splitter*a;
+	hi = c - (c - a);
+	lo = a - hi;
+}
+
+//! x + y = a * b exactly, with x = fl(a * b)
+inline void
+two_product(double const& a, double const& b, double & x, double & y){
+	x = a*b;
+	double a_hi, a_lo, b_hi, b_lo;
+	split(a, a_hi, a_lo);
+	split(b, b_hi, b_lo);
+	y = a_lo*b_lo - (((x - a_hi*b_hi) - a_lo*b_hi) - a_hi*b_lo);
+}
+
+/*!
+	@brief	Adds a double to an expansion
+
+	The components of the expansion are non overlapping and sorted by
+	increasing magnitude; the zero components are removed
+*/
+template <std::size_t N>
+inline void
+grow_expansion(std::array<double,N> & e, std::size_t & n, double const& b){
+	double q = b, sum, h;
+	std::size_t m = 0;
+	for(std::size_t i = 0; i < n; ++i){
+		two_sum(q, e[i], sum, h);
+		q = sum;
+		if(h != 0)
+			e[m++] = h;
+	}
+	if(q != 0)
+		e[m++] = q;
+	n = m;
+}
+
+//! The determinant of orient2d, computed exactly
+double
+orient2d_exact(BGLgeom::point<2> const& a, BGLgeom::point<2> const& b, BGLgeom::point<2> const& c){
+	// ax*by - ax*cy - ay*bx + ay*cx + bx*cy - by*cx: each product is
+	// exactly the sum of two doubles, and they are summed exactly
+	const double factors[6][2] = {{a(0), b(1)}, {-a(0), c(1)}, {-a(1), b(0)},
+								  {a(1), c(0)}, {b(0), c(1)}, {-b(1), c(0)}};
+	std::array<double,12> e;
+	std::size_t n = 0;
+	for(std::size_t i = 0; i < 6; ++i){
+		double x, y;
+		two_product(factors[i][0], factors[i][1], x, y);
+		grow_expansion(e, n, y);
+		grow_expansion(e, n, x);
+	}
+	// The sum of non overlapping components has the sign of the largest one
+	double det = 0;
+	for(std::size_t i = 0; i < n; ++i)
+		det += e[i];
+	return det;
+}	//orient2d_exact
+
+}	//anonymous
+
+double
+orient2d(BGLgeom::point<2> const& a, BGLgeom::point<2> const& b, BGLgeom::point<2> const& c){
+	const double det_left = (a(0) - c(0))*(b(1) - c(1));
+	const double det_right = (a(1) - c(1))*(b(0) - c(0));
+	const double det = det_left - det_right;
+	// If the two products have different signs (or one is zero) there is no cancellation
+	double det_sum;
+	if(det_left > 0){
+		if(det_right <= 0)
+			return det;
+		det_sum = det_left + det_right;
+	} else if(det_left < 0){
+		if(det_right >= 0)
+			return det;
+		det_sum = -det_left - det_right;
+	} else
+		return det;
+	const double bound = ccw_error_bound*det_sum;
+	if(det >= bound || -det >= bound)
+		return det;
+	return orient2d_exact(a, b, c);
+}	//orient2d
+
+}	//BGLgeom
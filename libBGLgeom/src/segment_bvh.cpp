@@ -0,0 +1,312 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	segment_bvh.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Implementation of the closest approach of segments in 3D and of
+			the bounding volume hierarchy
+*/
+
+#include "segment_bvh.hpp"
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <numeric>
+#include <array>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+namespace BGLgeom{
+
+const std::size_t segment_bvh::leaf_size;
+
+namespace{
+
+//! Number of segments in each block of work
+const std::size_t block_size = 1024;
+
+//! Clamps x in [0,1]
+inline double
+clamp01(double const& x){ return x < 0 ? 0 : (x > 1 ? 1 : x); }
+
+//! True if the two segments have an extreme in common, up to the tolerance of compute_intersection()
+bool
+adjacent(BGLgeom::linear_geometry<3> const& S1, BGLgeom::linear_geometry<3> const& S2){
+	const BGLgeom::point<3> A1 = S1.get_source(), B1 = S1.get_target();
+	const BGLgeom::point<3> A2 = S2.get_source(), B2 = S2.get_target();
+	const double tol = TOL*std::max((B1 - A1).norm(), (B2 - A2).norm());
+	return (A1 - A2).norm() <= tol || (A1 - B2).norm() <= tol ||
+		   (B1 - A2).norm() <= tol || (B1 - B2).norm() <= tol;
+}	//adjacent
+
+/*!
+	@brief	Recursively builds the subtree of the segments from first to last
+
+	@param order The segments, in the order of the leaves being built
+	@param c,lo,hi Centres and bounding boxes of the segments
+	@param nodes (Output) The nodes, in depth-first order
+*/
+template <typename Node>
+void
+build_subtree(std::vector<std::size_t> & order,
+			  std::vector<std::array<double,3>> const& c,
+			  std::vector<std::array<double,3>> const& lo,
+			  std::vector<std::array<double,3>> const& hi,
+			  std::size_t const& first,
+			  std::size_t const& last,
+			  std::size_t const& leaf_size,
+			  std::vector<Node> & nodes){
+	const std::size_t me = nodes.size();
+	nodes.push_back(Node());
+	Node N;
+	double c_lo[3], c_hi[3];
+	for(std::size_t j = 0; j < 3; ++j){
+		N.lo[j] = c_lo[j] = std::numeric_limits<double>::max();
+		N.hi[j] = c_hi[j] = std::numeric_limits<double>::lowest();
+	}
+	for(std::size_t k = first; k < last; ++k)
+		for(std::size_t j = 0; j < 3; ++j){
+			N.lo[j] = std::min(N.lo[j], lo[order[k]][j]);
+			N.hi[j] = std::max(N.hi[j], hi[order[k]][j]);
+			c_lo[j] = std::min(c_lo[j], c[order[k]][j]);
+			c_hi[j] = std::max(c_hi[j], c[order[k]][j]);
+		}
+	if(last - first <= leaf_size){
+		N.first = static_cast<std::uint32_t>(first);
+		N.count = static_cast<std::uint32_t>(last - first);
+		nodes[me] = N;
+		return;
+	}
+	// Split at the median of the centres, along the longest side of their box
+	std::size_t axis = 0;
+	for(std::size_t j = 1; j < 3; ++j)
+		if(c_hi[j] - c_lo[j] > c_hi[axis] - c_lo[axis])
+			axis = j;
+	const std::size_t mid = first + (last - first)/2;
+	std::nth_element(order.begin() + first, order.begin() + mid, order.begin() + last,
+					 [&](std::size_t const& a, std::size_t const& b){ return c[a][axis] < c[b][axis]; });
+	build_subtree(order, c, lo, hi, first, mid, leaf_size, nodes);
+	N.first = static_cast<std::uint32_t>(nodes.size());
+	N.count = 0;
+	build_subtree(order, c, lo, hi, mid, last, leaf_size, nodes);
+	nodes[me] = N;
+}	//build_subtree
+
+/*!
+	@brief	Pairs of the segments of a block (in the order of the leaves)
+			with the segments following them in the set
+
+	@param out (Output) The pairs found
+*/
+void
+close_pairs_block(std::vector<BGLgeom::linear_geometry<3>> const& S,
+				  BGLgeom::segment_bvh const& T,
+				  double const& d,
+				  bool const& skip_adjacent,
+				  std::size_t const& first,
+				  std::size_t const& last,
+				  std::vector<segment_proximity> & out){
+	for(std::size_t k = first; k < last; ++k){
+		const std::size_t i = T.original(k);
+		const BGLgeom::point<3> A = S[i].get_source(), B = S[i].get_target();
+		double lo[3], hi[3];
+		for(std::size_t j = 0; j < 3; ++j){
+			lo[j] = std::min(A(j), B(j));
+			hi[j] = std::max(A(j), B(j));
+		}
+		T.for_each_near(lo, hi, d, [&](std::size_t const& h){
+			const std::size_t j = T.original(h);
+			if(j <= i)
+				return;
+			// The bounding boxes of the two segments
+			const BGLgeom::point<3> C = T.source(h), D = T.target(h);
+			for(std::size_t l = 0; l < 3; ++l)
+				if(std::min(C(l), D(l)) > hi[l] + d || std::max(C(l), D(l)) < lo[l] - d)
+					return;
+			segment_proximity SP{i, j, BGLgeom::compute_closest_approach(S[i], S[j])};
+			if(SP.C.distance <= d && !(skip_adjacent && adjacent(S[i], S[j])))
+				out.push_back(SP);
+		});
+	}
+}	//close_pairs_block
+
+}	//anonymous
+
+BGLgeom::closest_approach
+compute_closest_approach(BGLgeom::linear_geometry<3> const& S1, BGLgeom::linear_geometry<3> const& S2){
+	const BGLgeom::point<3> P1 = S1.get_source(), P2 = S2.get_source();
+	const BGLgeom::point<3> d1 = S1.get_target() - P1, d2 = S2.get_target() - P2, r = P1 - P2;
+	const double a = d1.dot(d1), e = d2.dot(d2), f = d2.dot(r);
+	double s = 0, t = 0;
+	if(a == 0 && e == 0){
+		// Two points
+	} else if(a == 0)
+		t = clamp01(f/e);
+	else {
+		const double c = d1.dot(r);
+		if(e == 0)
+			s = clamp01(-c/a);
+		else {
+			// Nearest points of the two lines, then clamped on the segments;
+			// if the segments are (almost) parallel any s is good, s = 0 is taken
+			const double b = d1.dot(d2);
+			const double denom = a*e - b*b;
+			if(denom > 1e-14*a*e)
+				s = clamp01((b*f - c*e)/denom);
+			t = (b*s + f)/e;
+			if(t < 0){
+				t = 0;
+				s = clamp01(-c/a);
+			} else if(t > 1){
+				t = 1;
+				s = clamp01((b - c)/a);
+			}
+		}
+	}
+	BGLgeom::closest_approach C;
+	C.s = s;
+	C.t = t;
+	C.P1 = P1 + s*d1;
+	C.P2 = P2 + t*d2;
+	C.distance = (C.P1 - C.P2).norm();
+	C.intersect = C.distance <= TOL*std::sqrt(std::max(a, e));
+	return C;
+}	//compute_closest_approach
+
+void
+segment_bvh::build(std::vector<BGLgeom::linear_geometry<3>> const& S){
+	nodes.clear();
+	seg.clear();
+	index.clear();
+	if(S.empty())
+		return;
+	std::vector<std::array<double,3>> c(S.size()), lo(S.size()), hi(S.size());
+	for(std::size_t i = 0; i < S.size(); ++i){
+		const BGLgeom::point<3> A = S[i].get_source(), B = S[i].get_target();
+		for(std::size_t j = 0; j < 3; ++j){
+			lo[i][j] = std::min(A(j), B(j));
+			hi[i][j] = std::max(A(j), B(j));
+			c[i][j] = 0.5*(A(j) + B(j));
+		}
+	}
+	index.resize(S.size());
+	std::iota(index.begin(), index.end(), 0);
+	nodes.reserve(2*S.size()/leaf_size + 1);
+	build_subtree(index, c, lo, hi, 0, S.size(), leaf_size, nodes);
+	seg.resize(S.size());
+	for(std::size_t k = 0; k < S.size(); ++k){
+		const BGLgeom::point<3> A = S[index[k]].get_source(), B = S[index[k]].get_target();
+		for(std::size_t j = 0; j < 3; ++j){
+			seg[k].a[j] = A(j);
+			seg[k].b[j] = B(j);
+		}
+	}
+}	//build
+
+void
+segment_bvh::candidates(BGLgeom::point<3> const& A, BGLgeom::point<3> const& B, double const& d, std::vector<std::size_t> & E) const {
+	E.clear();
+	double lo[3], hi[3];
+	for(std::size_t j = 0; j < 3; ++j){
+		lo[j] = std::min(A(j), B(j));
+		hi[j] = std::max(A(j), B(j));
+	}
+	this->for_each_near(lo, hi, d, [&](std::size_t const& k){
+		for(std::size_t j = 0; j < 3; ++j)
+			if(std::min(seg[k].a[j], seg[k].b[j]) > hi[j] + d || std::max(seg[k].a[j], seg[k].b[j]) < lo[j] - d)
+				return;
+		E.push_back(index[k]);
+	});
+	std::sort(E.begin(), E.end());
+}	//candidates
+
+std::vector<segment_proximity>
+compute_close_pairs(std::vector<BGLgeom::linear_geometry<3>> const& S,
+					double const& d,
+					bool const& skip_adjacent,
+					unsigned int n_threads){
+	if(n_threads == 0)
+		n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+	const segment_bvh T(S);
+
+	// The blocks follow the order of the leaves, so the segments of a block
+	// are near to each other and visit the same nodes
+	const std::size_t n_blocks = (S.size() + block_size - 1) / block_size;
+	std::vector<std::vector<segment_proximity>> found(n_blocks);
+	std::atomic<std::size_t> next_block(0);
+	auto work = [&](){
+		for(std::size_t b = next_block++; b < n_blocks; b = next_block++)
+			close_pairs_block(S, T, d, skip_adjacent, b*block_size, std::min((b+1)*block_size, S.size()), found[b]);
+	};
+	if(n_threads == 1)
+		work();
+	else{
+		std::vector<std::thread> threads;
+		for(unsigned int t = 0; t < n_threads; ++t)
+			threads.emplace_back(work);
+		for(std::thread & t : threads)
+			t.join();
+	}
+
+	std::size_t n = 0;
+	for(auto const& B : found)
+		n += B.size();
+	std::vector<segment_proximity> out;
+	out.reserve(n);
+	for(auto const& B : found)
+		out.insert(out.end(), B.begin(), B.end());
+	std::sort(out.begin(), out.end(), [](segment_proximity const& a, segment_proximity const& b){
+		return a.first < b.first || (a.first == b.first && a.second < b.second);
+	});
+	return out;
+}	//compute_close_pairs
+
+std::vector<segment_proximity>
+compute_close_pairs_brute_force(std::vector<BGLgeom::linear_geometry<3>> const& S,
+								double const& d,
+								bool const& skip_adjacent){
+	std::vector<segment_proximity> out;
+	for(std::size_t i = 0; i < S.size(); ++i)
+		for(std::size_t j = i+1; j < S.size(); ++j){
+			segment_proximity SP{i, j, BGLgeom::compute_closest_approach(S[i], S[j])};
+			if(SP.C.distance <= d && !(skip_adjacent && adjacent(S[i], S[j])))
+				out.push_back(SP);
+		}
+	return out;
+}	//compute_close_pairs_brute_force
+
+std::ostream &
+operator<<(std::ostream & out, segment_proximity const& SP){
+	out << "Segments " << SP.first << " and " << SP.second << ": distance " << SP.C.distance;
+	if(SP.C.intersect)
+		out << " (intersecting)";
+	out << ", between (" << SP.C.P1(0) << " " << SP.C.P1(1) << " " << SP.C.P1(2) << ") and ("
+		<< SP.C.P2(0) << " " << SP.C.P2(1) << " " << SP.C.P2(2) << ")";
+	return out;
+}	//operator<<
+
+}	//BGLgeom
@@ -0,0 +1,115 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	segment_filter.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Implementation of the fast test of a segment against many segments
+*/
+
+#include "segment_filter.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace BGLgeom{
+
+const std::size_t segment_block::width;
+
+void
+segment_block::clear(){
+	x0.clear();
+	y0.clear();
+	x1.clear();
+	y1.clear();
+	len.clear();
+}	//clear
+
+void
+segment_block::reserve(std::size_t const& n){
+	x0.reserve(n);
+	y0.reserve(n);
+	x1.reserve(n);
+	y1.reserve(n);
+	len.reserve(n);
+}	//reserve
+
+void
+segment_block::push_back(BGLgeom::point<2> const& A, BGLgeom::point<2> const& B){
+	x0.push_back(A(0));
+	y0.push_back(A(1));
+	x1.push_back(B(0));
+	y1.push_back(B(1));
+	len.push_back((B - A).norm());
+}	//push_back
+
+std::uint64_t
+segment_block::candidates(BGLgeom::point<2> const& A, BGLgeom::point<2> const& B, std::size_t const& first) const {
+	if(first >= size())
+		return 0;
+	const std::size_t n = std::min(width, size() - first);
+	const double ax = A(0), ay = A(1), bx = B(0), by = B(1);
+	const double ex = bx - ax, ey = by - ay;
+	const double l = std::sqrt(ex*ex + ey*ey);
+	const double xmin = std::min(ax, bx), xmax = std::max(ax, bx);
+	const double ymin = std::min(ay, by), ymax = std::max(ay, by);
+	double const* X0 = x0.data() + first;
+	double const* Y0 = y0.data() + first;
+	double const* X1 = x1.data() + first;
+	double const* Y1 = y1.data() + first;
+	double const* L = len.data() + first;
+
+	// compute_intersection finds intersections up to a distance of about
+	// TOL times the length of the longer segment: a segment is discarded
+	// only if it is farther than four times this distance. The cross
+	// products below are computed on differences of points near to each
+	// other, so their rounding errors are much smaller than this margin.
+	// The coordinates are copied in local values and the result is stored
+	// as a double, otherwise the compiler does not vectorize the loop
+	double keep[width];
+	for(std::size_t k = 0; k < n; ++k){
+		const double px = X0[k], py = Y0[k], qx = X1[k], qy = Y1[k], lk = L[k];
+		const double m = 4*TOL*std::max(l, lk);
+		// Bounding boxes
+		const bool apart = (std::min(px, qx) > xmax + m) | (std::max(px, qx) < xmin - m) |
+						   (std::min(py, qy) > ymax + m) | (std::max(py, qy) < ymin - m);
+		// Segment k on one side of the line through A and B
+		const double c0 = ex*(py - ay) - ey*(px - ax);
+		const double c1 = ex*(qy - ay) - ey*(qx - ax);
+		const double m_AB = m*l;
+		const bool side_k = ((c0 > m_AB) & (c1 > m_AB)) | ((c0 < -m_AB) & (c1 < -m_AB));
+		// A and B on one side of the line of segment k
+		const double fx = qx - px, fy = qy - py;
+		const double d0 = fx*(ay - py) - fy*(ax - px);
+		const double d1 = fx*(by - py) - fy*(bx - px);
+		const double m_k = m*lk;
+		const bool side_AB = ((d0 > m_k) & (d1 > m_k)) | ((d0 < -m_k) & (d1 < -m_k));
+		keep[k] = (apart | side_k | side_AB) ? 0.0 : 1.0;
+	}
+	std::uint64_t mask = 0;
+	for(std::size_t k = 0; k < n; ++k)
+		mask |= static_cast<std::uint64_t>(keep[k] != 0) << k;
+	return mask;
+}	//candidates
+
+}	//BGLgeom
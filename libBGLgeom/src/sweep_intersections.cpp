@@ -0,0 +1,414 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	sweep_intersections.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Implementation of the sweep line for the intersections of a set
+			of segments
+*/
+
+#include "sweep_intersections.hpp"
+#include <map>
+#include <set>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <cmath>
+
+namespace BGLgeom{
+
+namespace{
+
+//! Position of an event: the events are processed in lexicographic order (x, then y)
+using event_key = std::pair<double,double>;
+
+//! The segments which start, end or pass through an event point
+struct sweep_event{
+	//! Segments whose left extreme is the event point
+	std::vector<std::size_t> start;
+	//! Segments whose right extreme is the event point
+	std::vector<std::size_t> end;
+	//! Segments crossing each other in the event point
+	std::vector<std::size_t> cross;
+};	//sweep_event
+
+//! A segment, with the extremes ordered as they are met by the sweep line
+struct sweep_segment{
+	//! Left extreme
+	double x0, y0;
+	//! Right extreme (the upper one for vertical segments)
+	double x1, y1;
+	//! Slope (+infinity for vertical segments)
+	double slope;
+};	//sweep_segment
+
+/*!
+	@brief	The Bentley-Ottmann sweep line
+
+	The events (extremes of the segments and intersections found so far)
+	are kept in a map ordered lexicographically; the segments intersected
+	by the sweep line (the status) are kept in a set ordered by their
+	ordinate on the line, and, for segments passing through the same point,
+	by their slope, i.e. by their order just after the line. At each event
+	the segments passing through the event point are removed and the ones
+	which continue are inserted again in their new order, so only the new
+	neighbours in the status have to be tested.
+
+	The vertical segments are not inserted in the status: when the sweep
+	line reaches one of them, all the segments of the status in its range
+	intersect it; while the sweep line is on it, it passes through all the
+	event points in its range (the events are ordered by y for the same x).
+
+	The points closer than eps are considered coincident: events closer
+	than eps are merged, and the segments closer than eps to an event point
+	are considered passing through it. Since the pairs found are classified
+	again by compute_intersection(), the sweep line only has to find all
+	the pairs which may intersect.
+*/
+class sweep_line{
+	public:
+		//! Constructor: creates the events of the extremes of the segments
+		sweep_line(std::vector<BGLgeom::linear_geometry<2>> const& S);
+
+		//! Runs the sweep, returning the pairs of segments which may intersect (with repetitions)
+		std::vector<std::pair<std::size_t,std::size_t>> run();
+
+	private:
+		//! Ordering of the segments along the sweep line
+		struct status_less{
+			sweep_line const* sweep;
+			bool operator()(std::size_t const& a, std::size_t const& b) const { return sweep->less(a, b); }
+		};
+		using status_t = std::set<std::size_t, status_less>;
+
+		//! Index used for the fictitious segment used in the lookups
+		static constexpr std::size_t probe = std::numeric_limits<std::size_t>::max();
+
+		//! The segments
+		std::vector<BGLgeom::linear_geometry<2>> const& geometry;
+		//! The segments, as seen by the sweep line
+		std::vector<sweep_segment> seg;
+		//! Events still to be processed
+		std::map<event_key, sweep_event> queue;
+		//! Segments intersected by the sweep line
+		status_t status;
+		//! Position of each segment in the status
+		std::vector<status_t::iterator> pos;
+		//! True if the segment is in the status
+		std::vector<bool> active;
+		//! True if the sweep line has passed the right extreme of the segment
+		std::vector<bool> done;
+		//! The vertical segments on the sweep line, ordered by their upper extreme
+		std::multimap<double, std::size_t> verticals;
+		//! Abscissa of the vertical segments in verticals
+		double verticals_x;
+		//! The pairs found
+		std::vector<std::pair<std::size_t,std::size_t>> pairs;
+		//! Current event point
+		double px, py;
+		//! Ordinate and slope of the fictitious segment used in the lookups
+		double probe_y, probe_slope;
+		//! Tolerance on distances
+		double eps;
+
+		//! True if the segment is vertical
+		bool is_vertical(std::size_t const& i) const { return std::isinf(seg[i].slope); }
+
+		//! Ordinate of a (non vertical) segment on the sweep line
+		double
+		y_at(std::size_t const& i) const {
+			if(i == probe)
+				return probe_y;
+			sweep_segment const& s = seg[i];
+			if(px <= s.x0)
+				return s.y0;
+			if(px >= s.x1)
+				return s.y1;
+			return s.y0 + (px - s.x0)*s.slope;
+		}
+
+		//! Slope of a segment
+		double slope(std::size_t const& i) const { return i == probe ? probe_slope : seg[i].slope; }
+
+		//! Order of the segments just after the current event point
+		bool
+		less(std::size_t const& a, std::size_t const& b) const {
+			if(a == b)
+				return false;
+			const double ya = y_at(a), yb = y_at(b);
+			if(ya < yb - eps)
+				return true;
+			if(yb < ya - eps)
+				return false;
+			const double sa = slope(a), sb = slope(b);
+			if(sa != sb)
+				return sa < sb;
+			return a < b;
+		}
+
+		//! True if the segment passes through the current event point
+		bool
+		passes_through(std::size_t const& i) const {
+			if(std::abs(y_at(i) - py) <= eps)
+				return true;
+			sweep_segment const& s = seg[i];
+			const double dx = s.x1 - s.x0, dy = s.y1 - s.y0;
+			const double t = std::min(1.0, std::max(0.0, ((px - s.x0)*dx + (py - s.y0)*dy) / (dx*dx + dy*dy)));
+			return std::hypot(s.x0 + t*dx - px, s.y0 + t*dy - py) <= eps;
+		}
+
+		//! The event in (x,y), or an existing one closer than eps, if any
+		std::map<event_key, sweep_event>::iterator add_event(double const& x, double const& y);
+
+		//! Processes the event in the current event point
+		void handle(sweep_event const& ev);
+
+		//! Tests two segments adjacent in the status, adding the events of their intersections
+		void test(std::size_t const& a, std::size_t const& b);
+};	//sweep_line
+
+constexpr std::size_t sweep_line::probe;
+
+sweep_line::sweep_line(std::vector<BGLgeom::linear_geometry<2>> const& S) :	geometry(S),
+																				seg(S.size()),
+																				queue(),
+																				status(status_less{this}),
+																				pos(S.size()),
+																				active(S.size(), false),
+																				done(S.size(), false),
+																				verticals(),
+																				verticals_x(0),
+																				pairs(),
+																				px(0), py(0),
+																				probe_y(0), probe_slope(0),
+																				eps(0) {
+	double extent = 1.0;
+	if(!S.empty()){
+		BGLgeom::point<2> lo = S[0].get_source(), hi = lo;
+		for(BGLgeom::linear_geometry<2> const& g : S){
+			lo = lo.cwiseMin(g.get_source()).cwiseMin(g.get_target());
+			hi = hi.cwiseMax(g.get_source()).cwiseMax(g.get_target());
+		}
+		extent = std::max(extent, (hi - lo).maxCoeff());
+	}
+	eps = TOL*extent;
+
+	for(std::size_t i = 0; i < S.size(); ++i){
+		BGLgeom::point<2> P = S[i].get_source(), Q = S[i].get_target();
+		if((Q - P).norm() == 0)
+			continue;	// null segments are ignored
+		if(Q(0) < P(0) || (Q(0) == P(0) && Q(1) < P(1)))
+			std::swap(P, Q);
+		sweep_segment & s = seg[i];
+		s.x0 = P(0); s.y0 = P(1);
+		s.x1 = Q(0); s.y1 = Q(1);
+		s.slope = (s.x1 == s.x0 ? std::numeric_limits<double>::infinity() : (s.y1 - s.y0)/(s.x1 - s.x0));
+		add_event(s.x0, s.y0)->second.start.push_back(i);
+		add_event(s.x1, s.y1)->second.end.push_back(i);
+	}
+}	//sweep_line
+
+std::map<event_key, sweep_event>::iterator
+sweep_line::add_event(double const& x, double const& y){
+	// Looking for an event in the box [x-eps, x+eps] x [y-eps, y+eps]
+	auto it = queue.lower_bound(event_key(x - eps, y - eps));
+	while(it != queue.end() && it->first.first <= x + eps){
+		if(it->first.second < y - eps)
+			it = queue.lower_bound(event_key(it->first.first, y - eps));
+		else if(it->first.second > y + eps)
+			it = queue.upper_bound(event_key(it->first.first, std::numeric_limits<double>::infinity()));
+		else
+			return it;
+	}
+	return queue.emplace(event_key(x, y), sweep_event()).first;
+}	//add_event
+
+void
+sweep_line::test(std::size_t const& a, std::size_t const& b){
+	BGLgeom::Intersection I = BGLgeom::compute_intersection(geometry[a], geometry[b]);
+	if(!I.intersect)
+		return;
+	pairs.emplace_back(std::min(a,b), std::max(a,b));
+	// The segments have to be swapped in the status when the sweep line reaches the intersection
+	for(unsigned int k = 0; k < I.numberOfIntersections; ++k){
+		const double qx = I.intersectionPoint[k](0), qy = I.intersectionPoint[k](1);
+		if(std::abs(qx - px) <= eps && std::abs(qy - py) <= eps)
+			continue;
+		if(event_key(qx, qy) < event_key(px, py))
+			continue;
+		sweep_event & ev = add_event(qx, qy)->second;
+		ev.cross.push_back(a);
+		ev.cross.push_back(b);
+	}
+}	//test
+
+void
+sweep_line::handle(sweep_event const& ev){
+	// All the segments passing through the event point: the ones in the status close to it ...
+	std::vector<std::size_t> through;
+	probe_y = py - eps;
+	probe_slope = -std::numeric_limits<double>::infinity();
+	for(auto it = status.lower_bound(probe); it != status.end() && y_at(*it) <= py + 2*eps; ++it)
+		if(passes_through(*it))
+			through.push_back(*it);
+	// ... the ones known to cross here, and the ones starting or ending here
+	for(std::size_t const& i : ev.cross)
+		if(active[i])
+			through.push_back(i);
+	for(std::size_t const& i : ev.end){
+		if(active[i])
+			through.push_back(i);
+		done[i] = true;
+	}
+	through.insert(through.end(), ev.start.begin(), ev.start.end());
+	// ... and the vertical segments on the sweep line which have not ended yet
+	if(std::abs(verticals_x - px) > eps)
+		verticals.clear();
+	verticals_x = px;
+	verticals.erase(verticals.begin(), verticals.lower_bound(py - eps));
+	for(auto const& v : verticals)
+		through.push_back(v.second);
+	std::sort(through.begin(), through.end());
+	through.erase(std::unique(through.begin(), through.end()), through.end());
+
+	// All of them meet in the event point
+	for(std::size_t i = 0; i < through.size(); ++i)
+		for(std::size_t j = i+1; j < through.size(); ++j)
+			pairs.emplace_back(through[i], through[j]);
+
+	// The new vertical segments intersect all the segments of the status in their range
+	for(std::size_t const& i : ev.start){
+		if(!is_vertical(i))
+			continue;
+		probe_y = seg[i].y0 - eps;
+		probe_slope = -std::numeric_limits<double>::infinity();
+		for(auto it = status.lower_bound(probe); it != status.end() && y_at(*it) <= seg[i].y1 + 2*eps; ++it)
+			pairs.emplace_back(std::min(i, *it), std::max(i, *it));
+		verticals.emplace(seg[i].y1, i);
+	}
+
+	// Removing them from the status, and inserting the ones which continue after the event point.
+	// The segments whose neighbours may change are the reinserted ones and the neighbours of the
+	// removed ones (usually the two segments around the event point)
+	std::vector<std::size_t> reinsert, touched;
+	for(std::size_t const& i : through){
+		if(active[i]){
+			if(pos[i] != status.begin())
+				touched.push_back(*std::prev(pos[i]));
+			if(std::next(pos[i]) != status.end())
+				touched.push_back(*std::next(pos[i]));
+			status.erase(pos[i]);
+			active[i] = false;
+		}
+		if(is_vertical(i))
+			continue;
+		sweep_segment const& s = seg[i];
+		if(std::abs(s.x1 - px) <= eps && std::abs(s.y1 - py) <= eps)
+			done[i] = true;
+		if(!done[i])
+			reinsert.push_back(i);
+	}
+	for(std::size_t const& i : reinsert){
+		pos[i] = status.insert(i).first;
+		active[i] = true;
+	}
+	touched.insert(touched.end(), reinsert.begin(), reinsert.end());
+	std::sort(touched.begin(), touched.end());
+	touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+	// Testing the new neighbours
+	std::vector<std::pair<std::size_t,std::size_t>> tested;
+	for(std::size_t const& i : touched){
+		if(!active[i])
+			continue;
+		if(pos[i] != status.begin())
+			tested.emplace_back(*std::prev(pos[i]), i);
+		if(std::next(pos[i]) != status.end())
+			tested.emplace_back(i, *std::next(pos[i]));
+	}
+	std::sort(tested.begin(), tested.end());
+	tested.erase(std::unique(tested.begin(), tested.end()), tested.end());
+	for(auto const& t : tested)
+		test(t.first, t.second);
+}	//handle
+
+std::vector<std::pair<std::size_t,std::size_t>>
+sweep_line::run(){
+	while(!queue.empty()){
+		auto it = queue.begin();
+		px = it->first.first;
+		py = it->first.second;
+		sweep_event ev(std::move(it->second));
+		queue.erase(it);
+		handle(ev);
+	}
+	return std::move(pairs);
+}	//run
+
+}	//unnamed namespace
+
+std::vector<segment_intersection>
+compute_all_intersections(std::vector<BGLgeom::linear_geometry<2>> const& S){
+	sweep_line sweep(S);
+	std::vector<std::pair<std::size_t,std::size_t>> pairs = sweep.run();
+	std::sort(pairs.begin(), pairs.end());
+	pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+	std::vector<segment_intersection> out;
+	for(auto const& p : pairs){
+		segment_intersection SI{p.first, p.second, BGLgeom::compute_intersection(S[p.first], S[p.second])};
+		if(SI.I.intersect)
+			out.push_back(SI);
+	}
+	return out;
+}	//compute_all_intersections
+
+std::vector<segment_intersection>
+compute_all_intersections_brute_force(std::vector<BGLgeom::linear_geometry<2>> const& S){
+	std::vector<segment_intersection> out;
+	for(std::size_t i = 0; i < S.size(); ++i){
+		if((S[i].get_target() - S[i].get_source()).norm() == 0)
+			continue;
+		for(std::size_t j = i+1; j < S.size(); ++j){
+			if((S[j].get_target() - S[j].get_source()).norm() == 0)
+				continue;
+			segment_intersection SI{i, j, BGLgeom::compute_intersection(S[i], S[j])};
+			if(SI.I.intersect)
+				out.push_back(SI);
+		}
+	}
+	return out;
+}	//compute_all_intersections_brute_force
+
+std::ostream &
+operator<<(std::ostream & out, segment_intersection const& SI){
+	out << "Segments " << SI.first << " and " << SI.second << ":" << std::endl;
+	out << SI.I;
+	return out;
+}	//operator<<
+
+}	//BGLgeom
@@ -0,0 +1,148 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_arrangement_builder.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the construction of the graph of a set of intersecting
+			segments
+
+	A small set with an X intersection, an overlap and a common extreme
+	is built and printed: the labels of the overlapping segments are
+	merged. Then the graph of a set of random segments is built, and we
+	check that its edges meet only in their extremes and that their total
+	length is the one of the segments.
+*/
+
+#include "arrangement_builder.hpp"
+#include "sweep_intersections.hpp"
+#include "graph_access.hpp"
+#include "base_properties.hpp"
+#include "linear_geometry.hpp"
+#include "vertex_hash.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <cmath>
+
+using namespace BGLgeom;
+
+using Graph = boost::adjacency_list< boost::vecS,
+									 boost::vecS,
+									 boost::undirectedS,
+									 Vertex_base_property<2>,
+									 Edge_base_property<linear_geometry<2>,2> >;
+using Vertex_prop = Vertex_base_property<2>;
+using Edge_prop = Edge_base_property<linear_geometry<2>,2>;
+
+//! The labels of the overlapping segments are joined
+void
+join_labels(Edge_prop & current_prop, Edge_prop const& new_prop){
+	current_prop.label += "+" + new_prop.label;
+}
+
+int main(){
+
+	std::cout << "================== ARRANGEMENT BUILDER ======================" << std::endl << std::endl;
+	bool ok = true;
+
+	// A small set
+	std::vector<Vertex_prop> src, tgt;
+	std::vector<Edge_prop> e_prop;
+	auto add = [&](point<2> const& A, point<2> const& B){
+		src.push_back(Vertex_prop(A));
+		tgt.push_back(Vertex_prop(B));
+		e_prop.push_back(Edge_prop());
+		e_prop.back().label = "s" + std::to_string(e_prop.size()-1);
+	};
+	add(point<2>(0,0), point<2>(4,0));
+	add(point<2>(2,-2), point<2>(2,2));		// X with s0
+	add(point<2>(1,0), point<2>(3,0));		// inside s0
+	add(point<2>(4,0), point<2>(4,2));		// common extreme with s0
+
+	Graph G;
+	vertex_hash<2> H(0.5);
+	build_arrangement(src, tgt, e_prop, join_labels, G, H);
+	std::cout << "Small set: " << boost::num_vertices(G) << " vertices, " << boost::num_edges(G) << " edges" << std::endl;
+	Edge_iter<Graph> e_it, e_end;
+	for(std::tie(e_it, e_end) = boost::edges(G); e_it != e_end; ++e_it)
+		std::cout << "\t" << G[*e_it].geometry.get_source() << " -> " << G[*e_it].geometry.get_target()
+				  << ": " << G[*e_it].label << std::endl;
+	ok = ok && boost::num_vertices(G) == 8 && boost::num_edges(G) == 7;
+	std::cout << std::endl;
+
+	// Random segments, with about 10 intersections for each one
+	const std::size_t n = 4000;
+	std::mt19937 gen(5);
+	std::uniform_real_distribution<double> pos(0.0, 1.0), angle(0.0, 4*std::atan(1.0));
+	const double L = 4/std::sqrt(static_cast<double>(n));
+	src.clear();
+	tgt.clear();
+	e_prop.assign(n, Edge_prop());
+	double length = 0;
+	for(std::size_t i = 0; i < n; ++i){
+		point<2> P(pos(gen), pos(gen));
+		const double a = angle(gen);
+		src.push_back(Vertex_prop(P));
+		tgt.push_back(Vertex_prop(P + L*point<2>(std::cos(a), std::sin(a))));
+		length += L;
+	}
+	// compute_intersection writes some messages, which are discarded
+	std::stringstream discard;
+	std::streambuf* cerr_buf = std::cerr.rdbuf(discard.rdbuf());
+	Graph G2;
+	vertex_hash<2> H2(L);
+	auto start = std::chrono::steady_clock::now();
+	build_arrangement(src, tgt, e_prop, [](Edge_prop &, Edge_prop const&){}, G2, H2);
+	auto end = std::chrono::steady_clock::now();
+	std::cerr.rdbuf(cerr_buf);
+	std::cout << "Random set: " << n << " segments, " << boost::num_vertices(G2) << " vertices, " << boost::num_edges(G2)
+			  << " edges, " << std::chrono::duration<double>(end-start).count() << " s" << std::endl;
+
+	// The edges meet only in their extremes
+	std::vector<linear_geometry<2>> edges;
+	double edges_length = 0;
+	for(std::tie(e_it, e_end) = boost::edges(G2); e_it != e_end; ++e_it){
+		edges.push_back(G2[*e_it].geometry);
+		edges_length += G2[*e_it].geometry.length();
+	}
+	cerr_buf = std::cerr.rdbuf(discard.rdbuf());
+	std::vector<segment_intersection> I = compute_all_intersections(edges);
+	std::cerr.rdbuf(cerr_buf);
+	std::size_t n_wrong = 0;
+	for(segment_intersection const& SI : I)
+		if(SI.I.how != intersection_type::Common_extreme)
+			++n_wrong;
+	std::cout << "\tEdges intersecting out of their extremes: " << n_wrong << std::endl;
+	std::cout << "\tLength of the segments: " << length << ", of the edges: " << edges_length << std::endl;
+	ok = ok && n_wrong == 0 && std::abs(length - edges_length) < 1e-8*length;
+
+	std::cout << std::endl << (ok ? "Test passed" : "ERROR: test failed") << std::endl;
+	return ok ? 0 : 1;
+}
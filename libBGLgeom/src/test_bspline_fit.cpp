@@ -0,0 +1,95 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_bspline_fit.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the least squares fitting constructor of bspline_geometry
+	
+	A dense polyline sampled on a helix is fitted with a cubic bspline
+	for decreasing values of the tolerance. For each of them we show the
+	number of control points used and the maximum distance of the points
+	of the polyline from the curve. Since the points are equally spaced,
+	their chord length parameters are uniform, so the curve is evaluated
+	on a uniform mesh with as many points as the polyline. Then a bspline
+	edge fitting the same polyline is added to a graph.
+*/
+
+#include "bspline_geometry.hpp"
+#include "graph_builder.hpp"
+#include "graph_access.hpp"
+#include "base_properties.hpp"
+#include "mesh.hpp"
+#include "point.hpp"
+#include <vector>
+#include <iostream>
+#include <boost/graph/adjacency_list.hpp>
+#include <cmath>
+#include <algorithm>
+
+using namespace BGLgeom;
+
+int main(){
+	
+	const double pi = std::atan(1.0)*4.0;
+	
+	// Polyline on a helix: 10^4 points
+	const std::size_t n_pts = 10000;
+	std::vector<point<3>> P(n_pts);
+	for(std::size_t i = 0; i < n_pts; ++i){
+		double s = 4.0*pi*i/(n_pts-1);
+		P[i] = point<3>(std::cos(s), std::sin(s), 0.1*s);
+	}
+	
+	std::cout << "================== BSPLINE FITTING ======================" << std::endl << std::endl;
+	std::cout << "Fitting a helix sampled with " << n_pts << " points" << std::endl << std::endl;
+	std::cout << "tolerance\tcontrol points\tmax distance" << std::endl;
+	std::vector<double> tols{1e-2, 1e-3, 1e-4};
+	for(double tol : tols){
+		bspline_geometry<3,3> B(P, tol);
+		mesh<3> M;
+		M.uniform_mesh(n_pts-1, B);
+		double dist = 0.0;
+		for(std::size_t i = 0; i < n_pts; ++i)
+			dist = std::max(dist, (P[i] - M.real[i]).norm());
+		std::cout << tol << "\t\t" << B.get_num_control_points() << "\t\t" << dist << std::endl;
+	}
+	std::cout << std::endl;
+	
+	std::cout << "==================== ON GRAPH ======================" << std::endl;
+	using Graph = boost::adjacency_list< boost::vecS, 
+										 boost::vecS, 
+										 boost::directedS, 
+										 Vertex_base_property<3>, 
+										 Edge_base_property<bspline_geometry<>,3> >;
+	Graph G;
+	Vertex_desc<Graph> a = new_vertex(Vertex_base_property<3>(P.front()), G);
+	Vertex_desc<Graph> b = new_vertex(Vertex_base_property<3>(P.back()), G);
+	Edge_desc<Graph> e = new_bspline_edge<Graph,3>(a, b, P, 1e-3, G);
+	std::cout << "Edge with " << G[e].geometry.get_num_control_points() << " control points" << std::endl;
+	std::cout << "Length: " << G[e].geometry.curv_abs(1.0) << " (exact: " 
+			  << 4.0*pi*std::sqrt(1.01) << ")" << std::endl;
+	
+	return 0;
+}
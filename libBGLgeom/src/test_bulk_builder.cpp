@@ -0,0 +1,131 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_bulk_builder.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the construction of a graph at once from lists of 
+			points and edges
+	
+	A square grid network is given as a "soup" of segments, each one 
+	with its own copy of the extremes, as it is usually read from file. 
+	The graph is built: \n
+	- with new_vertex (using the spatial hash) and new_linear_edge, one
+		segment at a time; \n
+	- with bulk_build_linear, welding the coincident points. \n
+	We check that the two graphs are the same and compare the times. 
+	Finally we check that the segments with coincident extremes and the 
+	loops are discarded only if the points are welded.
+*/
+
+#include "bulk_builder.hpp"
+#include "graph_builder.hpp"
+#include "graph_access.hpp"
+#include "base_properties.hpp"
+#include "linear_geometry.hpp"
+#include "vertex_hash.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <vector>
+#include <iostream>
+#include <chrono>
+
+using namespace BGLgeom;
+
+int main(){
+	
+	using Graph = boost::adjacency_list< boost::vecS, 
+										 boost::vecS, 
+										 boost::undirectedS, 
+										 Vertex_base_property<2>, 
+										 Edge_base_property<linear_geometry<2>,2> >;
+	
+	// Grid network with N x N vertices
+	const std::size_t N = 300;
+	const double h = 1.0/(N-1);
+	std::vector<point<2>> pts;
+	edge_list_t segments;
+	for(std::size_t i = 0; i < N; ++i)
+		for(std::size_t j = 0; j < N; ++j){
+			if(i+1 < N){
+				pts.push_back(point<2>(i*h, j*h));
+				pts.push_back(point<2>((i+1)*h, j*h));
+				segments.push_back(std::make_pair(pts.size()-2, pts.size()-1));
+			}
+			if(j+1 < N){
+				pts.push_back(point<2>(i*h, j*h));
+				pts.push_back(point<2>(i*h, (j+1)*h));
+				segments.push_back(std::make_pair(pts.size()-2, pts.size()-1));
+			}
+		}
+	
+	std::cout << "================== BULK BUILDER ======================" << std::endl << std::endl;
+	std::cout << "Grid network: " << segments.size() << " segments, " << pts.size() << " points" << std::endl << std::endl;
+	
+	// One element at a time (the debug output of the functions is redirected)
+	Graph G1;
+	vertex_hash<2> H(h);
+	std::streambuf* cout_buf = std::cout.rdbuf(nullptr);
+	auto start = std::chrono::steady_clock::now();
+	for(auto const& S : segments){
+		Vertex_desc<Graph> src = new_vertex(Vertex_base_property<2>(pts[S.first]), G1, H);
+		Vertex_desc<Graph> tgt = new_vertex(Vertex_base_property<2>(pts[S.second]), G1, H);
+		new_linear_edge(src, tgt, G1);
+	}
+	auto end = std::chrono::steady_clock::now();
+	std::cout.rdbuf(cout_buf);
+	std::cout << "new_vertex + new_linear_edge: " << num_vertices(G1) << " vertices, " << num_edges(G1)
+			  << " edges, " << std::chrono::duration<double>(end-start).count() << " s" << std::endl;
+	
+	// All at once
+	Graph G2;
+	start = std::chrono::steady_clock::now();
+	std::vector<Vertex_desc<Graph>> vmap = bulk_build_linear<Graph,2>(pts, segments, G2, true);
+	end = std::chrono::steady_clock::now();
+	std::cout << "bulk_build_linear:            " << num_vertices(G2) << " vertices, " << num_edges(G2)
+			  << " edges, " << std::chrono::duration<double>(end-start).count() << " s" << std::endl;
+	
+	bool same = (num_vertices(G1) == num_vertices(G2) && num_edges(G1) == num_edges(G2));
+	for(std::size_t v = 0; same && v < num_vertices(G1); ++v)
+		same = (G1[v].coordinates == G2[v].coordinates && out_degree(v,G1) == out_degree(v,G2));
+	Edge_iter<Graph> e1, e1_end, e2, e2_end;
+	std::tie(e1, e1_end) = edges(G1);
+	std::tie(e2, e2_end) = edges(G2);
+	for(; same && e1 != e1_end; ++e1, ++e2)
+		same = (G1[*e1].geometry.get_source() == G2[*e2].geometry.get_source() && 
+				G1[*e1].geometry.get_target() == G2[*e2].geometry.get_target());
+	std::cout << "Same graphs: " << (same ? "yes" : "NO") << std::endl;
+	std::cout << "The last point of the list is vertex " << vmap.back() << std::endl;
+	
+	// A segment with coincident extremes, one with distinct extremes and a loop
+	std::vector<point<2>> loop_pts{point<2>(0,0), point<2>(0,0), point<2>(1,0)};
+	edge_list_t loop_edges{{0,1}, {1,2}, {2,2}};
+	Graph G_weld, G_no_weld;
+	bulk_build_linear<Graph,2>(loop_pts, loop_edges, G_weld, true);
+	bulk_build_linear<Graph,2>(loop_pts, loop_edges, G_no_weld, false);
+	std::cout << "Degenerate segments, welded: " << num_edges(G_weld) << " edges (1 expected); not welded: "
+			  << num_edges(G_no_weld) << " edges (3 expected)" << std::endl;
+	
+	return 0;
+}
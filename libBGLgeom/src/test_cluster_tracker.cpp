@@ -0,0 +1,155 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_cluster_tracker.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the connected components kept updated while a graph is built
+
+	The bonds of a K x K lattice are added in random order to a graph
+	(bond percolation), and some of them are then cut in two pieces at a
+	new vertex, as refine_graph does. At some stages the clusters of the
+	cluster_tracker (number, length, bounding box) and the percolation
+	between the left and the right side are compared with the ones given
+	by boost::connected_components, and the times are printed.
+*/
+
+#include "cluster_tracker.hpp"
+#include "graph_builder.hpp"
+#include "base_properties.hpp"
+#include "linear_geometry.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/connected_components.hpp>
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+using namespace BGLgeom;
+
+int main(){
+
+	using Vertex_prop = Vertex_base_property<2>;
+	using Edge_prop = Edge_base_property<linear_geometry<2>,2>;
+	using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop, Edge_prop>;
+
+	std::cout << "============ CLUSTERS WHILE BUILDING THE GRAPH ============" << std::endl << std::endl;
+	bool ok = true;
+
+	// The lattice and its bonds, in random order
+	const std::size_t K = 100;
+	std::vector<std::pair<std::size_t,std::size_t>> bonds;
+	for(std::size_t i = 0; i < K; ++i)
+		for(std::size_t j = 0; j < K; ++j){
+			if(i+1 < K)
+				bonds.push_back(std::make_pair(i*K+j, (i+1)*K+j));
+			if(j+1 < K)
+				bonds.push_back(std::make_pair(i*K+j, i*K+j+1));
+		}
+	std::mt19937 gen(19);
+	std::shuffle(bonds.begin(), bonds.end(), gen);
+	std::bernoulli_distribution cut(0.2);
+
+	// The builder writes some messages in debug mode, which are discarded here
+	std::stringstream discard;
+	std::streambuf* cout_buf = std::cout.rdbuf(discard.rdbuf());
+	Graph G;
+	vertex_hash<2> H(0.5);
+	edge_grid<2> I;
+	cluster_tracker<2> C;
+	for(std::size_t i = 0; i < K; ++i)
+		for(std::size_t j = 0; j < K; ++j)
+			new_vertex(Vertex_prop(point<2>(i, j)), G, H, C);
+	std::cout.rdbuf(cout_buf);
+
+	double t_tracker = 0, t_bgl = 0;
+	std::vector<std::size_t> root;
+	const std::size_t n_stages = 10;
+	for(std::size_t stage = 1; stage <= n_stages; ++stage){
+		cout_buf = std::cout.rdbuf(discard.rdbuf());
+		for(std::size_t b = (stage-1)*bonds.size()/n_stages; b < stage*bonds.size()/n_stages; ++b){
+			const std::size_t u = bonds[b].first, v = bonds[b].second;
+			if(cut(gen)){
+				// The bond is added, then cut in its midpoint
+				Edge_desc<Graph> e = new_linear_edge(u, v, Edge_prop(), G, I, C);
+				const std::size_t w = new_vertex(Vertex_prop(0.5*(G[u].coordinates + G[v].coordinates)), G, H, C, false);
+				new_linear_edge(u, w, Edge_prop(), G, I, C);
+				new_linear_edge(w, v, Edge_prop(), G, I, C);
+				remove_edge(e, G, I, C);
+			} else
+				new_linear_edge(u, v, Edge_prop(), G, I, C);
+		}
+		std::cout.rdbuf(cout_buf);
+
+		// The clusters from the tracker
+		auto t0 = std::chrono::steady_clock::now();
+		const std::size_t n_clusters = C.num_clusters();
+		const bool percolates = C.percolates(0, 0, K-1);
+		root.resize(boost::num_vertices(G));
+		for(std::size_t v = 0; v < boost::num_vertices(G); ++v)
+			root[v] = C.find(v);
+		auto t1 = std::chrono::steady_clock::now();
+		t_tracker += std::chrono::duration<double>(t1-t0).count();
+
+		// The clusters from a visit of the whole graph
+		t0 = std::chrono::steady_clock::now();
+		std::vector<int> comp(boost::num_vertices(G));
+		const std::size_t n_comp = boost::connected_components(G, &comp[0]);
+		t1 = std::chrono::steady_clock::now();
+		t_bgl += std::chrono::duration<double>(t1-t0).count();
+		std::vector<double> length(n_comp, 0.0);
+		std::vector<point<2>> lo(n_comp, point<2>(K, K)), hi(n_comp, point<2>(-1.0, -1.0));
+		Edge_iter<Graph> e_it, e_end;
+		for(std::tie(e_it, e_end) = boost::edges(G); e_it != e_end; ++e_it)
+			length[comp[boost::source(*e_it, G)]] += G[*e_it].geometry.length();
+		for(std::size_t v = 0; v < boost::num_vertices(G); ++v){
+			lo[comp[v]] = lo[comp[v]].cwiseMin(G[v].coordinates);
+			hi[comp[v]] = hi[comp[v]].cwiseMax(G[v].coordinates);
+		}
+		bool percolates_bgl = false;
+		for(std::size_t c = 0; c < n_comp; ++c)
+			percolates_bgl = percolates_bgl || (lo[c](0) == 0 && hi[c](0) == K-1);
+		std::size_t n_wrong = 0;
+		for(std::size_t v = 0; v < boost::num_vertices(G); ++v){
+			cluster_tracker<2>::cluster_summary const& S = C.cluster(root[v]);
+			n_wrong += (std::abs(S.length - length[comp[v]]) > 1e-9 || S.lo != lo[comp[v]] || S.hi != hi[comp[v]]);
+			// The same root for the vertices of the same component
+			n_wrong += (comp[root[v]] != comp[v]);
+		}
+		std::cout << "Bonds added: " << stage*100/n_stages << "%, " << boost::num_edges(G) << " edges, "
+				  << n_clusters << " clusters (" << n_comp << " with connected_components), percolating: "
+				  << (percolates ? "yes" : "no") << " (" << (percolates_bgl ? "yes" : "no") << "), length of the largest "
+				  << C.cluster(C.widest_cluster(0)).length << ", " << n_wrong << " vertices with a wrong cluster" << std::endl;
+		ok = ok && n_clusters == n_comp && percolates == percolates_bgl && n_wrong == 0;
+	}
+	std::cout << std::endl << "Time to find the cluster of all the vertices after each stage: " << t_tracker
+			  << " s with the tracker, " << t_bgl << " s with connected_components" << std::endl;
+
+	std::cout << std::endl << (ok ? "Test passed" : "ERROR: test failed") << std::endl;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_compact_properties.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the compact vertex and edge properties
+	
+	The same grid is built with the base properties and with the compact 
+	ones. Only 1% of the vertices has a boundary condition, a few vertices 
+	have a label and only 1% of the edges has a mesh. We report the bytes 
+	used by each vertex and by each edge, we check that the pts writer 
+	produces the same file for the two graphs, and that loading a snapshot 
+	does not allocate the boundary conditions and the meshes of the 
+	vertices and edges which do not have them. Finally, we check that the 
+	references to the labels stay valid while the pool grows.
+*/
+
+#include "compact_properties.hpp"
+#include "base_properties.hpp"
+#include "bulk_builder.hpp"
+#include "graph_snapshot.hpp"
+#include "linear_geometry.hpp"
+#include "writer_pts.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+using namespace BGLgeom;
+
+//! Content of a file
+std::string
+read_file(std::string const& filename){
+	std::ifstream in(filename);
+	std::stringstream ss;
+	ss << in.rdbuf();
+	return ss.str();
+}
+
+//! Memory used by a std::string outside the object
+std::size_t
+heap_bytes(std::string const& s){
+	return s.capacity() > 15 ? s.capacity() + 1 : 0;
+}
+
+int main(){
+	
+	using Vertex_prop = Vertex_base_property<2>;
+	using Vertex_prop_compact = Vertex_compact_property<2>;
+	using Edge_prop = Edge_base_property<linear_geometry<2>,2>;
+	using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop, Edge_prop>;
+	using Edge_prop_compact = Edge_compact_property<linear_geometry<2>,2>;
+	using Graph_compact = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop_compact, Edge_prop_compact>;
+	
+	// A 300x300 grid
+	const std::size_t n = 300;
+	std::vector<point<2>> pts;
+	edge_list_t E;
+	for(std::size_t i = 0; i < n; ++i)
+		for(std::size_t j = 0; j < n; ++j){
+			pts.push_back(point<2>(i, j));
+			if(j > 0)
+				E.push_back(std::make_pair(i*n + j - 1, i*n + j));
+			if(i > 0)
+				E.push_back(std::make_pair((i-1)*n + j, i*n + j));
+		}
+	
+	Graph G;
+	bulk_build_linear<Graph,2>(pts, E, G);
+	Graph_compact G_compact;
+	bulk_build_linear<Graph_compact,2>(pts, E, G_compact);
+	
+	// 1% of the vertices with a boundary condition, a few with a label
+	for(std::size_t v = 0; v < num_vertices(G); v += 100){
+		G[v].BC[0] = boundary_condition(BC_type::DIR, 1.0 + v);
+		G_compact[v].BC[0] = boundary_condition(BC_type::DIR, 1.0 + v);
+	}
+	for(std::size_t v = 0; v < num_vertices(G); v += 1000){
+		G[v].label = "inlet_or_outlet_vertex";
+		G_compact[v].label = "inlet_or_outlet_vertex";
+	}
+	
+	// 1% of the edges with a mesh
+	auto e_compact = edges(G_compact).first;
+	std::size_t i_e = 0;
+	for(auto e : boost::make_iterator_range(edges(G))){
+		if(i_e % 200 == 0){
+			G[e].make_uniform_mesh(10);
+			G_compact[*e_compact].make_uniform_mesh(10);
+		}
+		else if(i_e % 200 == 100){
+			G[e].make_variable_mesh(10, [](double x){ return 0.1 + x; });
+			G_compact[*e_compact].make_variable_mesh(10, [](double x){ return 0.1 + x; });
+		}
+		++e_compact;
+		++i_e;
+	}
+	
+	std::cout << "================== COMPACT PROPERTIES ======================" << std::endl << std::endl;
+	std::cout << "Vertices: " << num_vertices(G) << std::endl;
+	std::size_t bytes = 0, bytes_compact = 0;
+	for(std::size_t v = 0; v < num_vertices(G); ++v){
+		bytes += sizeof(Vertex_prop) + heap_bytes(G[v].label);
+		bytes_compact += G_compact[v].bytes();
+	}
+	bytes_compact += label_pool::instance().bytes();
+	std::cout << "sizeof(Vertex_base_property<2>):    " << sizeof(Vertex_prop) << " bytes" << std::endl;
+	std::cout << "sizeof(Vertex_compact_property<2>): " << sizeof(Vertex_prop_compact) << " bytes" << std::endl;
+	std::cout << "Bytes per vertex, base:    " << static_cast<double>(bytes)/num_vertices(G) << std::endl;
+	std::cout << "Bytes per vertex, compact: " << static_cast<double>(bytes_compact)/num_vertices(G) << std::endl << std::endl;
+	
+	bytes = 0;
+	bytes_compact = 0;
+	for(auto e : boost::make_iterator_range(edges(G))){
+		auto const& M = G[e].mesh;
+		bytes += sizeof(Edge_prop) + heap_bytes(G[e].label) + M.real.capacity()*sizeof(point<2>) + M.parametric.capacity()*sizeof(double);
+	}
+	for(auto e : boost::make_iterator_range(edges(G_compact)))
+		bytes_compact += G_compact[e].bytes();
+	std::cout << "Edges: " << num_edges(G) << std::endl;
+	std::cout << "sizeof(Edge_base_property<linear_geometry<2>,2>):    " << sizeof(Edge_prop) << " bytes" << std::endl;
+	std::cout << "sizeof(Edge_compact_property<linear_geometry<2>,2>): " << sizeof(Edge_prop_compact) << " bytes" << std::endl;
+	std::cout << "Bytes per edge, base:    " << static_cast<double>(bytes)/num_edges(G) << std::endl;
+	std::cout << "Bytes per edge, compact: " << static_cast<double>(bytes_compact)/num_edges(G) << std::endl << std::endl;
+	
+	std::cout << "Vertex 100 of the compact graph:" << std::endl << G_compact[100] << std::endl;
+	std::cout << "Edge 100 of the compact graph:" << std::endl << G_compact[*std::next(edges(G_compact).first, 100)] << std::endl;
+	
+	writer_pts<Graph,2> W("../data/out_test_compact_base.pts");
+	W.export_pts(G);
+	writer_pts<Graph_compact,2> W_compact("../data/out_test_compact_compact.pts");
+	W_compact.export_pts(G_compact);
+	std::cout << "Same pts files: " << (read_file("../data/out_test_compact_base.pts") == read_file("../data/out_test_compact_compact.pts") ? "yes" : "NO") << std::endl;
+	
+	// From a snapshot of the base graph to a compact graph
+	save_snapshot<Graph,2>(G, "../data/out_test_compact.snap");
+	Graph_compact G_loaded;
+	load_snapshot<Graph_compact,2>("../data/out_test_compact.snap", G_loaded);
+	std::size_t n_bc = 0;
+	bool same = num_vertices(G_loaded) == num_vertices(G);
+	for(std::size_t v = 0; same && v < num_vertices(G); ++v){
+		Graph_compact const& G_c = G_loaded;
+		n_bc += G_c[v].BC.empty() ? 0 : 1;
+		same = G_c[v].BC[0].type == G[v].BC[0].type && G_c[v].BC[0].value == G[v].BC[0].value && G_c[v].label == G[v].label;
+	}
+	std::cout << "Snapshot loaded in the compact graph: " << (same ? "same vertices" : "DIFFERENT vertices") << ", " << n_bc << " vertices with boundary conditions allocated" << std::endl;
+	std::size_t n_mesh = 0;
+	auto e_loaded = edges(G_loaded).first;
+	same = num_edges(G_loaded) == num_edges(G);
+	for(auto e : boost::make_iterator_range(edges(G))){
+		auto const& M = G[e].mesh;
+		auto const& M_loaded = G_loaded[*e_loaded].mesh;
+		n_mesh += M_loaded.empty() ? 0 : 1;
+		same = same && M.real.size() == M_loaded.real.size() && M.parametric.size() == M_loaded.parametric.size();
+		for(std::size_t i = 0; same && i < M.real.size(); ++i)
+			same = (M.real[i] == M_loaded.real[i]) && (M.parametric[i] == M_loaded.parametric[i]);
+		++e_loaded;
+	}
+	std::cout << "Snapshot loaded in the compact graph: " << (same ? "same meshes" : "DIFFERENT meshes") << ", " << n_mesh << " edges with a mesh allocated" << std::endl;
+	
+	// The references to the labels survive the growth of the pool
+	interned_label first("first_label");
+	std::string const& first_str = first;
+	for(std::size_t i = 0; i < 10000; ++i)
+		interned_label("label_" + std::to_string(i));
+	std::cout << "Reference to a label after adding 10000 labels to the pool: " << first_str
+			  << " (" << (&first_str == &first.str() ? "still valid" : "INVALIDATED") << ")" << std::endl;
+	
+	return 0;
+}
@@ -0,0 +1,192 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_coordinate_store.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the coordinates stored in a contiguous array
+	
+	The same network is built with Vertex_base_property and with 
+	Vertex_store_property. We compute the bounding box and apply a rigid 
+	transformation to all the vertices, gathering the coordinates for the 
+	first graph and working directly on the map of the store for the 
+	second one, and we check that the results and the pts files are the 
+	same. Then we check that the vertices found already in the graph by 
+	new_vertex() take no row of the store, and that the rows follow the 
+	vertices when the graph is reordered along a space-filling curve.
+*/
+
+#include "coordinate_store.hpp"
+#include "base_properties.hpp"
+#include "bulk_builder.hpp"
+#include "graph_builder.hpp"
+#include "spatial_reorder.hpp"
+#include "vertex_hash.hpp"
+#include "linear_geometry.hpp"
+#include "writer_pts.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <Eigen/Dense>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+using namespace BGLgeom;
+
+//! Content of a file
+std::string
+read_file(std::string const& filename){
+	std::ifstream in(filename);
+	std::stringstream ss;
+	ss << in.rdbuf();
+	return ss.str();
+}
+
+int main(){
+	
+	using Vertex_prop = Vertex_base_property<3>;
+	using Vertex_prop_store = Vertex_store_property<3>;
+	using Edge_prop = Edge_base_property<linear_geometry<3>,3>;
+	using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop, Edge_prop>;
+	using Graph_store = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop_store, Edge_prop>;
+	using clock = std::chrono::high_resolution_clock;
+	using matrix_t = Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>;
+	
+	// A 100x100x20 grid of vertices, joined along x
+	const std::size_t n = 100, nz = 20;
+	std::vector<point<3>> pts;
+	edge_list_t E;
+	for(std::size_t k = 0; k < nz; ++k)
+		for(std::size_t i = 0; i < n; ++i)
+			for(std::size_t j = 0; j < n; ++j){
+				pts.push_back(point<3>(j, i + 0.5*k, 0.1*k*k));
+				if(j > 0)
+					E.push_back(std::make_pair(pts.size() - 2, pts.size() - 1));
+			}
+	
+	Graph G;
+	bulk_build_linear<Graph,3>(pts, E, G);
+	coordinate_store<3> store(pts.size());
+	store.make_current();
+	Graph_store G_store;
+	bulk_build_linear<Graph_store,3>(pts, E, G_store);
+	
+	std::cout << "================== COORDINATE STORE ======================" << std::endl << std::endl;
+	std::cout << "Vertices: " << num_vertices(G_store) << ", points in the store: " << store.size() << std::endl;
+	bool by_descriptor = true;
+	for(std::size_t v = 0; v < num_vertices(G_store); ++v)
+		by_descriptor = by_descriptor && store.index(G_store[v].coordinates.data()) == v;
+	std::cout << "Rows of the store indexed by vertex descriptor: " << (by_descriptor ? "yes" : "NO") << std::endl;
+	std::cout << "Map of all the coordinates without copies: " << (store.all().data() == G_store[0].coordinates.data() ? "yes" : "NO") << std::endl;
+	
+	// Bounding box
+	auto t0 = clock::now();
+	matrix_t X(num_vertices(G), 3);
+	for(std::size_t v = 0; v < num_vertices(G); ++v)
+		X.row(v) = G[v].coordinates;
+	point<3> lo = X.colwise().minCoeff(), hi = X.colwise().maxCoeff();
+	auto t1 = clock::now();
+	point<3> lo_store = store.all().colwise().minCoeff(), hi_store = store.all().colwise().maxCoeff();
+	auto t2 = clock::now();
+	std::cout << "Bounding box: " << lo << " - " << hi << std::endl;
+	std::cout << "Same bounding box: " << ((lo == lo_store && hi == hi_store) ? "yes" : "NO") << std::endl;
+	std::cout << "Time, gathering the coordinates: " << std::chrono::duration<double>(t1 - t0).count() << " s" << std::endl;
+	std::cout << "Time, on the map of the store:   " << std::chrono::duration<double>(t2 - t1).count() << " s" << std::endl;
+	
+	// Rigid transformation: rotation around z and translation
+	Eigen::Matrix3d R;
+	R = Eigen::AngleAxisd(std::atan(1.0), Eigen::Vector3d::UnitZ());
+	point<3> T(1.0, -2.0, 0.5);
+	for(std::size_t v = 0; v < num_vertices(G); ++v)
+		G[v].coordinates = G[v].coordinates*R.transpose() + T;
+	store.all() = (store.all()*R.transpose()).rowwise() + T;
+	for(auto e : boost::make_iterator_range(edges(G))){
+		G[e].geometry.set_source(G[source(e,G)].coordinates);
+		G[e].geometry.set_target(G[target(e,G)].coordinates);
+	}
+	for(auto e : boost::make_iterator_range(edges(G_store))){
+		G_store[e].geometry.set_source(G_store[source(e,G_store)].coordinates);
+		G_store[e].geometry.set_target(G_store[target(e,G_store)].coordinates);
+	}
+	bool same = true;
+	for(std::size_t v = 0; v < num_vertices(G); ++v)
+		same = same && G[v].coordinates == G_store[v].coordinates;
+	std::cout << "Same transformed coordinates: " << (same ? "yes" : "NO") << std::endl;
+	std::cout << "Vertex 1 of the graph with the store:" << std::endl << G_store[1] << std::endl;
+	
+	writer_pts<Graph,3> W("../data/out_test_coordinate_store_base.pts");
+	W.export_pts(G);
+	writer_pts<Graph_store,3> W_store("../data/out_test_coordinate_store_store.pts");
+	W_store.export_pts(G_store);
+	std::cout << "Same pts files: " << (read_file("../data/out_test_coordinate_store_base.pts") == read_file("../data/out_test_coordinate_store_store.pts") ? "yes" : "NO") << std::endl;
+	
+	// Welding: the second vertex in (0,0,0) is found in the hash, and takes no row
+	std::cout << std::endl << "Welding and reordering:" << std::endl;
+	coordinate_store<3> small_store(10);
+	small_store.make_current();
+	Graph_store G_weld;
+	vertex_hash<3> H(0.1);
+	new_vertex(Vertex_prop_store(point<3>(0,0,0)), G_weld, H);
+	new_vertex(Vertex_prop_store(point<3>(0,0,0)), G_weld, H);
+	new_vertex(Vertex_prop_store(point<3>(5,5,5)), G_weld, H);
+	new_vertex(Vertex_prop_store(point<3>(1,0,0)), G_weld, H);
+	new_vertex(Vertex_prop_store(point<3>(4,5,5)), G_weld, H);
+	new_vertex(Vertex_prop_store(point<3>(5,5,5)), G_weld, H);
+	new_linear_edge(0, 2, G_weld);
+	new_linear_edge(1, 3, G_weld);
+	std::cout << "Vertices: " << num_vertices(G_weld) << ", points in the store: " << small_store.size() << std::endl;
+	bool weld_ok = num_vertices(G_weld) == 4 && small_store.size() == 4;
+	for(std::size_t v = 0; v < num_vertices(G_weld); ++v)
+		weld_ok = weld_ok && small_store.index(G_weld[v].coordinates.data()) == v;
+	std::cout << "Point 2 of the store: " << small_store[2] << std::endl;
+	std::cout << "Rows of the store indexed by vertex descriptor: " << (weld_ok ? "yes" : "NO") << std::endl;
+	
+	// Reordering: the rows are permuted with the vertices
+	std::vector<point<3>> before(num_vertices(G_weld));
+	for(std::size_t v = 0; v < num_vertices(G_weld); ++v)
+		before[v] = G_weld[v].coordinates;
+	std::vector<std::size_t> new_index = reorder_graph<Graph_store,3>(G_weld);
+	bool reorder_ok = small_store.size() == 4;
+	for(std::size_t v = 0; v < num_vertices(G_weld); ++v){
+		reorder_ok = reorder_ok && small_store.index(G_weld[v].coordinates.data()) == v;
+		reorder_ok = reorder_ok && small_store[v] == G_weld[v].coordinates;
+	}
+	for(std::size_t v = 0; v < before.size(); ++v)
+		reorder_ok = reorder_ok && G_weld[new_index[v]].coordinates == before[v];
+	for(auto e : boost::make_iterator_range(edges(G_weld)))
+		reorder_ok = reorder_ok && G_weld[e].geometry.get_source() == G_weld[source(e,G_weld)].coordinates
+								&& G_weld[e].geometry.get_target() == G_weld[target(e,G_weld)].coordinates;
+	std::cout << "New indices:";
+	for(std::size_t i : new_index)
+		std::cout << " " << i;
+	std::cout << std::endl;
+	std::cout << "All the coordinates after the reordering:" << std::endl << small_store.all() << std::endl;
+	std::cout << "Rows of the store follow the reordered vertices: " << (reorder_ok ? "yes" : "NO") << std::endl;
+	
+	return 0;
+}
@@ -0,0 +1,126 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_csr_graph.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the compressed sparse row copy of a graph
+	
+	A grid network is built and then copied in compressed sparse row 
+	format. We check that vertices and edges are the same, we compare 
+	the time needed to visit the edges incident to each vertex in the 
+	two graphs, and we produce the pts output for both of them.
+*/
+
+#include "csr_graph.hpp"
+#include "bulk_builder.hpp"
+#include "graph_access.hpp"
+#include "base_properties.hpp"
+#include "linear_geometry.hpp"
+#include "writer_pts.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <vector>
+#include <iostream>
+#include <chrono>
+
+using namespace BGLgeom;
+
+//! Sum over the vertices of the length of their incident edges
+template <typename Graph>
+double
+incident_length(Graph const& G){
+	double sum = 0.0;
+	for(std::size_t v = 0; v < boost::num_vertices(G); ++v){
+		for(auto e : boost::make_iterator_range(boost::out_edges(v, G)))
+			sum += G[e].geometry.length();
+		for(auto e : boost::make_iterator_range(boost::in_edges(v, G)))
+			sum += G[e].geometry.length();
+	}
+	return sum;
+}
+
+int main(){
+	
+	using Vertex_prop = Vertex_base_property<2>;
+	using Edge_prop = Edge_base_property<linear_geometry<2>,2>;
+	using Graph = boost::adjacency_list< boost::vecS, 
+										 boost::vecS, 
+										 boost::bidirectionalS, 
+										 Vertex_prop, 
+										 Edge_prop >;
+	using Graph_csr = csr_graph<Vertex_prop, Edge_prop>;
+	
+	// Grid network with N x N vertices
+	const std::size_t N = 300;
+	const double h = 1.0/(N-1);
+	std::vector<point<2>> pts;
+	edge_list_t E;
+	for(std::size_t i = 0; i < N; ++i)
+		for(std::size_t j = 0; j < N; ++j){
+			pts.push_back(point<2>(i*h, j*h));
+			if(i > 0)
+				E.push_back(std::make_pair((i-1)*N+j, i*N+j));
+			if(j > 0)
+				E.push_back(std::make_pair(i*N+j-1, i*N+j));
+		}
+	Graph G;
+	bulk_build_linear<Graph,2>(pts, E, G);
+	
+	std::cout << "================== CSR GRAPH ======================" << std::endl << std::endl;
+	auto start = std::chrono::steady_clock::now();
+	Graph_csr S = make_csr_snapshot(G);
+	auto end = std::chrono::steady_clock::now();
+	std::cout << "Copy in CSR format: " << num_vertices(S) << " vertices, " << num_edges(S) << " edges, "
+			  << std::chrono::duration<double>(end-start).count() << " s" << std::endl;
+	
+	bool same = (num_vertices(G) == num_vertices(S) && num_edges(G) == num_edges(S));
+	for(std::size_t v = 0; same && v < num_vertices(G); ++v)
+		same = (G[v].coordinates == S[v].coordinates);
+	Edge_iter<Graph> e_it, e_end;
+	for(std::tie(e_it, e_end) = edges(G); same && e_it != e_end; ++e_it){
+		Edge_desc<Graph_csr> e;
+		bool found;
+		std::tie(e, found) = boost::edge(source(*e_it, G), target(*e_it, G), S);
+		same = found && (S[e].geometry.get_source() == G[*e_it].geometry.get_source());
+	}
+	std::cout << "Same vertices and edges: " << (same ? "yes" : "NO") << std::endl << std::endl;
+	
+	std::cout << "Visit of the incident edges of all the vertices:" << std::endl;
+	start = std::chrono::steady_clock::now();
+	double l_G = incident_length(G);
+	end = std::chrono::steady_clock::now();
+	std::cout << "\tadjacency_list: " << l_G << ", " << std::chrono::duration<double>(end-start).count() << " s" << std::endl;
+	start = std::chrono::steady_clock::now();
+	double l_S = incident_length(S);
+	end = std::chrono::steady_clock::now();
+	std::cout << "\tCSR:            " << l_S << ", " << std::chrono::duration<double>(end-start).count() << " s" << std::endl;
+	
+	writer_pts<Graph,2> W1("../data/out_test_csr_adjacency_list.pts");
+	W1.export_pts(G);
+	writer_pts<Graph_csr,2> W2("../data/out_test_csr_snapshot.pts");
+	W2.export_pts(S);
+	
+	return 0;
+}
@@ -0,0 +1,122 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_dof_numbering.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the global numbering of the mesh nodes of a graph
+	
+	A grid network is built inserting the edges in random order, and a 
+	uniform mesh is created on each edge. We number the nodes of all the 
+	meshes with and without Reverse Cuthill-McKee, we compare the bandwidth 
+	of the two numberings, and we check that the nodes found through the 
+	numbering are the points of the meshes, also when the edges are reached 
+	through the out edges of their target. The nodes are written on file 
+	in the new order.
+*/
+
+#include "dof_numbering.hpp"
+#include "bulk_builder.hpp"
+#include "graph_access.hpp"
+#include "base_properties.hpp"
+#include "linear_geometry.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <algorithm>
+
+using namespace BGLgeom;
+
+int main(){
+	
+	using Vertex_prop = Vertex_base_property<2>;
+	using Edge_prop = Edge_base_property<linear_geometry<2>,2>;
+	using Graph = boost::adjacency_list< boost::vecS, 
+										 boost::vecS, 
+										 boost::undirectedS, 
+										 Vertex_prop, 
+										 Edge_prop >;
+	
+	// Grid network with N x N vertices, edges in random order
+	const std::size_t N = 50;
+	const double h = 1.0/(N-1);
+	std::vector<point<2>> pts;
+	edge_list_t E;
+	for(std::size_t i = 0; i < N; ++i)
+		for(std::size_t j = 0; j < N; ++j){
+			pts.push_back(point<2>(i*h, j*h));
+			if(i > 0)
+				E.push_back(std::make_pair((i-1)*N+j, i*N+j));
+			if(j > 0)
+				E.push_back(std::make_pair(i*N+j-1, i*N+j));
+		}
+	std::mt19937 gen(2017);
+	std::shuffle(E.begin(), E.end(), gen);
+	Graph G;
+	bulk_build_linear<Graph,2>(pts, E, G);
+	Edge_iter<Graph> e_it, e_end;
+	for(std::tie(e_it, e_end) = edges(G); e_it != e_end; ++e_it)
+		G[*e_it].make_uniform_mesh(8);
+	
+	std::cout << "================== MESH NODES NUMBERING ======================" << std::endl << std::endl;
+	dof_numbering<Graph,2> natural(G, false);
+	dof_numbering<Graph,2> rcm(G);
+	std::cout << "Number of nodes: " << rcm.size() << ", connections: " << rcm.connections().size() << std::endl;
+	std::cout << "Bandwidth, natural numbering: " << natural.bandwidth() << std::endl;
+	std::cout << "Bandwidth, RCM numbering:     " << rcm.bandwidth() 
+			  << " (natural: " << rcm.natural_bandwidth() << ")" << std::endl;
+	
+	// The nodes found through the numbering are the points of the mesh
+	bool ok = true;
+	for(std::tie(e_it, e_end) = edges(G); e_it != e_end; ++e_it){
+		auto const& real = G[*e_it].mesh.real;
+		for(std::size_t i = 0; i < real.size(); ++i)
+			ok = ok && (rcm.coordinates()[rcm.dof(*e_it, i)] == real[i]);
+	}
+	for(std::size_t v = 0; v < num_vertices(G); ++v)
+		ok = ok && (rcm.coordinates()[rcm.dof(v)] == G[v].coordinates);
+	std::cout << "Nodes consistent with the meshes: " << (ok ? "yes" : "NO") << std::endl;
+	
+	// The same, with the descriptors given by the out edges of the target
+	ok = true;
+	for(std::size_t v = 0; v < num_vertices(G); ++v){
+		boost::graph_traits<Graph>::out_edge_iterator oe_it, oe_end;
+		for(std::tie(oe_it, oe_end) = out_edges(v, G); oe_it != oe_end; ++oe_it){
+			auto const& real = G[*oe_it].mesh.real;
+			for(std::size_t i = 0; i < real.size(); ++i)
+				ok = ok && (rcm.coordinates()[rcm.dof(*oe_it, i)] == real[i]);
+		}
+	}
+	std::cout << "Nodes consistent with the meshes, through the out edges of each vertex: " << (ok ? "yes" : "NO") << std::endl;
+	
+	std::ofstream out("../data/out_test_dof_numbering.txt");
+	for(std::size_t i = 0; i < rcm.size(); ++i)
+		out << i << "\t" << rcm.coordinates()[i].transpose() << std::endl;
+	out.close();
+	
+	return 0;
+}
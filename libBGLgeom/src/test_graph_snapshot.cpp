@@ -0,0 +1,239 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_graph_snapshot.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the binary snapshot of a graph
+	
+	A grid network with labels, indices, boundary conditions and meshes is 
+	saved in a snapshot file. We compare the time needed to build it with 
+	the time needed to map the snapshot in memory and to load it back in a 
+	graph, and we check that the graph is the same. Then we do the same for 
+	small graphs with polyline and bspline geometries. Finally, we corrupt 
+	the records of the polyline snapshot in several ways, and we check that 
+	the corruption is detected when the file is opened.
+*/
+
+#include "graph_snapshot.hpp"
+#include "bulk_builder.hpp"
+#include "graph_builder.hpp"
+#include "graph_access.hpp"
+#include "base_properties.hpp"
+#include "linear_geometry.hpp"
+#include "polyline_geometry.hpp"
+#include "bspline_geometry.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <functional>
+#include <cstddef>
+#include <iostream>
+#include <chrono>
+
+using namespace BGLgeom;
+
+/*!
+	Writes a copy of a snapshot file modified by the function corrupt, and
+	returns the error found checking it (empty if none)
+*/
+std::string
+check_corrupted(std::string const& filename, std::function<void(std::string &)> const& corrupt){
+	std::ifstream in(filename, std::ios::binary);
+	std::stringstream ss;
+	ss << in.rdbuf();
+	std::string content = ss.str();
+	corrupt(content);
+	std::ofstream out("../data/out_test_snapshot_corrupted.snap", std::ios::binary);
+	out << content;
+	out.close();
+	mapped_file file("../data/out_test_snapshot_corrupted.snap");
+	return snapshot_view<2>::check(file.data(), file.size());
+}
+
+//! Checks that two graphs have the same vertices, edges and meshes
+template <typename Graph>
+bool
+same_graph(Graph const& G1, Graph const& G2){
+	if(num_vertices(G1) != num_vertices(G2) || num_edges(G1) != num_edges(G2))
+		return false;
+	for(std::size_t v = 0; v < num_vertices(G1); ++v)
+		if(G1[v].coordinates != G2[v].coordinates || G1[v].label != G2[v].label || G1[v].index != G2[v].index ||
+		   G1[v].BC[0].type != G2[v].BC[0].type || G1[v].BC[0].value != G2[v].BC[0].value)
+			return false;
+	Edge_iter<Graph> e1, e1_end, e2, e2_end;
+	std::tie(e2, e2_end) = edges(G2);
+	for(std::tie(e1, e1_end) = edges(G1); e1 != e1_end; ++e1, ++e2){
+		if(source(*e1,G1) != source(*e2,G2) || target(*e1,G1) != target(*e2,G2) ||
+		   G1[*e1].label != G2[*e2].label || G1[*e1].index != G2[*e2].index ||
+		   G1[*e1].mesh.real != G2[*e2].mesh.real || G1[*e1].mesh.parametric != G2[*e2].mesh.parametric)
+			return false;
+		for(double t : {0.0, 0.3, 1.0})
+			if((G1[*e1].geometry(t) - G2[*e2].geometry(t)).norm() > 1e-14)
+				return false;
+	}
+	return true;
+}
+
+int main(){
+	
+	using Vertex_prop = Vertex_base_property<2>;
+	
+	std::cout << "================== LINEAR GEOMETRY ======================" << std::endl;
+	using Edge_prop = Edge_base_property<linear_geometry<2>,2>;
+	using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop, Edge_prop>;
+	
+	const std::size_t N = 300;
+	const double h = 1.0/(N-1);
+	std::vector<point<2>> pts;
+	edge_list_t E;
+	for(std::size_t i = 0; i < N; ++i)
+		for(std::size_t j = 0; j < N; ++j){
+			pts.push_back(point<2>(i*h, j*h));
+			if(i > 0)
+				E.push_back(std::make_pair((i-1)*N+j, i*N+j));
+			if(j > 0)
+				E.push_back(std::make_pair(i*N+j-1, i*N+j));
+		}
+	auto start = std::chrono::steady_clock::now();
+	Graph G;
+	bulk_build_linear<Graph,2>(pts, E, G, true);
+	int count = 0;
+	Edge_iter<Graph> e_it, e_end;
+	for(std::tie(e_it, e_end) = edges(G); e_it != e_end; ++e_it, ++count){
+		G[*e_it].index = count;
+		if(count % 10 == 0){
+			G[*e_it].label = "e" + std::to_string(count);
+			G[*e_it].make_uniform_mesh(4);
+		}
+	}
+	for(std::size_t i = 0; i < N; ++i){
+		G[i].BC[0] = boundary_condition(BC_type::DIR, 1.0);
+		G[i].label = "inflow";
+		G[i].index = i;
+	}
+	auto end = std::chrono::steady_clock::now();
+	std::cout << "Construction: " << num_vertices(G) << " vertices, " << num_edges(G) << " edges, "
+			  << std::chrono::duration<double>(end-start).count() << " s" << std::endl;
+	
+	start = std::chrono::steady_clock::now();
+	save_snapshot<Graph,2>(G, "../data/out_test_snapshot_linear.snap");
+	end = std::chrono::steady_clock::now();
+	std::cout << "Saving the snapshot: " << std::chrono::duration<double>(end-start).count() << " s" << std::endl;
+	
+	start = std::chrono::steady_clock::now();
+	snapshot_view<2> S("../data/out_test_snapshot_linear.snap");
+	end = std::chrono::steady_clock::now();
+	std::cout << "Mapping the snapshot: " << S.num_vertices() << " vertices, " << S.num_edges() << " edges, "
+			  << std::chrono::duration<double>(end-start).count() << " s" << std::endl;
+	std::cout << "Vertex 1: " << S.coordinates(1) << ", label " << S.vertex_label(1) << ", BC " << S.BC(1) << std::endl;
+	std::cout << "Edge 10: " << S.source(10) << " -> " << S.target(10) << ", label " << S.edge_label(10)
+			  << ", mesh of " << S.mesh_real(10).rows() << " points" << std::endl;
+	
+	start = std::chrono::steady_clock::now();
+	Graph G_load;
+	load_snapshot<Graph,2>(S, G_load);
+	end = std::chrono::steady_clock::now();
+	std::cout << "Loading the snapshot in a graph: " << std::chrono::duration<double>(end-start).count() << " s" << std::endl;
+	std::cout << "Same graph: " << (same_graph(G, G_load) ? "yes" : "NO") << std::endl << std::endl;
+	
+	std::cout << "================== POLYLINE GEOMETRY ======================" << std::endl;
+	using Edge_prop_poly = Edge_base_property<polyline_geometry<2>,2>;
+	using Graph_poly = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop, Edge_prop_poly>;
+	Graph_poly G_poly;
+	std::vector<point<2>> P1{point<2>(0,0), point<2>(0.5,0.2), point<2>(1,0)};
+	std::vector<point<2>> P2{point<2>(1,0), point<2>(1.2,0.5), point<2>(1.1,0.8), point<2>(1,1)};
+	bulk_build_polyline<Graph_poly,2>({point<2>(0,0), point<2>(1,0), point<2>(1,1)}, {{0,1},{1,2}}, {P1,P2}, G_poly);
+	for(auto f : boost::make_iterator_range(edges(G_poly)))
+		G_poly[f].make_uniform_mesh(5);
+	save_snapshot<Graph_poly,2>(G_poly, "../data/out_test_snapshot_polyline.snap");
+	Graph_poly G_poly_load;
+	load_snapshot<Graph_poly,2>("../data/out_test_snapshot_polyline.snap", G_poly_load);
+	std::cout << "Same graph: " << (same_graph(G_poly, G_poly_load) ? "yes" : "NO") << std::endl << std::endl;
+	
+	std::cout << "================== BSPLINE GEOMETRY ======================" << std::endl;
+	using Edge_prop_bsp = Edge_base_property<bspline_geometry<2>,2>;
+	using Graph_bsp = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop, Edge_prop_bsp>;
+	Graph_bsp G_bsp;
+	std::vector<point<2>> C{point<2>(0,0), point<2>(0.3,0.6), point<2>(0.7,-0.2), point<2>(1,0.4), point<2>(1.5,0)};
+	Vertex_desc<Graph_bsp> a = new_vertex(Vertex_prop(C.front()), G_bsp);
+	Vertex_desc<Graph_bsp> b = new_vertex(Vertex_prop(C.back()), G_bsp);
+	Edge_desc<Graph_bsp> e = new_bspline_edge<Graph_bsp,2>(a, b, C, BSP_type::Approx, G_bsp);
+	G_bsp[e].make_uniform_mesh(10);
+	save_snapshot<Graph_bsp,2>(G_bsp, "../data/out_test_snapshot_bspline.snap");
+	Graph_bsp G_bsp_load;
+	load_snapshot<Graph_bsp,2>("../data/out_test_snapshot_bspline.snap", G_bsp_load);
+	std::cout << "Same graph: " << (same_graph(G_bsp, G_bsp_load) ? "yes" : "NO") << std::endl << std::endl;
+	
+	std::cout << "================== CORRUPTED SNAPSHOTS ======================" << std::endl;
+	const std::string poly_file = "../data/out_test_snapshot_polyline.snap";
+	const std::size_t v_start = sizeof(snapshot_header), e_start = v_start + 3*sizeof(snapshot_vertex);
+	// Writes the value x in the file at the given position
+	auto set = [](std::string & content, std::size_t const& pos, std::uint64_t const& x){
+		std::memcpy(&content[pos], &x, sizeof(x));
+	};
+	std::vector<std::pair<std::string, std::function<void(std::string &)>>> cases{
+		{"none", [](std::string &){}},
+		{"truncated file", [](std::string & c){ c.resize(c.size() - 1); }},
+		{"huge number of vertices", [&](std::string & c){ set(c, offsetof(snapshot_header, n_vertices), std::uint64_t(1) << 62); }},
+		{"label of a vertex out of range", [&](std::string & c){ set(c, v_start + offsetof(snapshot_vertex, label_len), 1000); }},
+		{"label offset overflowing", [&](std::string & c){ set(c, v_start + offsetof(snapshot_vertex, label_off), ~std::uint64_t(0)); }},
+		{"target of an edge out of range", [&](std::string & c){ set(c, e_start + offsetof(snapshot_edge, target), 3); }},
+		{"geometry out of range", [&](std::string & c){ set(c, e_start + offsetof(snapshot_edge, geom_off), 100000); }},
+		{"mesh out of range", [&](std::string & c){ set(c, e_start + sizeof(snapshot_edge) + offsetof(snapshot_edge, n_real), 1000); }},
+		{"parametric mesh overflowing", [&](std::string & c){ set(c, e_start + offsetof(snapshot_edge, n_param), ~std::uint64_t(0)); }},
+	};
+	bool detected = true;
+	for(auto const& item : cases){
+		std::string msg = check_corrupted(poly_file, item.second);
+		std::cout << item.first << ": " << (msg.empty() ? "valid" : msg) << std::endl;
+		detected = detected && (msg.empty() == (item.first == "none"));
+	}
+	
+	// Payloads of a bspline: the knots must be nc+deg+1 and nc an integer
+	using bsp_snap = snapshot_geometry<bspline_geometry<2>>;
+	std::vector<double> payload;
+	bsp_snap::write(G_bsp[e].geometry, payload);
+	std::vector<double> missing_knot(payload.begin(), payload.end() - 1), extra_knot(payload), fractional(payload);
+	extra_knot.push_back(1.);
+	fractional[0] += 0.5;
+	std::vector<std::pair<std::string, std::vector<double>>> payloads{
+		{"bspline as written", payload},
+		{"bspline with a knot missing", missing_knot},
+		{"bspline with an extra knot", extra_knot},
+		{"bspline with a fractional number of control points", fractional},
+	};
+	for(auto const& item : payloads){
+		bool valid = bsp_snap::valid(item.second.data(), item.second.size());
+		std::cout << item.first << ": " << (valid ? "valid" : "corrupted geometry") << std::endl;
+		detected = detected && (valid == (item.first == "bspline as written"));
+	}
+	std::cout << "All the corruptions detected: " << (detected ? "yes" : "NO") << std::endl;
+	
+	return 0;
+}
@@ -0,0 +1,164 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_half_edge_graph.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the half-edge representation of a planar graph
+
+	A small network (a square with a diagonal, a fracture ending inside a
+	block and a separate square inside the other block) is built and its
+	blocks are printed, before and after splitting some edges. Then the
+	blocks of a grid network are extracted, all the edges are split in
+	their midpoint, and the blocks are extracted again. After each step
+	the links of the half-edges are checked.
+*/
+
+#include "half_edge_graph.hpp"
+#include "bulk_builder.hpp"
+#include "base_properties.hpp"
+#include "linear_geometry.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <cmath>
+
+using namespace BGLgeom;
+
+//! Checks the links between the half-edges, and Euler formula for the number of faces
+bool
+check(half_edge_graph const& H, std::size_t const& n_components){
+	bool ok = true;
+	for(std::size_t h = 0; h < H.num_half_edges(); ++h){
+		ok = ok && H.prev(H.next(h)) == h && H.next(H.prev(h)) == h;
+		ok = ok && H.origin(H.next(h)) == H.target(h);
+		ok = ok && H.face(H.next(h)) == H.face(h);
+	}
+	// Each component with V vertices and E edges has E - V + 2 faces
+	ok = ok && H.num_faces() == H.num_edges() - H.num_vertices() + 2*n_components;
+	return ok;
+}
+
+//! Prints the blocks
+void
+print_blocks(std::vector<polygonal_block> const& B){
+	for(polygonal_block const& b : B){
+		std::cout << "\tBlock of area " << b.area << ":";
+		for(point<2> const& P : b.boundary)
+			std::cout << " (" << P(0) << "," << P(1) << ")";
+		std::cout << std::endl;
+		for(auto const& hole : b.holes){
+			std::cout << "\t\thole:";
+			for(point<2> const& P : hole)
+				std::cout << " (" << P(0) << "," << P(1) << ")";
+			std::cout << std::endl;
+		}
+	}
+}
+
+int main(){
+
+	using Vertex_prop = Vertex_base_property<2>;
+	using Edge_prop = Edge_base_property<linear_geometry<2>,2>;
+	using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop, Edge_prop>;
+
+	std::cout << "============ HALF-EDGE GRAPH ============" << std::endl << std::endl;
+	bool ok = true;
+
+	// The small network
+	std::vector<point<2>> pts = {point<2>(0,0), point<2>(4,0), point<2>(4,4), point<2>(0,4), point<2>(3,1),
+								 point<2>(0.5,2.5), point<2>(1.5,2.5), point<2>(1.5,3.5), point<2>(0.5,3.5)};
+	edge_list_t E = {{0,1}, {1,2}, {2,3}, {3,0}, {0,2}, {1,4}, {5,6}, {6,7}, {7,8}, {8,5}};
+	Graph G;
+	bulk_build_linear<Graph,2>(pts, E, G);
+	half_edge_graph H = make_half_edge_graph(G);
+	std::vector<polygonal_block> B = H.blocks();
+	std::cout << "Small network: " << H.num_vertices() << " vertices, " << H.num_edges() << " edges, "
+			  << H.num_faces() << " faces, " << B.size() << " blocks" << std::endl;
+	print_blocks(B);
+	ok = ok && check(H, 2) && B.size() == 3 && B[0].holes.size() + B[1].holes.size() + B[2].holes.size() == 1;
+	double area = 0;
+	for(polygonal_block const& b : B)
+		area += b.area;
+	ok = ok && std::abs(area - 16) < 1e-12;
+
+	// Splitting the diagonal, the dangling edge and a side of the inner square
+	H.split_edge(4, point<2>(2,2));
+	H.split_edge(5, point<2>(3.5,0.5));
+	H.split_edge(6, point<2>(1,2.5));
+	B = H.blocks();
+	std::cout << "After three splits: " << H.num_vertices() << " vertices, " << H.num_edges() << " edges, "
+			  << H.num_faces() << " faces, " << B.size() << " blocks" << std::endl;
+	print_blocks(B);
+	ok = ok && check(H, 2) && B.size() == 3;
+	double area_split = 0;
+	for(polygonal_block const& b : B)
+		area_split += b.area;
+	ok = ok && std::abs(area_split - 16) < 1e-12;
+
+	// Grid network with N x N vertices
+	const std::size_t N = 300;
+	const double h = 1.0/(N-1);
+	pts.clear();
+	E.clear();
+	for(std::size_t i = 0; i < N; ++i)
+		for(std::size_t j = 0; j < N; ++j){
+			pts.push_back(point<2>(i*h, j*h));
+			if(i > 0)
+				E.push_back(std::make_pair((i-1)*N+j, i*N+j));
+			if(j > 0)
+				E.push_back(std::make_pair(i*N+j-1, i*N+j));
+		}
+	Graph G_grid;
+	bulk_build_linear<Graph,2>(pts, E, G_grid);
+	auto t0 = std::chrono::steady_clock::now();
+	H = make_half_edge_graph(G_grid);
+	auto t1 = std::chrono::steady_clock::now();
+	B = H.blocks();
+	auto t2 = std::chrono::steady_clock::now();
+	std::cout << std::endl << "Grid of " << N << " x " << N << " vertices: " << H.num_edges() << " edges, "
+			  << B.size() << " blocks" << std::endl;
+	std::cout << "\tbuilt in " << std::chrono::duration<double>(t1-t0).count() << " s, blocks extracted in "
+			  << std::chrono::duration<double>(t2-t1).count() << " s" << std::endl;
+	ok = ok && check(H, 1) && B.size() == (N-1)*(N-1);
+
+	// Each edge split in its midpoint
+	const std::size_t n_edges = H.num_edges();
+	t0 = std::chrono::steady_clock::now();
+	for(std::size_t e = 0; e < n_edges; ++e)
+		H.split_edge(e, 0.5*(H.coordinates(H.origin(2*e)) + H.coordinates(H.target(2*e))));
+	t1 = std::chrono::steady_clock::now();
+	B = H.blocks();
+	std::size_t n_wrong = 0;
+	for(polygonal_block const& b : B)
+		n_wrong += (b.boundary.size() != 8 || std::abs(b.area - h*h) > 1e-15);
+	std::cout << "\t" << n_edges << " edges split in " << std::chrono::duration<double>(t1-t0).count() << " s: "
+			  << H.num_edges() << " edges, " << B.size() << " blocks, " << n_wrong << " wrong" << std::endl;
+	ok = ok && check(H, 1) && B.size() == (N-1)*(N-1) && n_wrong == 0;
+
+	std::cout << std::endl << (ok ? "Test passed" : "ERROR: test failed") << std::endl;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_linear_view_geometry.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing class linear_view_geometry
+	
+	We build a small graph (a triangle) whose edges reference the 
+	coordinates of the vertices, instead of copying them. Then we move a 
+	vertex and show that all the incident edges follow it, and we check 
+	that the edges of a copy of the graph read the coordinates of the copy. 
+	Finally we 
+	compare the size of the edge geometry with the one of linear_geometry.
+*/
+
+#include "linear_view_geometry.hpp"
+#include "linear_geometry.hpp"
+#include "point.hpp"
+#include "base_properties.hpp"
+#include "graph_builder.hpp"
+#include "graph_access.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <iostream>
+
+using namespace BGLgeom;
+
+int main(){
+
+	using Graph = boost::adjacency_list< boost::vecS, 
+										 boost::vecS, 
+										 boost::undirectedS, 
+										 Vertex_base_property<3>, 
+										 Edge_base_property<linear_view_geometry<3>,3> >;
+	Graph G;
+	graph_coordinate_map<Graph,3> M(G);
+	
+	Vertex_desc<Graph> a = new_vertex(Vertex_base_property<3>(point<3>(0,0,0)), G);
+	Vertex_desc<Graph> b = new_vertex(Vertex_base_property<3>(point<3>(1,0,0)), G);
+	Vertex_desc<Graph> c = new_vertex(Vertex_base_property<3>(point<3>(0,1,0)), G);
+	new_linear_view_edge(a, b, M, G);
+	new_linear_view_edge(b, c, M, G);
+	new_linear_view_edge(c, a, M, G);
+	
+	std::cout << "===================== LINEAR_VIEW_GEOMETRY ==================" << std::endl << std::endl;
+	Edge_iter<Graph> e_it, e_end;
+	for(std::tie(e_it, e_end) = edges(G); e_it != e_end; ++e_it)
+		std::cout << G[*e_it].geometry << "\tlength: " << G[*e_it].geometry.length()
+				  << "\tmidpoint: " << G[*e_it].geometry(0.5) << std::endl;
+	
+	std::cout << std::endl << "Moving vertex " << c << " to (0,0,1)" << std::endl << std::endl;
+	G[c].coordinates = point<3>(0,0,1);
+	for(std::tie(e_it, e_end) = edges(G); e_it != e_end; ++e_it)
+		std::cout << G[*e_it].geometry << "\tlength: " << G[*e_it].geometry.length()
+				  << "\tmidpoint: " << G[*e_it].geometry(0.5) << std::endl;
+	
+	std::cout << std::endl << "Mesh on the first edge:" << std::endl;
+	std::tie(e_it, e_end) = edges(G);
+	G[*e_it].make_uniform_mesh(4);
+	for(std::size_t i = 0; i < G[*e_it].mesh.real.size(); ++i)
+		std::cout << "\t" << G[*e_it].mesh.parametric[i] << "\t: " << G[*e_it].mesh.real[i] << std::endl;
+	
+	linear_geometry<3> copy = G[*e_it].geometry;
+	std::cout << std::endl << "Converted to linear_geometry: " << copy << std::endl;
+	
+	// A copy of the graph does not read the coordinates of the original one
+	Graph G_copy(G);
+	std::tie(e_it, e_end) = edges(G_copy);
+	std::cout << std::endl << "Edge of a copy of the graph: " << G_copy[*e_it].geometry << std::endl;
+	graph_coordinate_map<Graph,3> M_copy(G_copy);
+	set_coordinate_map(G_copy, M_copy);
+	G[c].coordinates = point<3>(0,0,2);
+	std::cout << "Moving vertex " << c << " of the original graph to (0,0,2)" << std::endl;
+	bool independent = true;
+	Edge_iter<Graph> f_it, f_end;
+	for(std::tie(f_it, f_end) = edges(G_copy); f_it != f_end; ++f_it){
+		std::cout << G_copy[*f_it].geometry << std::endl;
+		independent = independent && G_copy[*f_it].geometry.get_source() == G_copy[source(*f_it, G_copy)].coordinates
+								  && G_copy[*f_it].geometry.get_target() == G_copy[target(*f_it, G_copy)].coordinates;
+	}
+	std::cout << "Edges of the copy read the vertices of the copy: " << (independent ? "yes" : "NO") << std::endl;
+	
+	std::cout << std::endl << "Size of the geometry of an edge (bytes):" << std::endl;
+	std::cout << "\tlinear_geometry<3>:      " << sizeof(linear_geometry<3>) << std::endl;
+	std::cout << "\tlinear_view_geometry<3>: " << sizeof(linear_view_geometry<3>) << std::endl;
+	
+	return 0;
+}
@@ -0,0 +1,143 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_mesh_arena.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the storage of the meshes in a file mapped in memory
+	
+	The same network is built twice, with the meshes kept in memory and 
+	with the meshes stored in a mesh_arena with a memory budget much 
+	smaller than the size of the meshes. We check that the meshes are the 
+	same, that the memory mapped never exceeds the budget, and that the 
+	pts writer produces the same file for the two graphs. Then we check 
+	that the segment being read is not unmapped by a prefetch() of 
+	another one.
+*/
+
+#include "mesh_arena.hpp"
+#include "bulk_builder.hpp"
+#include "graph_access.hpp"
+#include "base_properties.hpp"
+#include "linear_geometry.hpp"
+#include "writer_pts.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <unistd.h>
+
+using namespace BGLgeom;
+
+//! Content of a file
+std::string
+read_file(std::string const& filename){
+	std::ifstream in(filename);
+	std::stringstream ss;
+	ss << in.rdbuf();
+	return ss.str();
+}
+
+int main(){
+	
+	using Vertex_prop = Vertex_base_property<3>;
+	using Edge_prop = Edge_base_property<linear_geometry<3>,3>;
+	using Edge_prop_arena = Edge_base_property<linear_geometry<3>,3,arena_mesh<3>>;
+	using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop, Edge_prop>;
+	using Graph_arena = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop, Edge_prop_arena>;
+	
+	// A chain of edges, on a helix
+	const std::size_t n_edges = 400;
+	const unsigned int n_intervals = 1000;
+	std::vector<point<3>> pts;
+	edge_list_t E;
+	for(std::size_t i = 0; i <= n_edges; ++i){
+		pts.push_back(point<3>(std::cos(0.1*i), std::sin(0.1*i), 0.01*i));
+		if(i > 0)
+			E.push_back(std::make_pair(i-1, i));
+	}
+	
+	Graph G;
+	bulk_build_linear<Graph,3>(pts, E, G);
+	for(auto e : boost::make_iterator_range(edges(G)))
+		G[e].make_uniform_mesh(n_intervals);
+	
+	// Chunks of 256 kB, at most 1 MB mapped
+	mesh_arena<3> arena("../data/out_test_mesh_arena.arena", 1 << 20, 1 << 18);
+	arena.make_current();
+	Graph_arena G_arena;
+	bulk_build_linear<Graph_arena,3>(pts, E, G_arena);
+	std::size_t max_mapped = 0;
+	for(auto e : boost::make_iterator_range(edges(G_arena))){
+		G_arena[e].make_uniform_mesh(n_intervals);
+		max_mapped = std::max(max_mapped, arena.mapped_bytes());
+	}
+	
+	std::cout << "================== MESH ARENA ======================" << std::endl << std::endl;
+	std::cout << "Size of the meshes on file: " << arena.size() << " bytes, memory budget: " << arena.get_budget() << " bytes" << std::endl;
+	
+	// Same meshes
+	bool same = true;
+	auto e_arena = edges(G_arena).first;
+	for(auto e : boost::make_iterator_range(edges(G))){
+		auto const& M = G[e].mesh;
+		auto const& M_arena = G_arena[*e_arena].mesh;
+		same = same && M.real.size() == M_arena.real.size() && M.parametric.size() == M_arena.parametric.size();
+		for(std::size_t i = 0; same && i < M.real.size(); ++i)
+			same = (M.real[i] == M_arena.real[i]) && (M.parametric[i] == M_arena.parametric[i]);
+		max_mapped = std::max(max_mapped, arena.mapped_bytes());
+		++e_arena;
+	}
+	std::cout << "Same meshes: " << (same ? "yes" : "NO") << std::endl;
+	std::cout << "Copy in memory of the first mesh: " << G_arena[*edges(G_arena).first].mesh.to_mesh().real.size() << " points" << std::endl;
+	
+	writer_pts<Graph,3> W("../data/out_test_mesh_arena_memory.pts");
+	W.export_pts(G);
+	writer_pts<Graph_arena,3> W_arena("../data/out_test_mesh_arena_file.pts");
+	W_arena.export_pts(G_arena);
+	max_mapped = std::max(max_mapped, arena.mapped_bytes());
+	std::cout << "Same pts files: " << (read_file("../data/out_test_mesh_arena_memory.pts") == read_file("../data/out_test_mesh_arena_file.pts") ? "yes" : "NO") << std::endl;
+	std::cout << "Maximum memory mapped: " << max_mapped << " bytes, " << arena.num_mappings() << " mappings" << std::endl;
+	
+	// Three blocks in three chunks, with room for two chunks only: the 
+	// block read last has to survive the prefetch of the third one
+	const std::size_t page = sysconf(_SC_PAGESIZE);
+	arena_file F("../data/out_test_mesh_arena_lru.arena", 2*page, page);
+	std::vector<char> block(page, 'a');
+	std::size_t A = F.append(block.data(), page);
+	std::size_t B = F.append(block.data(), page);
+	std::size_t C = F.append(block.data(), page);
+	F.access(A, page);
+	F.prefetch(B, page);
+	F.access(A, page);
+	F.prefetch(C, page);
+	const std::size_t n_before = F.num_mappings();
+	F.access(A, page);
+	std::cout << "Segment in use kept mapped across a prefetch: " << (F.num_mappings() == n_before ? "yes" : "NO") << std::endl;
+	
+	return 0;
+}
@@ -0,0 +1,190 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_padded_batch_evaluation.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Benchmark of the padded batch evaluation of the geometries
+	
+	A 3D line and a 3D cubic bspline are evaluated in the same vector of 
+	parameters with operator() (std::vector of point<3>) and with 
+	evaluate() (aligned_vector of padded_point<3>); the bspline also with 
+	its control points stored as padded_point<3>. We check that the points
+	are the same and report the throughput of each evaluation. Then the 
+	same network is meshed with mesh<3> and with padded_mesh<3>, comparing 
+	the meshes, the time to build them and the pts files, and two edges 
+	with padded extremes are intersected.
+	
+	The timings are meaningful only when the test is compiled with 
+	RELEASE=yes.
+*/
+
+#include "linear_geometry.hpp"
+#include "bspline_geometry.hpp"
+#include "intersections2D.hpp"
+#include "mesh.hpp"
+#include "base_properties.hpp"
+#include "bulk_builder.hpp"
+#include "writer_pts.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+using namespace BGLgeom;
+
+using clock_t_ = std::chrono::high_resolution_clock;
+
+//! Best time (in seconds) of some runs of a function
+template <typename F>
+double
+best_time(F const& f, unsigned int const& runs = 5){
+	double best = 1e30;
+	for(unsigned int r = 0; r < runs; ++r){
+		auto t0 = clock_t_::now();
+		f();
+		best = std::min(best, std::chrono::duration<double>(clock_t_::now() - t0).count());
+	}
+	return best;
+}
+
+//! Evaluates a geometry in a std::vector of point<3> and in an aligned_vector of padded_point<3>, and reports
+template <typename Geom>
+void
+compare(Geom const& geom, std::vector<double> const& t, std::string const& name){
+	std::vector<point<3>> P;
+	aligned_vector<padded_point<3>> Q;
+	double time = best_time([&](){ P = geom(t); });
+	double time_padded = best_time([&](){ geom.evaluate(t, Q); });
+	double err = 0;
+	for(std::size_t i = 0; i < t.size(); ++i)
+		err = std::max(err, (P[i] - unpad<3>(Q[i])).norm());
+	std::cout << name << ":" << std::endl;
+	std::cout << "\tpoint<3>:        " << t.size()/time/1e6 << " Mpoints/s" << std::endl;
+	std::cout << "\tpadded_point<3>: " << t.size()/time_padded/1e6 << " Mpoints/s" << std::endl;
+	std::cout << "\tMaximum difference: " << err << std::endl;
+}
+
+//! Reads a whole file
+std::string
+read_file(std::string const& name){
+	std::ifstream in(name);
+	std::stringstream ss;
+	ss << in.rdbuf();
+	return ss.str();
+}
+
+int main(){
+	
+	using padded_bspline = bspline_geometry<3, 3, double, padded_point<3>, Eigen::aligned_allocator<padded_point<3>>>;
+	using Vertex_prop = Vertex_base_property<3>;
+	using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop, Edge_base_property<linear_geometry<3>,3>>;
+	using Graph_padded = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop, Edge_base_property<linear_geometry<3>,3,padded_mesh<3>>>;
+	
+	std::cout << "============== PADDED BATCH EVALUATION ================" << std::endl << std::endl;
+#ifdef NDEBUG
+	std::cout << "Build: release" << std::endl;
+#else
+	std::cout << "WARNING! Debug build: the timings are not meaningful, compile with RELEASE=yes" << std::endl;
+#endif
+	std::cout << std::endl;
+	std::cout << "sizeof(point<3>) = " << sizeof(point<3>) << ", alignof = " << alignof(point<3>) << std::endl;
+	std::cout << "sizeof(padded_point<3>) = " << sizeof(padded_point<3>) << ", alignof = " << alignof(padded_point<3>) << std::endl << std::endl;
+	
+	const std::size_t n = 2000000;
+	std::vector<double> t(n);
+	for(std::size_t i = 0; i < n; ++i)
+		t[i] = static_cast<double>(i)/(n-1);
+	
+	linear_geometry<3> line(point<3>(0,0,0), point<3>(1,2,3));
+	compare(line, t, "Linear geometry");
+	
+	// A helix as control polygon of a cubic bspline
+	std::vector<point<3>> C;
+	for(std::size_t i = 0; i < 40; ++i)
+		C.push_back(point<3>(std::cos(0.5*i), std::sin(0.5*i), 0.1*i));
+	bspline_geometry<3,3> spline(C, BSP_type::Approx);
+	compare(spline, t, "Cubic bspline geometry");
+	padded_bspline spline_padded(C, BSP_type::Approx);
+	compare(spline_padded, t, "Cubic bspline geometry, padded control points");
+	
+	// The same network meshed with mesh<3> and with padded_mesh<3>
+	const std::size_t n_side = 60;
+	const unsigned int n_intervals = 200;
+	std::vector<point<3>> pts;
+	edge_list_t E;
+	for(std::size_t i = 0; i < n_side; ++i)
+		for(std::size_t j = 0; j < n_side; ++j){
+			pts.push_back(point<3>(i, j, 0.01*i*j));
+			if(i > 0)
+				E.push_back(std::make_pair((i-1)*n_side + j, i*n_side + j));
+			if(j > 0)
+				E.push_back(std::make_pair(i*n_side + j-1, i*n_side + j));
+		}
+	Graph G;
+	bulk_build_linear<Graph,3>(pts, E, G);
+	Graph_padded G_padded;
+	bulk_build_linear<Graph_padded,3>(pts, E, G_padded);
+	double time = best_time([&](){
+		for(auto e : boost::make_iterator_range(edges(G)))
+			G[e].make_uniform_mesh(n_intervals);
+	});
+	double time_padded = best_time([&](){
+		for(auto e : boost::make_iterator_range(edges(G_padded)))
+			G_padded[e].make_uniform_mesh(n_intervals);
+	});
+	double err = 0;
+	auto e_padded = edges(G_padded).first;
+	for(auto e : boost::make_iterator_range(edges(G))){
+		auto const& M = G[e].mesh.real;
+		auto const& M_padded = G_padded[*e_padded].mesh.real;
+		for(std::size_t i = 0; i < M.size(); ++i)
+			err = std::max(err, (M[i] - unpad<3>(M_padded[i])).norm());
+		++e_padded;
+	}
+	std::cout << std::endl << "Meshes of " << num_edges(G) << " edges with " << n_intervals << " intervals:" << std::endl;
+	std::cout << "\tmesh<3>:        " << time << " s" << std::endl;
+	std::cout << "\tpadded_mesh<3>: " << time_padded << " s" << std::endl;
+	std::cout << "\tMaximum difference: " << err << std::endl;
+	
+	writer_pts<Graph,3> W("../data/out_test_padded_batch_evaluation.pts");
+	W.export_pts(G);
+	writer_pts<Graph_padded,3> W_padded("../data/out_test_padded_batch_evaluation_padded.pts");
+	W_padded.export_pts(G_padded);
+	std::cout << "Same pts files: " << (read_file("../data/out_test_padded_batch_evaluation.pts") == 
+										read_file("../data/out_test_padded_batch_evaluation_padded.pts") ? "yes" : "no") << std::endl;
+	
+	// Intersection of two edges whose extremes are padded points (in 3D, the first two coordinates are used)
+	padded_point<3> A1 = pad<3>(point<3>(0,0,1)), B1 = pad<3>(point<3>(1,1,1)), A2 = pad<3>(point<3>(0,1,1)), B2 = pad<3>(point<3>(1,0.2,1));
+	Intersection I = compute_intersection(linear_geometry<2>(point<2>(0,0), point<2>(1,1)), linear_geometry<2>(point<2>(0,1), point<2>(1,0.2)));
+	Intersection I_padded = compute_intersection(A1, B1, A2, B2);
+	std::cout << std::endl << "Intersection point: " << I.intersectionPoint[0] << ", from padded extremes " << I_padded.intersectionPoint[0] << std::endl;
+	
+	return 0;
+}
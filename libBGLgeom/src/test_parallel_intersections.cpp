@@ -0,0 +1,133 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_parallel_intersections.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the intersections of a set of segments computed by more
+			threads
+
+	On a set of segments joining points of a coarse lattice (with many
+	overlaps and intersections in the extremes) and on a set of random
+	segments, the result with 1 to 64 threads is compared with the one of
+	the sweep line. The number of random segments can be given as
+	argument (default 20000).
+*/
+
+#include "parallel_intersections.hpp"
+#include "sweep_intersections.hpp"
+#include "linear_geometry.hpp"
+#include "point.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <cmath>
+
+using namespace BGLgeom;
+
+//! True if the two lists contain the same pairs with the same intersection points
+bool
+same_result(std::vector<segment_intersection> const& A, std::vector<segment_intersection> const& B){
+	if(A.size() != B.size())
+		return false;
+	for(std::size_t i = 0; i < A.size(); ++i){
+		if(A[i].first != B[i].first || A[i].second != B[i].second || A[i].I.how != B[i].I.how)
+			return false;
+		for(unsigned int k = 0; k < A[i].I.numberOfIntersections; ++k)
+			if((A[i].I.intersectionPoint[k] - B[i].I.intersectionPoint[k]).norm() != 0)
+				return false;
+	}
+	return true;
+}
+
+//! Compares the result with 1 to 64 threads with the sweep line, printing the times
+bool
+compare(std::string const& name, std::vector<linear_geometry<2>> const& S){
+	// compute_intersection writes some messages, which are discarded here
+	std::stringstream discard;
+	std::streambuf* cout_buf = std::cout.rdbuf(discard.rdbuf());
+	std::streambuf* cerr_buf = std::cerr.rdbuf(discard.rdbuf());
+	auto t0 = std::chrono::steady_clock::now();
+	std::vector<segment_intersection> sweep = compute_all_intersections(S);
+	auto t1 = std::chrono::steady_clock::now();
+	std::cout.rdbuf(cout_buf);
+	std::cerr.rdbuf(cerr_buf);
+	std::cout << name << ": " << S.size() << " segments, " << sweep.size() << " intersections" << std::endl;
+	std::cout << "\tsweep line: " << std::chrono::duration<double>(t1-t0).count() << " s" << std::endl;
+
+	bool ok = true;
+	for(unsigned int n_threads = 1; n_threads <= 64; n_threads *= 2){
+		// The threads write on the streams at the same time: they are detached from any buffer
+		cout_buf = std::cout.rdbuf(nullptr);
+		cerr_buf = std::cerr.rdbuf(nullptr);
+		t0 = std::chrono::steady_clock::now();
+		std::vector<segment_intersection> par = compute_all_intersections_parallel(S, n_threads);
+		t1 = std::chrono::steady_clock::now();
+		std::cout.rdbuf(cout_buf);
+		std::cerr.rdbuf(cerr_buf);
+		const bool same = same_result(sweep, par);
+		const double time = std::chrono::duration<double>(t1-t0).count();
+		std::cout << "\t" << n_threads << " threads: " << time << " s (" << S.size()/time << " segments/s) "
+				  << (same ? "Same intersections" : "ERROR: different intersections") << std::endl;
+		ok = ok && same;
+	}
+	return ok;
+}
+
+int main(int argc, char* argv[]){
+
+	std::cout << "=========== ALL THE INTERSECTIONS OF A SET OF SEGMENTS, WITH MORE THREADS ============" << std::endl << std::endl;
+	std::cout << "Concurrent threads supported: " << std::thread::hardware_concurrency() << std::endl << std::endl;
+	bool ok = true;
+
+	// Segments on a lattice
+	std::mt19937 gen(3);
+	std::uniform_int_distribution<int> lattice(0, 16);
+	std::vector<linear_geometry<2>> S;
+	while(S.size() < 1000){
+		point<2> P(lattice(gen), lattice(gen)), Q(lattice(gen), lattice(gen));
+		if(P(0) == Q(0) || P(1) == Q(1) || std::abs(P(0)-Q(0)) == std::abs(P(1)-Q(1)))
+			S.push_back(linear_geometry<2>(0.0625*P, 0.0625*Q));
+	}
+	ok = compare("Lattice", S) && ok;
+	std::cout << std::endl;
+
+	// Random segments, with about 10 intersections for each segment
+	const std::size_t n = (argc > 1 ? std::stoul(argv[1]) : 20000);
+	std::uniform_real_distribution<double> pos(0.0, 1.0), angle(0.0, 4*std::atan(1.0));
+	const double L = 4/std::sqrt(static_cast<double>(n));
+	S.clear();
+	for(std::size_t i = 0; i < n; ++i){
+		point<2> P(pos(gen), pos(gen));
+		const double a = angle(gen);
+		S.push_back(linear_geometry<2>(P, P + L*point<2>(std::cos(a), std::sin(a))));
+	}
+	ok = compare("Random", S) && ok;
+
+	return ok ? 0 : 1;
+}
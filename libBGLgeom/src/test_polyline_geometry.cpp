@@ -0,0 +1,105 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_polyline_geometry.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing class polyline_geometry and creation of mesh on an edge
+			with this geometry
+	
+	We perfom these different tests: \n
+	- Creation of a simple 2-dimensional polyline (a "L"). Evaluation of
+		the geometric characteristics for different values of the 
+		parameter, using both methods that accept one single parameter 
+		and methods accepting vectors of paramters; \n
+	- Creation of a polyline through many points of a circle, to check
+		length and discrete curvature against the exact ones; \n
+	- Creation of a graph with a polyline edge and of a uniform mesh on it.
+*/
+
+#include "polyline_geometry.hpp"
+#include "point.hpp"
+#include "base_properties.hpp"
+#include "graph_builder.hpp"
+#include "graph_access.hpp"
+#include "mesh.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <vector>
+#include <iostream>
+#include <cmath>
+
+using namespace BGLgeom;
+
+int main(){
+
+	const double pi = std::atan(1.0)*4.0;
+
+	std::cout << "===================== POLYLINE_GEOMETRY =====================" << std::endl << std::endl;
+	std::vector<point<2>> L_pts{point<2>(0,0), point<2>(1,0), point<2>(1,0), point<2>(1,3)};
+	polyline_geometry<2> L(L_pts);
+	std::cout << L << std::endl;
+	std::cout << "(the repeated point has been discarded)" << std::endl;
+	std::cout << "Length: " << L.length() << std::endl << std::endl;
+	
+	std::vector<double> t{0, 0.125, 0.25, 0.5, 1};
+	std::vector<point<2>> Eval = L(t);
+	std::vector<point<2>> F = L.first_der(t);
+	std::vector<double> A = L.curv_abs(t);
+	std::vector<double> K = L.curvature(t);
+	std::cout << "t\tpoint\t\tfirst der\tcurv abs\tcurvature" << std::endl;
+	for(std::size_t i = 0; i < t.size(); ++i)
+		std::cout << t[i] << "\t" << Eval[i] << "\t" << F[i] << "\t" << A[i] << "\t\t" << K[i] << std::endl;
+	std::cout << "Single evaluation at t=0.5: " << L(0.5) << std::endl << std::endl;
+	
+	std::cout << "=========================== CIRCLE ==========================" << std::endl;
+	const std::size_t n_pts = 100001;
+	const double R = 2.0;
+	std::vector<point<2>> C_pts(n_pts);
+	for(std::size_t i = 0; i < n_pts; ++i){
+		double theta = 2*pi*i/(n_pts-1);
+		C_pts[i] = point<2>(R*std::cos(theta), R*std::sin(theta));
+	}
+	polyline_geometry<2> Circ(C_pts);
+	std::cout << "Polyline with " << Circ.get_num_points() << " points on a circle of radius " << R << std::endl;
+	std::cout << "Length: " << Circ.length() << " (exact: " << 2*pi*R << ")" << std::endl;
+	std::cout << "Curvature at t=0.3: " << Circ.curvature(0.3) << " (exact: " << 1/R << ")" << std::endl;
+	std::cout << "Point at t=0.25: " << Circ(0.25) << " (exact: " << point<2>(0,R) << ")" << std::endl << std::endl;
+	
+	std::cout << "========================== ON GRAPH =========================" << std::endl;
+	using Graph = boost::adjacency_list< boost::vecS, 
+										 boost::vecS, 
+										 boost::undirectedS, 
+										 Vertex_base_property<2>, 
+										 Edge_base_property<polyline_geometry<2>,2> >;
+	Graph G;
+	Vertex_desc<Graph> a = new_vertex(Vertex_base_property<2>(L_pts.front()), G);
+	Vertex_desc<Graph> b = new_vertex(Vertex_base_property<2>(L_pts.back()), G);
+	Edge_desc<Graph> e = new_polyline_edge<Graph,2>(a, b, L_pts, G);
+	G[e].make_uniform_mesh(8);
+	std::cout << "Uniform mesh on the edge:" << std::endl;
+	for(std::size_t i = 0; i < G[e].mesh.real.size(); ++i)
+		std::cout << "\t" << G[e].mesh.parametric[i] << "\t: " << G[e].mesh.real[i] << std::endl;
+	
+	return 0;
+}
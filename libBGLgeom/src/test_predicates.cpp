@@ -0,0 +1,145 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_predicates.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the exact orientation test and the exact intersections
+
+	The orientation of points almost collinear, on a grid of spacing 2^-53
+	around the line y = x, is compared with the one computed with integers:
+	orient2d must always be right, while the plain floating point formula
+	is often wrong. Then compute_intersection_exact is compared with
+	compute_intersection on segments joining the points of a lattice (whose
+	coordinates are exact, so the two must agree), and their times are
+	printed.
+*/
+
+#include "predicates.hpp"
+#include "intersections2D.hpp"
+#include "linear_geometry.hpp"
+#include "point.hpp"
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <cmath>
+
+using namespace BGLgeom;
+
+//! Sign of a value
+template <typename T>
+int sign(T const& x){ return (x > 0) - (x < 0); }
+
+int main(){
+
+	std::cout << "=========== EXACT ORIENTATION AND INTERSECTIONS ============" << std::endl << std::endl;
+	bool ok = true;
+
+	// Points (0.5 + i*u, 0.5 + j*u), with u = 2^-53, against the line through
+	// (12,12) and (24,24). In units of u/2 all the coordinates are integers
+	// below 2^59, so the determinant is computed exactly with 128 bits
+	const double u = std::ldexp(1.0, -53);
+	const point<2> b(12, 12), c(24, 24);
+	const long long bi = 12LL << 54, ci = 24LL << 54;
+	unsigned int n_points = 0, n_wrong_naive = 0, n_wrong = 0;
+	for(int i = 0; i < 256; ++i)
+		for(int j = 0; j < 256; ++j){
+			const point<2> a(0.5 + i*u, 0.5 + j*u);
+			const long long ax = (1LL << 53) + 2*i, ay = (1LL << 53) + 2*j;
+			const __int128 det = static_cast<__int128>(ax - ci)*(bi - ci) - static_cast<__int128>(ay - ci)*(bi - ci);
+			const double naive = (a(0) - c(0))*(b(1) - c(1)) - (a(1) - c(1))*(b(0) - c(0));
+			++n_points;
+			n_wrong_naive += (sign(naive) != sign(det));
+			n_wrong += (sign(orient2d(a, b, c)) != sign(det));
+		}
+	std::cout << "Almost collinear points: " << n_points << ", wrong orientation: " << n_wrong_naive
+			  << " in floating point, " << n_wrong << " with orient2d" << std::endl;
+	ok = ok && n_wrong == 0;
+
+	// Segments on a lattice: all the situations, with exact coordinates
+	std::mt19937 gen(13);
+	std::uniform_int_distribution<int> lattice(0, 6);
+	std::vector<linear_geometry<2>> S;
+	while(S.size() < 600){
+		point<2> P(lattice(gen), lattice(gen)), Q(lattice(gen), lattice(gen));
+		if(P != Q)
+			S.push_back(linear_geometry<2>(P, Q));
+	}
+	// compute_intersection writes some messages, which are discarded here
+	std::stringstream discard;
+	std::streambuf* cout_buf = std::cout.rdbuf(discard.rdbuf());
+	std::streambuf* cerr_buf = std::cerr.rdbuf(discard.rdbuf());
+	std::size_t n_pairs = 0, n_different = 0;
+	std::vector<std::size_t> n_type(12, 0);
+	for(std::size_t i = 0; i < S.size(); ++i)
+		for(std::size_t j = 0; j < S.size(); ++j){
+			if(i == j)
+				continue;
+			const Intersection I = compute_intersection(S[i], S[j]);
+			const Intersection E = compute_intersection_exact(S[i], S[j]);
+			bool same = (I.intersect == E.intersect && I.how == E.how && I.numberOfIntersections == E.numberOfIntersections);
+			for(unsigned int k = 0; same && k < E.numberOfIntersections; ++k)
+				same = (I.intersectionPoint[k] - E.intersectionPoint[k]).norm() < 1e-12;
+			++n_pairs;
+			n_different += !same;
+			++n_type[static_cast<int>(E.how)];
+		}
+	std::cout.rdbuf(cout_buf);
+	std::cerr.rdbuf(cerr_buf);
+	std::cout << "Segments on a lattice: " << n_pairs << " pairs, " << n_different << " classified differently" << std::endl;
+	const char* names[] = {"X", "T_new", "T_old", "Overlap_outside", "Overlap_inside", "Overlap", "Overlap_extreme_inside",
+						   "Overlap_extreme_outside", "Identical", "Common_extreme", "Something_went_wrong", "No_intersection"};
+	for(std::size_t k = 0; k < n_type.size(); ++k)
+		std::cout << "\t" << names[k] << ": " << n_type[k] << std::endl;
+	ok = ok && n_different == 0 && n_type[static_cast<int>(intersection_type::Something_went_wrong)] == 0;
+
+	// Times on random segments
+	std::uniform_real_distribution<double> pos(0.0, 1.0);
+	S.clear();
+	for(std::size_t i = 0; i < 2000; ++i)
+		S.push_back(linear_geometry<2>(point<2>(pos(gen), pos(gen)), point<2>(pos(gen), pos(gen))));
+	cout_buf = std::cout.rdbuf(discard.rdbuf());
+	cerr_buf = std::cerr.rdbuf(discard.rdbuf());
+	std::size_t n_tol = 0, n_exact = 0;
+	auto t0 = std::chrono::steady_clock::now();
+	for(std::size_t i = 0; i < S.size(); ++i)
+		for(std::size_t j = i+1; j < S.size(); ++j)
+			n_tol += compute_intersection(S[i], S[j]).intersect;
+	auto t1 = std::chrono::steady_clock::now();
+	for(std::size_t i = 0; i < S.size(); ++i)
+		for(std::size_t j = i+1; j < S.size(); ++j)
+			n_exact += compute_intersection_exact(S[i], S[j]).intersect;
+	auto t2 = std::chrono::steady_clock::now();
+	std::cout.rdbuf(cout_buf);
+	std::cerr.rdbuf(cerr_buf);
+	std::cout << std::endl << "All the pairs of " << S.size() << " random segments:" << std::endl;
+	std::cout << "\tcompute_intersection: " << n_tol << " intersections, " << std::chrono::duration<double>(t1-t0).count() << " s" << std::endl;
+	std::cout << "\tcompute_intersection_exact: " << n_exact << " intersections, " << std::chrono::duration<double>(t2-t1).count() << " s" << std::endl;
+	ok = ok && n_tol == n_exact;
+
+	std::cout << std::endl << (ok ? "Test passed" : "ERROR: test failed") << std::endl;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_scalar_type.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing geometries and meshes in single precision
+	
+	The same network is built with linear geometries and meshes in double 
+	and in float. We report the memory used by the meshes, the maximum
+	distance between the points of the meshes and the tolerances used for
+	the two scalar types, and we write the pts file of the float graph.
+	Then the same curved edge is built with bspline, polyline and generic
+	geometries in double and in float, comparing their meshes, and two 
+	edges are intersected in double and in float
+*/
+
+#include "linear_geometry.hpp"
+#include "bspline_geometry.hpp"
+#include "polyline_geometry.hpp"
+#include "generic_geometry.hpp"
+#include "intersections2D.hpp"
+#include "mesh.hpp"
+#include "base_properties.hpp"
+#include "bulk_builder.hpp"
+#include "graph_builder.hpp"
+#include "writer_pts.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+using namespace BGLgeom;
+
+//! Graph with the given geometry and mesh on the edges
+template <typename Geom, typename Mesh>
+using Graph_t = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_base_property<3>, Edge_base_property<Geom,3,Mesh>>;
+
+//! Adds the two extremes of the edge to the graph
+template <typename Graph>
+void
+add_extremes(point<3> const& A, point<3> const& B, Graph & G){
+	G[boost::add_vertex(G)].coordinates = A;
+	G[boost::add_vertex(G)].coordinates = B;
+}
+
+//! Maximum distance between the uniform meshes of the first edge of G and of G_float
+template <typename Graph, typename Graph_float>
+double
+mesh_distance(Graph & G, Graph_float & G_float, unsigned int const& n){
+	auto e = *edges(G).first;
+	auto e_float = *edges(G_float).first;
+	G[e].make_uniform_mesh(n);
+	G_float[e_float].make_uniform_mesh(n);
+	double err = 0;
+	for(std::size_t i = 0; i < G[e].mesh.real.size(); ++i)
+		err = std::max(err, (G[e].mesh.real[i] - G_float[e_float].mesh.real[i].template cast<double>()).norm());
+	return err;
+}
+
+int main(){
+	
+	using Vertex_prop = Vertex_base_property<3>;
+	using Edge_prop = Edge_base_property<linear_geometry<3>,3>;
+	using Edge_prop_float = Edge_base_property<linear_geometry<3,float>,3,mesh<3,float>>;
+	using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop, Edge_prop>;
+	using Graph_float = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_prop, Edge_prop_float>;
+	
+	std::cout << "================== SCALAR TYPE ======================" << std::endl << std::endl;
+	std::cout << "Tolerance to compare points: double " << tolerance<double>::value() << ", float " << tolerance<float>::value() << std::endl;
+	std::cout << "Tolerance on the derivatives: double " << tolerance<double>::dist() << ", float " << tolerance<float>::dist() << std::endl;
+	point<3,float> A(1.f, 2.f, 3.f), B(1.f, 2.f, 3.f + 1e-6f);
+	std::cout << "Float points at distance 1e-6 are equal: " << (BGLgeom::operator==(A,B) ? "yes" : "no") << std::endl << std::endl;
+	
+	// A chain of edges on a helix
+	const std::size_t n_edges = 2000;
+	const unsigned int n_intervals = 500;
+	std::vector<point<3>> pts;
+	edge_list_t E;
+	for(std::size_t i = 0; i <= n_edges; ++i){
+		pts.push_back(point<3>(10*std::cos(0.01*i), 10*std::sin(0.01*i), 0.05*i));
+		if(i > 0)
+			E.push_back(std::make_pair(i-1, i));
+	}
+	Graph G;
+	bulk_build_linear<Graph,3>(pts, E, G);
+	Graph_float G_float;
+	bulk_build_linear<Graph_float,3>(pts, E, G_float);
+	
+	std::size_t bytes = 0, bytes_float = 0;
+	double err = 0;
+	auto e_float = edges(G_float).first;
+	for(auto e : boost::make_iterator_range(edges(G))){
+		G[e].make_uniform_mesh(n_intervals);
+		G_float[*e_float].make_uniform_mesh(n_intervals);
+		auto const& M = G[e].mesh;
+		auto const& M_float = G_float[*e_float].mesh;
+		bytes += M.real.size()*sizeof(point<3>) + M.parametric.size()*sizeof(double);
+		bytes_float += M_float.real.size()*sizeof(point<3,float>) + M_float.parametric.size()*sizeof(float);
+		for(std::size_t i = 0; i < M.real.size(); ++i)
+			err = std::max(err, (M.real[i] - M_float.real[i].cast<double>()).norm());
+		++e_float;
+	}
+	std::cout << "Memory of the meshes, double: " << bytes << " bytes" << std::endl;
+	std::cout << "Memory of the meshes, float:  " << bytes_float << " bytes" << std::endl;
+	std::cout << "Maximum distance between the points of the meshes: " << err << std::endl;
+	std::cout << "Length of the first edge: double " << G[*edges(G).first].geometry.length() << ", float " << G_float[*edges(G_float).first].geometry.length() << std::endl;
+	
+	writer_pts<Graph_float,3> W("../data/out_test_scalar_type.pts");
+	W.export_pts(G_float);
+	
+	// One turn of the helix, as a curved edge
+	std::function<point<3>(double)> helix = [](double t) -> point<3> { return point<3>(10*std::cos(6*t), 10*std::sin(6*t), 5*t); };
+	std::function<point<3>(double)> helix1 = [](double t) -> point<3> { return point<3>(-60*std::sin(6*t), 60*std::cos(6*t), 5); };
+	std::function<point<3>(double)> helix2 = [](double t) -> point<3> { return point<3>(-360*std::cos(6*t), -360*std::sin(6*t), 0); };
+	std::vector<point<3>> P;
+	for(unsigned int i = 0; i <= 200; ++i)
+		P.push_back(helix(i/200.));
+	
+	Graph_t<bspline_geometry<3>, mesh<3>> G_bsp;
+	Graph_t<bspline_geometry<3,3,float>, mesh<3,float>> G_bsp_float;
+	add_extremes(P.front(), P.back(), G_bsp);
+	add_extremes(P.front(), P.back(), G_bsp_float);
+	new_bspline_edge<decltype(G_bsp),3>(0, 1, P, BSP_type::Interp, G_bsp);
+	new_bspline_edge<decltype(G_bsp_float),3>(0, 1, P, BSP_type::Interp, G_bsp_float);
+	
+	Graph_t<polyline_geometry<3>, mesh<3>> G_poly;
+	Graph_t<polyline_geometry<3,float>, mesh<3,float>> G_poly_float;
+	add_extremes(P.front(), P.back(), G_poly);
+	add_extremes(P.front(), P.back(), G_poly_float);
+	new_polyline_edge<decltype(G_poly),3>(0, 1, P, G_poly);
+	new_polyline_edge<decltype(G_poly_float),3>(0, 1, P, G_poly_float);
+	
+	Graph_t<generic_geometry<3>, mesh<3>> G_gen;
+	Graph_t<generic_geometry<3,float>, mesh<3,float>> G_gen_float;
+	add_extremes(P.front(), P.back(), G_gen);
+	add_extremes(P.front(), P.back(), G_gen_float);
+	new_generic_edge<decltype(G_gen),3>(0, 1, helix, helix1, helix2, G_gen);
+	new_generic_edge<decltype(G_gen_float),3>(0, 1, helix, helix1, helix2, G_gen_float);
+	
+	std::cout << std::endl << "Maximum distance between the meshes of the curved edge in double and in float:" << std::endl;
+	std::cout << "\tbspline:  " << mesh_distance(G_bsp, G_bsp_float, n_intervals) << std::endl;
+	std::cout << "\tpolyline: " << mesh_distance(G_poly, G_poly_float, n_intervals) << std::endl;
+	std::cout << "\tgeneric:  " << mesh_distance(G_gen, G_gen_float, n_intervals) << std::endl;
+	std::cout << "Length of the curved edge (double, float):" << std::endl;
+	std::cout << "\tbspline:  " << G_bsp[*edges(G_bsp).first].geometry.length() << ", " << G_bsp_float[*edges(G_bsp_float).first].geometry.length() << std::endl;
+	std::cout << "\tpolyline: " << G_poly[*edges(G_poly).first].geometry.length() << ", " << G_poly_float[*edges(G_poly_float).first].geometry.length() << std::endl;
+	std::cout << "\tgeneric:  " << G_gen[*edges(G_gen).first].geometry.length() << ", " << G_gen_float[*edges(G_gen_float).first].geometry.length() << std::endl;
+	std::cout << "Curvature in t=0.5 (double, float):" << std::endl;
+	std::cout << "\tbspline:  " << G_bsp[*edges(G_bsp).first].geometry.curvature(0.5) << ", " << G_bsp_float[*edges(G_bsp_float).first].geometry.curvature(0.5f) << std::endl;
+	std::cout << "\tgeneric:  " << G_gen[*edges(G_gen).first].geometry.curvature(0.5) << ", " << G_gen_float[*edges(G_gen_float).first].geometry.curvature(0.5f) << std::endl;
+	
+	// Intersection of two edges in the plane
+	linear_geometry<2> E1(point<2>(0,0), point<2>(1,1)), E2(point<2>(0,1), point<2>(1,0.2));
+	linear_geometry<2,float> E1_float(point<2,float>(0,0), point<2,float>(1,1)), E2_float(point<2,float>(0,1), point<2,float>(1,0.2f));
+	Intersection I = compute_intersection(E1, E2);
+	Intersection I_float = compute_intersection(E1_float, E2_float);
+	Intersection I_exact_float = compute_intersection_exact(E1_float, E2_float);
+	std::cout << std::endl << "Intersection point: double " << I.intersectionPoint[0]
+			  << ", float " << I_float.intersectionPoint[0] << std::endl;
+	std::cout << "Same type of intersection: " << (I.how == I_float.how && I.how == I_exact_float.how ? "yes" : "no") << std::endl;
+	
+	return 0;
+}
@@ -0,0 +1,159 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_segment_bvh.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the closest approach of segments in 3D and the pairs of
+			segments closer than a given distance
+
+	The closest approach is checked on some simple cases and against the
+	minimum distance between points sampled on random segments. Then the
+	pairs found by compute_close_pairs() on a network of random walks
+	(whose consecutive segments share a vertex) are compared with the ones
+	of compute_close_pairs_brute_force(), and the time on a large network
+	is printed. The number of segments of the large network can be given
+	as argument (default 100000).
+*/
+
+#include "segment_bvh.hpp"
+#include "linear_geometry.hpp"
+#include "point.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdlib>
+
+using namespace BGLgeom;
+
+//! Prints a closest approach and checks its distance
+bool
+check_case(std::string const& name, point<3> const& A, point<3> const& B, point<3> const& C, point<3> const& D, double const& dist){
+	const closest_approach CA = compute_closest_approach(linear_geometry<3>(A, B), linear_geometry<3>(C, D));
+	std::cout << name << ": distance " << CA.distance << " (expected " << dist << "), s = " << CA.s << ", t = " << CA.t
+			  << (CA.intersect ? ", intersecting" : "") << std::endl;
+	return std::abs(CA.distance - dist) < 1e-12;
+}
+
+//! Network of n segments, made of random walks with steps of length h in the unit cube
+std::vector<linear_geometry<3>>
+random_network(std::size_t const& n, double const& h, std::mt19937 & gen){
+	std::uniform_real_distribution<double> pos(0.0, 1.0), coord(-1.0, 1.0);
+	std::vector<linear_geometry<3>> S;
+	S.reserve(n);
+	while(S.size() < n){
+		point<3> P(pos(gen), pos(gen), pos(gen));
+		for(std::size_t k = 0; k < 50 && S.size() < n; ++k){
+			point<3> dir(coord(gen), coord(gen), coord(gen));
+			const point<3> Q = P + h*dir.normalized();
+			S.push_back(linear_geometry<3>(P, Q));
+			P = Q;
+		}
+	}
+	return S;
+}
+
+//! True if the two lists have the same pairs
+bool
+same_pairs(std::vector<segment_proximity> const& a, std::vector<segment_proximity> const& b){
+	if(a.size() != b.size())
+		return false;
+	for(std::size_t k = 0; k < a.size(); ++k)
+		if(a[k].first != b[k].first || a[k].second != b[k].second || a[k].C.distance != b[k].C.distance)
+			return false;
+	return true;
+}
+
+int main(int argc, char* argv[]){
+
+	std::cout << "============ SEGMENTS IN 3D CLOSER THAN A DISTANCE ============" << std::endl << std::endl;
+	bool ok = true;
+
+	// Simple cases
+	ok = check_case("Skew", point<3>(0,0,0), point<3>(2,0,0), point<3>(1,-1,1), point<3>(1,1,1), 1.0) && ok;
+	ok = check_case("Crossing", point<3>(0,0,0), point<3>(2,0,0), point<3>(1,-1,0), point<3>(1,1,0), 0.0) && ok;
+	ok = check_case("Parallel", point<3>(0,0,0), point<3>(2,0,0), point<3>(1,0,3), point<3>(5,0,3), 3.0) && ok;
+	ok = check_case("Collinear, apart", point<3>(0,0,0), point<3>(1,0,0), point<3>(3,0,0), point<3>(4,0,0), 2.0) && ok;
+	ok = check_case("Extremes nearest", point<3>(0,0,0), point<3>(1,0,0), point<3>(2,1,0), point<3>(3,5,2), std::sqrt(2.0)) && ok;
+	ok = check_case("Point and segment", point<3>(1,1,1), point<3>(1,1,1), point<3>(0,0,0), point<3>(2,0,0), std::sqrt(2.0)) && ok;
+	ok = check_case("Two points", point<3>(1,1,1), point<3>(1,1,1), point<3>(1,1,2), point<3>(1,1,2), 1.0) && ok;
+
+	// Random segments against sampled points
+	std::mt19937 gen(17);
+	std::uniform_real_distribution<double> coord(0.0, 1.0);
+	std::size_t n_wrong = 0;
+	for(std::size_t k = 0; k < 200; ++k){
+		const point<3> A(coord(gen), coord(gen), coord(gen)), B(coord(gen), coord(gen), coord(gen));
+		const point<3> C(coord(gen), coord(gen), coord(gen)), D(coord(gen), coord(gen), coord(gen));
+		const closest_approach CA = compute_closest_approach(linear_geometry<3>(A, B), linear_geometry<3>(C, D));
+		double sampled = 1e10;
+		const std::size_t m = 100;
+		for(std::size_t i = 0; i <= m; ++i)
+			for(std::size_t j = 0; j <= m; ++j)
+				sampled = std::min(sampled, ((A + (B - A)*i/m) - (C + (D - C)*j/m)).norm());
+		const double h = std::max((B - A).norm(), (D - C).norm())/m;
+		n_wrong += (CA.distance > sampled + 1e-12 || CA.distance < sampled - h);
+	}
+	std::cout << "Random segments: " << n_wrong << " of 200 wrong" << std::endl << std::endl;
+	ok = ok && n_wrong == 0;
+
+	// The BVH against the brute force
+	std::vector<linear_geometry<3>> S = random_network(2000, 0.025, gen);
+	for(bool skip : {true, false}){
+		const std::vector<segment_proximity> ref = compute_close_pairs_brute_force(S, 0.005, skip);
+		std::size_t n_intersect = 0;
+		for(segment_proximity const& SP : ref)
+			n_intersect += SP.C.intersect;
+		std::cout << S.size() << " segments, " << (skip ? "without" : "with") << " adjacent ones: "
+				  << ref.size() << " pairs closer than 0.005, " << n_intersect << " intersecting" << std::endl;
+		for(unsigned int n_threads : {1u, 4u}){
+			const bool same = same_pairs(ref, compute_close_pairs(S, 0.005, skip, n_threads));
+			std::cout << "\t" << n_threads << " threads: " << (same ? "same pairs" : "DIFFERENT pairs") << std::endl;
+			ok = ok && same;
+		}
+	}
+	const std::vector<segment_proximity> pairs = compute_close_pairs(S, 0.005);
+	if(!pairs.empty())
+		std::cout << "First pair: " << pairs.front() << std::endl;
+
+	// A large network
+	const std::size_t n = (argc > 1 ? std::atol(argv[1]) : 100000);
+	const double h = 0.5/std::cbrt(static_cast<double>(n));
+	S = random_network(n, h, gen);
+	auto t0 = std::chrono::steady_clock::now();
+	const segment_bvh T(S);
+	auto t1 = std::chrono::steady_clock::now();
+	const std::vector<segment_proximity> P = compute_close_pairs(S, 0.1*h);
+	auto t2 = std::chrono::steady_clock::now();
+	std::cout << std::endl << n << " segments of length " << h << ": tree of " << T.num_nodes() << " nodes built in "
+			  << std::chrono::duration<double>(t1-t0).count() << " s" << std::endl;
+	std::cout << "\t" << P.size() << " pairs closer than " << 0.1*h << " found in "
+			  << std::chrono::duration<double>(t2-t1).count() << " s" << std::endl;
+
+	std::cout << std::endl << (ok ? "Test passed" : "ERROR: test failed") << std::endl;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_segment_filter.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the fast test of a segment against many segments
+
+	Each segment of a set is tested against all the others, both with
+	compute_intersection() and with segment_block: no pair intersecting
+	for compute_intersection() may be discarded by segment_block. The
+	sets are: random segments, segments on a lattice (many overlaps and
+	common extremes), and segments touching, crossing or almost parallel
+	within the tolerance, far from the origin. For the random set the
+	times with and without the filter are printed.
+*/
+
+#include "segment_filter.hpp"
+#include "intersections2D.hpp"
+#include "linear_geometry.hpp"
+#include "point.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <cmath>
+
+using namespace BGLgeom;
+
+//! Tests all the pairs of the set, printing how many are discarded
+bool
+check(std::string const& name, std::vector<linear_geometry<2>> const& S){
+	segment_block B;
+	for(linear_geometry<2> const& s : S)
+		B.push_back(s.get_source(), s.get_target());
+
+	// compute_intersection writes some messages, which are discarded here
+	std::stringstream discard;
+	std::streambuf* cout_buf = std::cout.rdbuf(discard.rdbuf());
+	std::streambuf* cerr_buf = std::cerr.rdbuf(discard.rdbuf());
+	std::size_t n_pairs = 0, n_intersect = 0, n_candidates = 0, n_lost = 0;
+	for(std::size_t i = 0; i < S.size(); ++i)
+		for(std::size_t first = 0; first < S.size(); first += segment_block::width){
+			std::uint64_t mask = B.candidates(S[i].get_source(), S[i].get_target(), first);
+			for(std::size_t j = first; j < std::min(first + segment_block::width, S.size()); ++j, mask >>= 1){
+				if(j == i)
+					continue;
+				++n_pairs;
+				const bool candidate = (mask & 1);
+				const bool intersect = compute_intersection(S[i], S[j]).intersect;
+				n_candidates += candidate;
+				n_intersect += intersect;
+				n_lost += (intersect && !candidate);
+			}
+		}
+	std::cout.rdbuf(cout_buf);
+	std::cerr.rdbuf(cerr_buf);
+	std::cout << name << ": " << n_pairs << " pairs, " << n_intersect << " intersecting, " << n_candidates
+			  << " candidates, " << n_lost << " intersections lost" << std::endl;
+	return n_lost == 0;
+}
+
+int main(){
+
+	std::cout << "============ ONE SEGMENT AGAINST MANY ============" << std::endl << std::endl;
+	bool ok = true;
+	std::mt19937 gen(11);
+	std::uniform_real_distribution<double> pos(0.0, 1.0), angle(0.0, 8*std::atan(1.0));
+
+	// Random segments
+	std::vector<linear_geometry<2>> S;
+	for(std::size_t i = 0; i < 1000; ++i){
+		point<2> P(pos(gen), pos(gen));
+		const double a = angle(gen), L = 0.2*pos(gen);
+		S.push_back(linear_geometry<2>(P, P + L*point<2>(std::cos(a), std::sin(a))));
+	}
+	ok = check("Random", S) && ok;
+
+	// Segments on a lattice
+	std::uniform_int_distribution<int> lattice(0, 8);
+	S.clear();
+	while(S.size() < 1000){
+		point<2> P(lattice(gen), lattice(gen)), Q(lattice(gen), lattice(gen));
+		if(P != Q)
+			S.push_back(linear_geometry<2>(P, Q));
+	}
+	ok = check("Lattice", S) && ok;
+
+	// Segments meeting within the tolerance, far from the origin
+	S.clear();
+	const point<2> O(1e4, -1e4);
+	for(std::size_t i = 0; S.size() < 1000; ++i){
+		const double a = angle(gen), b = a + (i % 2 ? 1e-7 : 1.0), L = 1e-3*(0.1 + pos(gen));
+		const point<2> P = O + 1e-3*point<2>(pos(gen), pos(gen));
+		const point<2> dir(std::cos(a), std::sin(a)), normal(-std::sin(a), std::cos(a));
+		const double shift = (pos(gen) - 0.5)*2*TOL*L;
+		S.push_back(linear_geometry<2>(P, P + L*dir));
+		// Touching in the extreme or in the middle, almost parallel or crossing
+		const point<2> Q = P + (i % 3 ? 0.5 : 1.0)*L*dir + shift*normal;
+		S.push_back(linear_geometry<2>(Q, Q + L*point<2>(std::cos(b), std::sin(b))));
+	}
+	ok = check("Within tolerance", S) && ok;
+
+	// Times on the random set
+	S.clear();
+	const std::size_t n = 4000;
+	for(std::size_t i = 0; i < n; ++i){
+		point<2> P(pos(gen), pos(gen));
+		const double a = angle(gen);
+		S.push_back(linear_geometry<2>(P, P + 0.05*point<2>(std::cos(a), std::sin(a))));
+	}
+	segment_block B;
+	for(linear_geometry<2> const& s : S)
+		B.push_back(s.get_source(), s.get_target());
+	std::stringstream discard;
+	std::streambuf* cout_buf = std::cout.rdbuf(discard.rdbuf());
+	std::streambuf* cerr_buf = std::cerr.rdbuf(discard.rdbuf());
+	std::size_t n_plain = 0, n_filtered = 0;
+	auto t0 = std::chrono::steady_clock::now();
+	for(std::size_t i = 0; i < n; ++i)
+		for(std::size_t j = i+1; j < n; ++j)
+			n_plain += compute_intersection(S[i], S[j]).intersect;
+	auto t1 = std::chrono::steady_clock::now();
+	for(std::size_t i = 0; i < n; ++i)
+		for(std::size_t first = i+1; first < n; first += segment_block::width){
+			std::uint64_t mask = B.candidates(S[i].get_source(), S[i].get_target(), first);
+			for(std::size_t j = first; mask != 0; ++j, mask >>= 1)
+				if(mask & 1)
+					n_filtered += compute_intersection(S[i], S[j]).intersect;
+		}
+	auto t2 = std::chrono::steady_clock::now();
+	std::cout.rdbuf(cout_buf);
+	std::cerr.rdbuf(cerr_buf);
+	std::cout << std::endl << "All the pairs of " << n << " random segments:" << std::endl;
+	std::cout << "\tcompute_intersection only: " << n_plain << " intersections, "
+			  << std::chrono::duration<double>(t1-t0).count() << " s" << std::endl;
+	std::cout << "\twith segment_block: " << n_filtered << " intersections, "
+			  << std::chrono::duration<double>(t2-t1).count() << " s" << std::endl;
+	ok = ok && n_plain == n_filtered;
+
+	std::cout << std::endl << (ok ? "Test passed" : "ERROR: test failed") << std::endl;
+	return ok ? 0 : 1;
+}
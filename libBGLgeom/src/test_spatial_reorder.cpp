@@ -0,0 +1,151 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_spatial_reorder.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the reordering of a graph along space-filling curves
+	
+	A grid network is built with vertices and edges inserted in random 
+	order, as it happens after many insertions and removals. Then it is 
+	reordered along the Morton and the Hilbert curves: we check that the 
+	graph is still the same, and we compare the time needed to visit the 
+	neighbours of all the vertices.
+*/
+
+#include "spatial_reorder.hpp"
+#include "bulk_builder.hpp"
+#include "graph_access.hpp"
+#include "base_properties.hpp"
+#include "linear_geometry.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <vector>
+#include <iostream>
+#include <random>
+#include <algorithm>
+#include <chrono>
+
+using namespace BGLgeom;
+
+//! Sum over the vertices of the distance from their neighbours, and of the length of the incident edges
+template <typename Graph>
+double
+visit(Graph const& G){
+	double sum = 0.0;
+	for(std::size_t v = 0; v < boost::num_vertices(G); ++v){
+		for(auto e : boost::make_iterator_range(boost::out_edges(v, G))){
+			std::size_t u = boost::target(e, G);
+			sum += (G[u].coordinates - G[v].coordinates).norm() + G[e].geometry.length();
+		}
+	}
+	return sum;
+}
+
+//! Checks that each edge joins the vertices with the coordinates of its geometry
+template <typename Graph>
+bool
+check(Graph const& G){
+	Edge_iter<Graph> e_it, e_end;
+	for(std::tie(e_it, e_end) = edges(G); e_it != e_end; ++e_it)
+		if(G[source(*e_it, G)].coordinates != G[*e_it].geometry.get_source() ||
+		   G[target(*e_it, G)].coordinates != G[*e_it].geometry.get_target())
+			return false;
+	return true;
+}
+
+int main(){
+	
+	using Vertex_prop = Vertex_base_property<2>;
+	using Edge_prop = Edge_base_property<linear_geometry<2>,2>;
+	using Graph = boost::adjacency_list< boost::vecS, 
+										 boost::vecS, 
+										 boost::undirectedS, 
+										 Vertex_prop, 
+										 Edge_prop >;
+	
+	// Grid network with N x N vertices, numbered randomly
+	const std::size_t N = 400;
+	const double h = 1.0/(N-1);
+	std::vector<std::size_t> perm(N*N);
+	std::iota(perm.begin(), perm.end(), 0);
+	std::mt19937 gen(2017);
+	std::shuffle(perm.begin(), perm.end(), gen);
+	std::vector<point<2>> pts(N*N);
+	edge_list_t E;
+	for(std::size_t i = 0; i < N; ++i)
+		for(std::size_t j = 0; j < N; ++j){
+			pts[perm[i*N+j]] = point<2>(i*h, j*h);
+			if(i > 0)
+				E.push_back(std::make_pair(perm[(i-1)*N+j], perm[i*N+j]));
+			if(j > 0)
+				E.push_back(std::make_pair(perm[i*N+j-1], perm[i*N+j]));
+		}
+	std::shuffle(E.begin(), E.end(), gen);
+	Graph G;
+	bulk_build_linear<Graph,2>(pts, E, G);
+	
+	std::cout << "================== SPATIAL REORDERING ======================" << std::endl << std::endl;
+	
+	auto start = std::chrono::steady_clock::now();
+	double s_G = visit(G);
+	auto end = std::chrono::steady_clock::now();
+	std::cout << "Visit of the neighbours, random order:  " << s_G << ", "
+			  << std::chrono::duration<double>(end-start).count() << " s" << std::endl << std::endl;
+	
+	std::vector<std::pair<sfc_curve, std::string>> curves{ {sfc_curve::morton, "Morton"}, {sfc_curve::hilbert, "Hilbert"} };
+	for(auto const& c : curves){
+		Graph G_sfc;
+		start = std::chrono::steady_clock::now();
+		std::vector<std::size_t> new_index = reorder_graph<Graph,2>(G, G_sfc, c.first);
+		end = std::chrono::steady_clock::now();
+		std::cout << c.second << " reordering: " << num_vertices(G_sfc) << " vertices, " << num_edges(G_sfc) << " edges, "
+				  << std::chrono::duration<double>(end-start).count() << " s" << std::endl;
+		
+		bool same = (num_vertices(G) == num_vertices(G_sfc) && num_edges(G) == num_edges(G_sfc) && check(G_sfc));
+		for(std::size_t v = 0; same && v < num_vertices(G); ++v)
+			same = (G[v].coordinates == G_sfc[new_index[v]].coordinates);
+		std::cout << "Same graph: " << (same ? "yes" : "NO") << std::endl;
+		
+		// Mean distance in memory between a vertex and its neighbours
+		double gap = 0.0;
+		for(std::size_t v = 0; v < num_vertices(G_sfc); ++v)
+			for(auto u : boost::make_iterator_range(boost::adjacent_vertices(v, G_sfc)))
+				gap += (u > v ? u-v : v-u);
+		std::cout << "Mean index gap between neighbours: " << gap/(2*num_edges(G_sfc)) << std::endl;
+		
+		start = std::chrono::steady_clock::now();
+		double s = visit(G_sfc);
+		end = std::chrono::steady_clock::now();
+		std::cout << "Visit of the neighbours, " << c.second << " order: " << s << ", "
+				  << std::chrono::duration<double>(end-start).count() << " s" << std::endl << std::endl;
+	}
+	
+	// In place, keeping the graph property
+	reorder_graph<Graph,2>(G);
+	std::cout << "In place reordering: " << num_vertices(G) << " vertices, " << num_edges(G) << " edges, "
+			  << (check(G) ? "consistent" : "NOT consistent") << std::endl;
+	
+	return 0;
+}
@@ -0,0 +1,134 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_sweep_intersections.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the sweep line for all the intersections of a set of segments
+
+	The result of compute_all_intersections is compared with the one of the
+	brute force version on: a small set with all the intersection types;
+	segments joining random points of a coarse lattice (many vertical and
+	horizontal segments, common extremes, overlaps and intersections in
+	the extremes); random segments in the unit square.
+*/
+
+#include "sweep_intersections.hpp"
+#include "linear_geometry.hpp"
+#include "point.hpp"
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <cmath>
+
+using namespace BGLgeom;
+
+//! True if the two lists contain the same pairs with the same intersection type
+bool
+same_result(std::vector<segment_intersection> const& A, std::vector<segment_intersection> const& B){
+	if(A.size() != B.size())
+		return false;
+	for(std::size_t i = 0; i < A.size(); ++i)
+		if(A[i].first != B[i].first || A[i].second != B[i].second || A[i].I.how != B[i].I.how)
+			return false;
+	return true;
+}
+
+//! Compares sweep line and brute force on a set, printing sizes and times
+bool
+compare(std::string const& name, std::vector<linear_geometry<2>> const& S){
+	// compute_intersection writes some messages, which are discarded here
+	std::stringstream discard;
+	std::streambuf* cout_buf = std::cout.rdbuf(discard.rdbuf());
+	std::streambuf* cerr_buf = std::cerr.rdbuf(discard.rdbuf());
+	auto t0 = std::chrono::steady_clock::now();
+	std::vector<segment_intersection> sweep = compute_all_intersections(S);
+	auto t1 = std::chrono::steady_clock::now();
+	std::vector<segment_intersection> brute = compute_all_intersections_brute_force(S);
+	auto t2 = std::chrono::steady_clock::now();
+	std::cout.rdbuf(cout_buf);
+	std::cerr.rdbuf(cerr_buf);
+
+	const bool ok = same_result(sweep, brute);
+	std::cout << name << ": " << S.size() << " segments, " << sweep.size() << " intersections (brute force: " << brute.size() << ")" << std::endl;
+	std::cout << "\tsweep line: " << std::chrono::duration<double>(t1-t0).count() << " s, brute force: "
+			  << std::chrono::duration<double>(t2-t1).count() << " s" << std::endl;
+	std::cout << "\t" << (ok ? "Same intersections" : "ERROR: different intersections") << std::endl;
+	return ok;
+}
+
+int main(){
+
+	std::cout << "================== ALL THE INTERSECTIONS OF A SET OF SEGMENTS ======================" << std::endl << std::endl;
+	bool ok = true;
+
+	// A small set with all the intersection types
+	std::vector<linear_geometry<2>> S;
+	S.push_back(linear_geometry<2>(point<2>(0,0), point<2>(4,4)));		// 0
+	S.push_back(linear_geometry<2>(point<2>(0,4), point<2>(4,0)));		// 1: X with 0
+	S.push_back(linear_geometry<2>(point<2>(2,2), point<2>(2,6)));		// 2: T in (2,2) with 0 and 1
+	S.push_back(linear_geometry<2>(point<2>(2,6), point<2>(5,6)));		// 3: common extreme with 2
+	S.push_back(linear_geometry<2>(point<2>(4,6), point<2>(7,6)));		// 4: overlap with 3
+	S.push_back(linear_geometry<2>(point<2>(4,6), point<2>(7,6)));		// 5: identical to 4
+	S.push_back(linear_geometry<2>(point<2>(1,1), point<2>(3,3)));		// 6: inside 0
+	S.push_back(linear_geometry<2>(point<2>(0,0), point<2>(1,1)));		// 7: overlap with 0 with a common extreme
+	S.push_back(linear_geometry<2>(point<2>(6,0), point<2>(6,10)));		// 8: vertical, crossing 4 and 5
+	S.push_back(linear_geometry<2>(point<2>(8,0), point<2>(9,1)));		// 9: isolated
+	std::vector<segment_intersection> I = compute_all_intersections(S);
+	std::cout << "Small set: " << I.size() << " intersections" << std::endl;
+	for(segment_intersection const& SI : I)
+		std::cout << SI << std::endl;
+	ok = compare("Small set", S) && ok;
+	std::cout << std::endl;
+
+	// Segments on a lattice
+	std::mt19937 gen(3);
+	std::uniform_int_distribution<int> lattice(0, 16);
+	S.clear();
+	while(S.size() < 400){
+		point<2> P(lattice(gen), lattice(gen)), Q(lattice(gen), lattice(gen));
+		if(P(0) == Q(0) || P(1) == Q(1) || std::abs(P(0)-Q(0)) == std::abs(P(1)-Q(1)))
+			S.push_back(linear_geometry<2>(0.0625*P, 0.0625*Q));
+	}
+	ok = compare("Lattice", S) && ok;
+	std::cout << std::endl;
+
+	// Random segments, with the length scaled to have about 10 intersections for each segment
+	for(std::size_t n : {1000, 4000}){
+		std::uniform_real_distribution<double> pos(0.0, 1.0), angle(0.0, 4*std::atan(1.0));
+		const double L = 4/std::sqrt(static_cast<double>(n));
+		S.clear();
+		for(std::size_t i = 0; i < n; ++i){
+			point<2> P(pos(gen), pos(gen));
+			const double a = angle(gen);
+			S.push_back(linear_geometry<2>(P, P + L*point<2>(std::cos(a), std::sin(a))));
+		}
+		ok = compare("Random", S) && ok;
+		std::cout << std::endl;
+	}
+
+	return ok ? 0 : 1;
+}
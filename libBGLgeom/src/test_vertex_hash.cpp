@@ -0,0 +1,102 @@
+/*======================================================================
+                        "BGLgeom library"
+        Course on Advanced Programming for Scientific Computing
+                      Politecnico di Milano
+                          A.Y. 2015-2016
+                  
+         Copyright (C) 2017 Ilaria Speranza & Mattia Tantardini
+======================================================================*/
+/*
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*!
+	@file	test_vertex_hash.cpp
+	@author	Ilaria Speranza & Mattia Tantardini
+	@date	Jan, 2017
+	@brief	Testing the spatial hash of the vertices used by new_vertex
+	
+	The same sequence of points, in which each point is repeated (with a 
+	perturbation smaller than the tolerance, and sometimes across the 
+	boundary of a cell of the hash), is inserted in two graphs: in the 
+	first one using the linear scan of new_vertex, in the second one using 
+	the spatial hash. We check that the two graphs have the same vertices
+	and compare the times. Then a vertex is removed.
+*/
+
+#include "graph_builder.hpp"
+#include "graph_access.hpp"
+#include "base_properties.hpp"
+#include "vertex_hash.hpp"
+#include "point.hpp"
+#include <boost/graph/adjacency_list.hpp>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <random>
+
+using namespace BGLgeom;
+
+int main(){
+	
+	using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex_base_property<2> >;
+	
+	// Points on a grid with step 0.01, to have them exactly on the boundaries of the cells
+	const std::size_t n = 2000;
+	std::mt19937 gen(1);
+	std::uniform_int_distribution<int> coord(0, 999);
+	std::uniform_real_distribution<double> noise(-0.2*TOL, 0.2*TOL);
+	std::vector<point<2>> pts;
+	for(std::size_t i = 0; i < n; ++i){
+		point<2> P(0.01*coord(gen), 0.01*coord(gen));
+		pts.push_back(P);
+		pts.push_back(P + point<2>(noise(gen), noise(gen)));
+	}
+	
+	std::cout << "================== VERTEX HASH ======================" << std::endl << std::endl;
+	std::cout << "Inserting " << pts.size() << " points (each one twice)" << std::endl;
+	
+	Graph G1;
+	auto start = std::chrono::steady_clock::now();
+	for(point<2> const& P : pts)
+		new_vertex(Vertex_base_property<2>(P), G1, true);
+	auto end = std::chrono::steady_clock::now();
+	std::cout << "Linear scan:  " << num_vertices(G1) << " vertices, "
+			  << std::chrono::duration<double>(end-start).count() << " s" << std::endl;
+	
+	Graph G2;
+	vertex_hash<2> H(0.01);
+	start = std::chrono::steady_clock::now();
+	for(point<2> const& P : pts)
+		new_vertex(Vertex_base_property<2>(P), G2, H);
+	end = std::chrono::steady_clock::now();
+	std::cout << "Spatial hash: " << num_vertices(G2) << " vertices, "
+			  << std::chrono::duration<double>(end-start).count() << " s" << std::endl;
+	
+	bool same = (num_vertices(G1) == num_vertices(G2));
+	for(std::size_t v = 0; same && v < num_vertices(G1); ++v)
+		same = (G1[v].coordinates == G2[v].coordinates);
+	std::cout << "Same vertices: " << (same ? "yes" : "NO") << std::endl << std::endl;
+	
+	std::size_t v;
+	std::cout << "Removing vertex 0, at " << G2[0].coordinates << std::endl;
+	point<2> P0 = G2[0].coordinates;
+	point<2> P1 = G2[1].coordinates;
+	remove_vertex(0, G2, H);
+	std::cout << "Vertex at " << P0 << " found: " << (H.find(P0, v) ? "yes" : "no") << std::endl;
+	H.find(P1, v);
+	std::cout << "Vertex at " << P1 << " has now index " << v << std::endl;
+	
+	return 0;
+}